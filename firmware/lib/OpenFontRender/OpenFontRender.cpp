@@ -725,43 +725,7 @@ uint16_t OpenFontRender::drawHString(const char *str,
 				                                           cmap_index,
 				                                           rendering_unicode);
 				FT_Glyph aglyph;
-#ifdef FREERTOS_CONFIG_H
-				if (g_UseRenderTask) {
-					if (g_RenderTaskHandle == NULL) {
-						debugPrintf((_debug_level & OFR_INFO), "Create render task\n");
-						const uint8_t RUNNING_CORE = 1;
-						const uint8_t PRIORITY     = 1;
-						xTaskCreateUniversal(RenderTask,
-						                     "RenderTask",
-						                     g_RenderTaskStackSize, // Seems to need a lot of memory.
-						                     NULL,
-						                     PRIORITY,
-						                     &g_RenderTaskHandle,
-						                     RUNNING_CORE);
-					}
-					while (g_RenderTaskStatus != IDLE) {
-						vTaskDelay(1);
-					}
-					g_RenderTaskStatus              = LOCK;
-					g_TaskParameter.ftc_image_cache = _ftc_image_cache;
-					g_TaskParameter.image_type      = image_type;
-					g_TaskParameter.glyph_index     = glyph_index;
-					g_TaskParameter.debug_level     = _debug_level;
-
-					g_RenderTaskStatus = RENDERING;
-					while (g_RenderTaskStatus == RENDERING) {
-						vTaskDelay(1);
-					}
-					debugPrintf((g_TaskParameter.debug_level & OFR_INFO), "Render task Finish\n");
-					aglyph             = g_TaskParameter.aglyph;
-					error              = g_TaskParameter.error;
-					g_RenderTaskStatus = IDLE;
-				} else {
-					error = FTC_ImageCache_Lookup(_ftc_image_cache, &image_type, glyph_index, &aglyph, NULL);
-				}
-#else
-				error = FTC_ImageCache_Lookup(_ftc_image_cache, &image_type, glyph_index, &aglyph, NULL);
-#endif
+				error = lookupRenderedGlyph(image_type, glyph_index, aglyph);
 				if (error) {
 					debugPrintf((_debug_level & OFR_ERROR), "FTC_ImageCache_Lookup error: 0x%02X\n", error);
 					return written_char_num;
@@ -1112,6 +1076,100 @@ uint32_t OpenFontRender::getTextHeight(const char *fmt, ...) {
 	return (bbox.yMax - bbox.yMin);
 }
 
+/*!
+ * @brief Look up a rendered glyph image, on the render task if it is enabled.
+ * @param[in] (image_type) Image type with FT_LOAD_RENDER set.
+ * @param[in] (glyph_index) Glyph index.
+ * @param[out] (aglyph) Glyph owned by the image cache.
+ * @return FreeType error code. 0 is success.
+ */
+FT_Error OpenFontRender::lookupRenderedGlyph(FTC_ImageTypeRec &image_type, FT_UInt glyph_index, FT_Glyph &aglyph) {
+	FT_Error error;
+#ifdef FREERTOS_CONFIG_H
+	if (g_UseRenderTask) {
+		if (g_RenderTaskHandle == NULL) {
+			debugPrintf((_debug_level & OFR_INFO), "Create render task\n");
+			const uint8_t RUNNING_CORE = 1;
+			const uint8_t PRIORITY     = 1;
+			xTaskCreateUniversal(RenderTask,
+			                     "RenderTask",
+			                     g_RenderTaskStackSize, // Seems to need a lot of memory.
+			                     NULL,
+			                     PRIORITY,
+			                     &g_RenderTaskHandle,
+			                     RUNNING_CORE);
+		}
+		while (g_RenderTaskStatus != IDLE) {
+			vTaskDelay(1);
+		}
+		g_RenderTaskStatus              = LOCK;
+		g_TaskParameter.ftc_image_cache = _ftc_image_cache;
+		g_TaskParameter.image_type      = image_type;
+		g_TaskParameter.glyph_index     = glyph_index;
+		g_TaskParameter.debug_level     = _debug_level;
+
+		g_RenderTaskStatus = RENDERING;
+		while (g_RenderTaskStatus == RENDERING) {
+			vTaskDelay(1);
+		}
+		debugPrintf((g_TaskParameter.debug_level & OFR_INFO), "Render task Finish\n");
+		aglyph             = g_TaskParameter.aglyph;
+		error              = g_TaskParameter.error;
+		g_RenderTaskStatus = IDLE;
+	} else {
+		error = FTC_ImageCache_Lookup(_ftc_image_cache, &image_type, glyph_index, &aglyph, NULL);
+	}
+#else
+	error = FTC_ImageCache_Lookup(_ftc_image_cache, &image_type, glyph_index, &aglyph, NULL);
+#endif
+	return error;
+}
+
+/*!
+ * @brief Rasterize a single glyph at the current font size, e.g. to keep it in an own cache.
+ * @param[in] (unicode) Character to render.
+ * @param[out] (glyph) 8-bit alpha bitmap, owned by the FreeType cache and only valid until the next rendering.
+ * @param[out] (advance) Horizontal advance in pixels.
+ * @return FreeType error code. 0 is success.
+ * @ingroup rendering_api
+ */
+FT_Error OpenFontRender::renderGlyph(uint16_t unicode, FT_BitmapGlyph &glyph, int32_t &advance) {
+	FT_Error error;
+	FT_Size asize = NULL;
+	FTC_ScalerRec scaler;
+	scaler.face_id = &_face_id;
+	scaler.width   = 0;
+	scaler.height  = _text.size;
+	scaler.pixel   = true;
+	scaler.x_res   = 0;
+	scaler.y_res   = 0;
+
+	error = FTC_Manager_LookupSize(_ftc_manager, &scaler, &asize);
+	if (error) {
+		return error;
+	}
+	FT_Int cmap_index   = FT_Get_Charmap_Index(asize->face->charmap);
+	FT_UInt glyph_index = FTC_CMapCache_Lookup(_ftc_cmap_cache, &_face_id, cmap_index, unicode);
+	if (glyph_index == 0) {
+		return FT_Err_Invalid_Character_Code;
+	}
+
+	FTC_ImageTypeRec image_type;
+	image_type.face_id = &_face_id;
+	image_type.width   = 0;
+	image_type.height  = _text.size;
+	image_type.flags   = FT_LOAD_RENDER;
+
+	FT_Glyph aglyph;
+	error = lookupRenderedGlyph(image_type, glyph_index, aglyph);
+	if (error) {
+		return error;
+	}
+	glyph   = (FT_BitmapGlyph)aglyph;
+	advance = aglyph->advance.x >> 16;
+	return FT_Err_Ok;
+}
+
 /*!
  * @brief Calculates the maximum font size that will fit the specified format string and the specified rectangle.
  * @param[in] (limit_width) Limit width size.
@@ -1290,6 +1348,9 @@ void OpenFontRender::set_startWrite(std::function<void(void)> user_func) {
 void OpenFontRender::set_endWrite(std::function<void(void)> user_func) {
 	_endWrite = user_func;
 }
+void OpenFontRender::set_glyphSink(std::function<void(FT_BitmapGlyph, int32_t, int32_t)> user_func) {
+	_glyphSink = user_func;
+}
 void OpenFontRender::set_printFunc(std::function<void(const char *)> user_func) {
 	// This function is static member method
 	g_Print = user_func;
@@ -1385,6 +1446,10 @@ uint32_t OpenFontRender::getFontMaxHeight() {
 }
 
 void OpenFontRender::draw2screen(FT_BitmapGlyph glyph, uint32_t x, uint32_t y, uint16_t fg, uint16_t bg) {
+	if (_glyphSink) {
+		_glyphSink(glyph, (int32_t)x + glyph->left, (int32_t)y - glyph->top);
+		return;
+	}
 	_startWrite();
 
 	if (_flags.enable_optimized_drawing) {
@@ -273,6 +273,8 @@ public:
 	uint32_t getTextWidth(const char *fmt, ...);
 	uint32_t getTextHeight(const char *fmt, ...);
 
+	FT_Error renderGlyph(uint16_t unicode, FT_BitmapGlyph &glyph, int32_t &advance);
+
 	unsigned int calculateFitFontSizeFmt(uint32_t limit_width, uint32_t limit_height, Layout layout, const char *fmt, ...);
 	unsigned int calculateFitFontSize(uint32_t limit_width, uint32_t limit_height, Layout layout, const char *str);
 
@@ -305,6 +307,8 @@ public:
 	void set_drawFastHLine(std::function<void(int32_t, int32_t, int32_t, uint16_t)> user_func);
 	void set_startWrite(std::function<void(void)> user_func);
 	void set_endWrite(std::function<void(void)> user_func);
+	// While set, drawString() passes each rendered glyph with the screen position of its top left pixel here instead of drawing it
+	void set_glyphSink(std::function<void(FT_BitmapGlyph, int32_t, int32_t)> user_func);
 
 	/* Static member method */
 	/*!
@@ -334,6 +338,7 @@ private:
 	FT_Error loadFont(enum OFR::LoadFontFrom from);
 	uint32_t getFontMaxHeight();
 	void draw2screen(FT_BitmapGlyph glyph, uint32_t x, uint32_t y, uint16_t fg, uint16_t bg);
+	FT_Error lookupRenderedGlyph(FTC_ImageTypeRec &image_type, FT_UInt glyph_index, FT_Glyph &aglyph);
 	uint16_t decodeUTF8(uint8_t *buf, uint16_t *index, uint16_t remaining);
 	uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
 	uint16_t alphaBlend(uint8_t alpha, uint16_t fgc, uint16_t bgc);
@@ -342,6 +347,7 @@ private:
 	std::function<void(int32_t, int32_t, int32_t, uint16_t)> _drawFastHLine;
 	std::function<void(void)> _startWrite;
 	std::function<void(void)> _endWrite;
+	std::function<void(FT_BitmapGlyph, int32_t, int32_t)> _glyphSink;
 
 	FTC_Manager _ftc_manager;
 	FTC_CMapCache _ftc_cmap_cache;
@@ -126,27 +126,80 @@ void ConfigManager::setupWebPortal() {
         }
 #endif
         if (count > 0) {
-            saveAllConfigs();
-            Log.infoln("%d config values saved.", count);
-            // Restart to apply new config
-            m_requiresRestart = true;
+            size_t changed = saveAllConfigs();
+            Log.infoln("%d of %d config values changed.", (int)changed, count);
+            if (changed > 0 && !m_requiresRestart) {
+                Log.infoln("All changes applied without restart.");
+                m_liveChanges = true;
+            }
         } else {
             Log.infoln("No config values to save found. Skipping.");
         }
     });
 }
 
-void ConfigManager::saveAllConfigs() {
+size_t ConfigManager::saveAllConfigs() {
+    m_changedKeys.clear();
+    // Write through a raw NVS handle so all changed keys end up in a single commit
+    // (Preferences commits on every put). Same namespace and encoding as m_preferences.
+    nvs_handle_t handle;
+    if (nvs_open("config", NVS_READWRITE, &handle) != ESP_OK) {
+        Log.errorln("saveAllConfigs: failed to open NVS namespace");
+        return 0;
+    }
+    std::vector<const Parameter *> changed;
+    std::vector<const Parameter *> written;
     for (auto &param : m_parameters) {
-        param.saveCallback(); // Save variables to preferences
-        triggerChangeCallbacks(param.section, param.variableName); // Notify listeners
+        esp_err_t error = ESP_OK;
+        if (param.saveCallback(handle, error)) {
+            changed.push_back(&param);
+            m_changedKeys.push_back(param.variableName);
+            if (error == ESP_OK) {
+                written.push_back(&param);
+            } else {
+                Log.errorln("saveAllConfigs: writing %s failed: %s", param.variableName, esp_err_to_name(error));
+            }
+        }
     }
+    if (!written.empty()) {
+        esp_err_t error = nvs_commit(handle);
+        if (error == ESP_OK) {
+            // Keys that failed stay unpersisted and are written again with the next save
+            for (const auto *param : written) {
+                param->persistedCallback();
+            }
+        } else {
+            Log.errorln("saveAllConfigs: NVS commit failed: %s", esp_err_to_name(error));
+        }
+    }
+    nvs_close(handle);
+
+    // Notify listeners only after the commit, so callbacks can read the new values
+    for (const auto *param : changed) {
+        if (!isAppliedLive(param->section, param->variableName)) {
+            Log.infoln("%s can't be applied live, restart required.", param->variableName);
+            // Restart to apply new config
+            m_requiresRestart = true;
+        }
+        triggerChangeCallbacks(param->section, param->variableName);
+    }
+    return changed.size();
+}
+
+bool ConfigManager::takeLiveChanges() {
+    bool liveChanges = m_liveChanges;
+    m_liveChanges = false;
+    return liveChanges;
 }
 
 std::string ConfigManager::makeKey(const char *section, const char *varName) {
     return std::string(section).append("_").append(varName);
 }
 
+bool ConfigManager::isAppliedLive(const char *section, const char *varName) {
+    return m_changeCallbacks.count(makeKey(section, varName)) > 0;
+}
+
 void ConfigManager::triggerChangeCallbacks(const char *section, const char *varName) {
 #ifdef CM_DEBUG
     Log.traceln("triggerChangeCallbacks, c=%s, v=%s", section, varName);
@@ -166,7 +219,7 @@ void ConfigManager::triggerChangeCallbacks(const char *section, const char *varN
 
 template <typename T, typename ParameterType, typename... Args>
 void ConfigManager::addConfig(ParamType paramType, const char *section, const char *varName, T *var, const char *description, uint8_t length, bool advanced,
-                              std::function<void(T &)> loadFromPreferences, std::function<void(ParameterType *, T &)> setParameterValue, std::function<void(T &)> saveToPreferences,
+                              std::function<void(T &)> loadFromPreferences, std::function<void(ParameterType *, T &)> setParameterValue, std::function<esp_err_t(nvs_handle_t, const T &)> saveToPreferences,
                               Args... args) {
 
     // Load value from preferences
@@ -179,18 +232,25 @@ void ConfigManager::addConfig(ParamType paramType, const char *section, const ch
     // Create parameter with additional arguments if needed
     ParameterType *param = new ParameterType(varName, description, args..., *var, length);
 
-    auto saveLambda = [this, section, varName, var, param, setParameterValue, saveToPreferences]() {
+    // Last value known to be in NVS, used to skip unchanged keys
+    auto persisted = std::make_shared<T>(*var);
+
+    auto saveLambda = [this, section, varName, var, param, persisted, setParameterValue, saveToPreferences](nvs_handle_t handle, esp_err_t &error) {
         // Set parameter value
         setParameterValue(param, *var);
-        // Save to preferences
-        saveToPreferences(*var);
+        if (*var == *persisted) {
+            return false;
+        }
+        // Save to preferences, persisted is updated after the commit
+        error = saveToPreferences(handle, *var);
 #ifdef CM_DEBUG
         // Debugging output
         Log.traceln("%s saved %d (@%p)", varName, *var, var);
 #endif
+        return true;
     };
 
-    m_parameters.push_back({param, paramType, section, varName, advanced, saveLambda});
+    m_parameters.push_back({param, paramType, section, varName, advanced, saveLambda, [var, persisted]() { *persisted = *var; }});
 }
 
 void ConfigManager::addConfigString(const char *section, const char *varName, std::string *var, const size_t length, const char *description, const bool advanced) {
@@ -198,7 +258,7 @@ void ConfigManager::addConfigString(const char *section, const char *varName, st
         ParamType::String, section, varName, var, description, length, advanced,
         [this, varName](std::string &var) { var = m_preferences.getString(varName, var.c_str()).c_str(); },
         [](StringParameter *param, std::string &var) { var = param->getValue(); },
-        [this, varName](std::string &var) { m_preferences.putString(varName, var.c_str()); });
+        [varName](nvs_handle_t handle, const std::string &var) { return nvs_set_str(handle, varName, var.c_str()); });
 }
 
 void ConfigManager::addConfigString(const char *section, const char *varName, std::string *var, const size_t length, Translation &description, const bool advanced) {
@@ -210,7 +270,7 @@ void ConfigManager::addConfigInt(const char *section, const char *varName, int *
         ParamType::Int, section, varName, var, description, 10, advanced,
         [this, varName](int &var) { var = m_preferences.getInt(varName, var); },
         [](IntParameter *param, int &var) { var = param->getValue(); },
-        [this, varName](int &var) { m_preferences.putInt(varName, var); });
+        [varName](nvs_handle_t handle, const int &var) { return nvs_set_i32(handle, varName, var); });
 }
 
 void ConfigManager::addConfigInt(const char *section, const char *varName, int *var, Translation &description, const bool advanced) {
@@ -222,7 +282,7 @@ void ConfigManager::addConfigBool(const char *section, const char *varName, bool
         ParamType::Bool, section, varName, var, description, 2, advanced,
         [this, varName](bool &var) { var = m_preferences.getBool(varName, var); },
         [this](BoolParameter *param, bool &var) { var = param->getValue(this->m_wm); },
-        [this, varName](bool &var) { m_preferences.putBool(varName, var); });
+        [varName](nvs_handle_t handle, const bool &var) { return nvs_set_u8(handle, varName, var ? 1 : 0); });
 }
 
 void ConfigManager::addConfigBool(const char *section, const char *varName, bool *var, Translation &description, const bool advanced) {
@@ -234,7 +294,7 @@ void ConfigManager::addConfigFloat(const char *section, const char *varName, flo
         ParamType::Float, section, varName, var, description, 10, advanced,
         [this, varName](float &var) { var = m_preferences.getFloat(varName, var); },
         [](FloatParameter *param, float &var) { var = param->getValue(); },
-        [this, varName](float &var) { m_preferences.putFloat(varName, var); });
+        [varName](nvs_handle_t handle, const float &var) { return nvs_set_blob(handle, varName, &var, sizeof(float)); });
 }
 
 void ConfigManager::addConfigFloat(const char *section, const char *varName, float *var, Translation &description, const bool advanced) {
@@ -246,7 +306,7 @@ void ConfigManager::addConfigColor(const char *section, const char *varName, int
         ParamType::Color, section, varName, var, description, 8, advanced,
         [this, varName](int &var) { var = m_preferences.getInt(varName, var); },
         [](ColorParameter *param, int &var) { var = param->getValue(); },
-        [this, varName](int &var) { m_preferences.putInt(varName, var); });
+        [varName](nvs_handle_t handle, const int &var) { return nvs_set_i32(handle, varName, var); });
 }
 
 void ConfigManager::addConfigColor(const char *section, const char *varName, int *var, Translation &description, const bool advanced) {
@@ -258,7 +318,7 @@ void ConfigManager::addConfigComboBox(const char *section, const char *varName,
         ParamType::ComboBox, section, varName, var, description, 0, advanced,
         [this, varName](int &var) { var = m_preferences.getInt(varName, var); },
         [this](ComboBoxParameter *param, int &var) { var = param->getValue(this->m_wm); },
-        [this, varName](int &var) { m_preferences.putInt(varName, var); },
+        [varName](nvs_handle_t handle, const int &var) { return nvs_set_i32(handle, varName, var); },
         options, // Pass options array
         numOptions // Pass number of options
     );
@@ -6,6 +6,8 @@
 #include "WifiManagerCustomParameters.h"
 #include <Preferences.h>
 #include <functional>
+#include <memory>
+#include <nvs.h>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -30,7 +32,10 @@ public:
     static ConfigManager *getInstance();
 
     void setupWebPortal();
-    void saveAllConfigs();
+    // Save all changed configs in one NVS commit, returns the number of changed keys
+    size_t saveAllConfigs();
+    // Keys (varName) changed by the last saveAllConfigs call
+    const std::vector<const char *> &getChangedKeys() const { return m_changedKeys; }
 
     // Add a string configuration variable
     void addConfigString(const char *section, const char *varName, std::string *var, size_t length, const char *description, bool advanced = false);
@@ -79,6 +84,8 @@ public:
     float getConfigFloat(const char *varName, float defaultValue);
 
     // Register callbacks for changes
+    // A key with its own callback is considered to be applied live, changing it doesn't require a restart.
+    // Section callbacks are only notified, changed keys without a key callback still restart the device.
     void addOnChangeCallback(
         const char *section,
         const char *varName,
@@ -89,6 +96,8 @@ public:
 
     // Check if a restart is required
     bool requiresRestart() const { return m_requiresRestart; }
+    // Returns true once after keys were applied live, so the current widget can be redrawn
+    bool takeLiveChanges();
 
 private:
     struct Parameter {
@@ -97,7 +106,10 @@ private:
         const char *section;
         const char *variableName;
         const bool advanced;
-        std::function<void()> saveCallback;
+        // Reads the portal value and writes it to the open NVS handle with the result in error, returns false if unchanged
+        std::function<bool(nvs_handle_t, esp_err_t &)> saveCallback;
+        // The written value was committed, it's only written again when it changes
+        std::function<void()> persistedCallback;
     };
 
     static ConfigManager *s_instance;
@@ -106,13 +118,16 @@ private:
     Preferences m_preferences;
     std::vector<Parameter> m_parameters;
     std::unordered_map<std::string, std::vector<std::function<void(const char *section, const char *varName)>>> m_changeCallbacks;
+    std::vector<const char *> m_changedKeys;
     bool m_requiresRestart = false;
+    bool m_liveChanges = false;
 
     template <typename T, typename ParameterType, typename... Args>
     void addConfig(ParamType paramType, const char *section, const char *varName, T *var, const char *description, uint8_t length, bool advanced,
-                   std::function<void(T &)> loadFromPreferences, std::function<void(ParameterType *, T &)> setParameterValue, std::function<void(T &)> saveToPreferences, Args... args);
+                   std::function<void(T &)> loadFromPreferences, std::function<void(ParameterType *, T &)> setParameterValue, std::function<esp_err_t(nvs_handle_t, const T &)> saveToPreferences, Args... args);
 
     std::string makeKey(const char *section, const char *varName);
+    bool isAppliedLive(const char *section, const char *varName);
     void triggerChangeCallbacks(const char *section, const char *varName = "");
 };
 
@@ -1,6 +1,8 @@
 #include "GlobalTime.h"
 
+#include "BootProfiler.h"
 #include "ConfigManager.h"
+#include "TaskManager.h"
 #include "Translations.h"
 #include "config_helper.h"
 #include <ArduinoJson.h>
@@ -34,7 +36,32 @@ time_t GlobalTime::getUnixEpochIfAvailable() {
     return m_instance ? m_instance->getUnixEpoch() : 0;
 }
 
+void GlobalTime::syncInBackground() {
+    m_syncing = true;
+    BaseType_t result = xTaskCreatePinnedToCore(
+        [](void *param) {
+            auto *time = static_cast<GlobalTime *>(param);
+            BootProfiler::begin("ntp");
+            time->m_timeClient->forceUpdate();
+            if (time->m_timeClient->isTimeSet()) {
+                time->getTimeZoneOffsetFromAPI();
+            }
+            BootProfiler::end("ntp");
+            time->m_syncing = false;
+            vTaskDelete(nullptr);
+        },
+        "NTP_SYNC", 8192, this, 1, nullptr, TASKMANAGER_CORE);
+    if (result != pdPASS) {
+        Log.warningln("Failed to create NTP sync task");
+        m_syncing = false;
+    }
+}
+
 void GlobalTime::updateTime(bool force) {
+    if (m_syncing) {
+        // The background sync owns the NTP client
+        return;
+    }
     if (force || millis() - m_updateTimer > m_oneSecond) {
         m_updateTimer = millis();
         m_timeClient->update();
@@ -76,24 +103,16 @@ int GlobalTime::getHour24() {
     return m_hour24;
 }
 
-String GlobalTime::getHourPadded() {
-    if (m_hour < 10) {
-        return "0" + String(m_hour);
-    } else {
-        return String(m_hour);
-    }
+FrameString GlobalTime::getHourPadded() {
+    return FrameString::format("%02d", m_hour);
 }
 
 int GlobalTime::getMinute() {
     return m_minute;
 }
 
-String GlobalTime::getMinutePadded() {
-    if (m_minute < 10) {
-        return "0" + String(m_minute);
-    } else {
-        return String(m_minute);
-    }
+FrameString GlobalTime::getMinutePadded() {
+    return FrameString::format("%02d", m_minute);
 }
 
 int GlobalTime::getSecond() {
@@ -112,7 +131,7 @@ int GlobalTime::getMonth() {
     return m_month;
 }
 
-String GlobalTime::getMonthName() {
+const String &GlobalTime::getMonthName() {
     return m_monthName;
 }
 
@@ -124,18 +143,29 @@ String GlobalTime::getTime() {
     return m_time;
 }
 
-String GlobalTime::getWeekday() {
+const String &GlobalTime::getWeekday() {
     return m_weekday;
 }
 
-String GlobalTime::getDayAndMonth() {
+FrameString GlobalTime::getDayAndMonth() {
 #ifdef WEATHER_UNITS_METRIC
-    String retVal = i18n(t_dayMonthFormat);
-    retVal.replace("%d", String(m_day));
-    retVal.replace("%B", m_monthName);
+    // Expand %d and %B of the translated format
+    FrameString retVal;
+    for (const char *c = i18n(t_dayMonthFormat); *c != '\0'; c++) {
+        if (c[0] == '%' && c[1] == 'd') {
+            char day[4];
+            retVal += itoa(m_day, day, 10);
+            c++;
+        } else if (c[0] == '%' && c[1] == 'B') {
+            retVal += m_monthName.c_str();
+            c++;
+        } else {
+            retVal += *c;
+        }
+    }
     return retVal;
 #else
-    return m_monthName + " " + String(m_day);
+    return FrameString::format("%s %d", m_monthName.c_str(), m_day);
 #endif
 }
 
@@ -1,6 +1,7 @@
 #ifndef GLOBALTIME_H
 #define GLOBALTIME_H
 
+#include "FrameString.h"
 #include "config_helper.h"
 #include <HTTPClient.h>
 #include <NTPClient.h>
@@ -28,21 +29,24 @@ public:
     static time_t getUnixEpochIfAvailable();
 
     void updateTime(bool force = false);
+    // Run the first NTP exchange and timezone lookup on a background task,
+    // updateTime() skips until it's done
+    void syncInBackground();
     void getHourAndMinute(int &hour, int &minute);
     int getHour();
     int getHour24();
-    String getHourPadded();
+    FrameString getHourPadded();
     int getMinute();
-    String getMinutePadded();
+    FrameString getMinutePadded();
     time_t getUnixEpoch();
     int getSecond();
     int getDay();
     int getMonth();
-    String getMonthName();
+    const String &getMonthName();
     int getYear();
     String getTime();
-    String getWeekday();
-    String getDayAndMonth();
+    const String &getWeekday();
+    FrameString getDayAndMonth();
     bool isPM();
     bool getFormat24Hour();
     bool setFormat24Hour(bool format24hour);
@@ -77,6 +81,7 @@ private:
     const int m_highYearTest = 2035;
     unsigned long m_oneSecond = 1000;
     unsigned long m_updateTimer = 0;
+    volatile bool m_syncing = false;
 
     bool m_format24hour{FORMAT_24_HOUR};
     std::string m_ntpServer{NTP_SERVER};
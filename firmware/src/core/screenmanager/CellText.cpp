@@ -0,0 +1,193 @@
+#include "CellText.h"
+
+void CellText::setPosition(int x, int y, unsigned int fontSize, Align align) {
+    m_x = x;
+    m_y = y;
+    m_fontSize = fontSize;
+    m_align = align;
+}
+
+void CellText::draw(ScreenManager &manager, const char *text, uint32_t fgColor, uint32_t bgColor) {
+    uint16_t codes[CELL_TEXT_MAX_CELLS];
+    uint8_t count = decode(text, codes);
+    bool sameColors = m_drawn && fgColor == m_fgColor && bgColor == m_bgColor;
+    if (sameColors && count == m_cellCount) {
+        uint8_t i = 0;
+        while (i < count && codes[i] == m_cells[i].unicode) {
+            i++;
+        }
+        if (i == count) {
+            return;
+        }
+    }
+    if (!updateMetrics(manager)) {
+        return;
+    }
+
+    // Lay out relative to the start of the line, ink extents relative to the baseline
+    Cell cells[CELL_TEXT_MAX_CELLS];
+    int32_t width = 0;
+    int32_t inkLeft = 0;
+    int32_t inkRight = 0;
+    int16_t top = m_digitTop;
+    int16_t bottom = m_digitBottom;
+    for (uint8_t i = 0; i < count; i++) {
+        cells[i].unicode = codes[i];
+        cells[i].x = width;
+        if (isDigit(codes[i])) {
+            cells[i].width = m_digitWidth;
+            int32_t left, right;
+            getInk(cells[i], left, right);
+            inkLeft = min(inkLeft, left);
+            inkRight = max(inkRight, right);
+        } else {
+            GlyphMetrics metrics = {0, 0, 0, 0, 0};
+            manager.getGlyphMetrics(codes[i], m_fontSize, metrics);
+            cells[i].width = max((int16_t) 0, metrics.advance);
+            top = max(top, metrics.top);
+            bottom = max(bottom, (int16_t) (metrics.height - metrics.top));
+            inkLeft = min(inkLeft, width + metrics.left);
+            inkRight = max(inkRight, width + metrics.left + metrics.width);
+        }
+        width += cells[i].width;
+    }
+    inkRight = max(inkRight, width);
+
+    int32_t startX = m_x;
+    switch (m_align) {
+    case Align::Center:
+    case Align::TopCenter:
+    case Align::MiddleCenter:
+    case Align::BottomCenter:
+        startX -= width / 2;
+        break;
+    case Align::Right:
+    case Align::TopRight:
+    case Align::MiddleRight:
+    case Align::BottomRight:
+        startX -= width;
+        break;
+    default:
+        break;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        cells[i].x += startX;
+    }
+
+    // Only digits changed and nothing moved: repaint just those cells
+    bool sameLayout = sameColors && count == m_cellCount;
+    for (uint8_t i = 0; i < count && sameLayout; i++) {
+        const Cell &old = m_cells[i];
+        sameLayout = cells[i].x == old.x && cells[i].width == old.width && (cells[i].unicode == old.unicode || (isDigit(cells[i].unicode) && isDigit(old.unicode)));
+    }
+    if (sameLayout) {
+        // Clear the old digit's ink and the cell, then draw the changed cells and the ones the clearing touched
+        int32_t clearLeft[CELL_TEXT_MAX_CELLS];
+        int32_t clearRight[CELL_TEXT_MAX_CELLS];
+        uint8_t clearCount = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            if (cells[i].unicode != m_cells[i].unicode) {
+                int32_t left, right;
+                getInk(m_cells[i], left, right);
+                manager.fillRect(left, m_top, right - left, m_bottom - m_top, bgColor);
+                clearLeft[clearCount] = left;
+                clearRight[clearCount++] = right;
+                m_cells[i] = cells[i];
+            }
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            int32_t left, right;
+            getInk(m_cells[i], left, right);
+            for (uint8_t c = 0; c < clearCount; c++) {
+                if (left < clearRight[c] && right > clearLeft[c]) {
+                    drawCell(manager, m_cells[i]);
+                    break;
+                }
+            }
+        }
+        return;
+    }
+
+    if (m_drawn) {
+        manager.fillRect(m_left, m_top, m_right - m_left, m_bottom - m_top, bgColor);
+    }
+    int32_t baseline = m_y + m_digitTop / 2;
+    m_fgColor = fgColor;
+    m_bgColor = bgColor;
+    m_cellCount = count;
+    m_left = startX + inkLeft;
+    m_right = startX + inkRight;
+    m_top = baseline - top;
+    m_bottom = baseline + bottom;
+    for (uint8_t i = 0; i < count; i++) {
+        m_cells[i] = cells[i];
+        drawCell(manager, m_cells[i]);
+    }
+    m_drawn = true;
+}
+
+bool CellText::updateMetrics(ScreenManager &manager) {
+    if (m_metricsFont == manager.getFont() && m_metricsSize == m_fontSize) {
+        return true;
+    }
+    m_digitWidth = 0;
+    m_digitTop = 0;
+    m_digitBottom = 0;
+    for (uint8_t d = 0; d < 10; d++) {
+        GlyphMetrics metrics;
+        if (!manager.getGlyphMetrics('0' + d, m_fontSize, metrics)) {
+            return false;
+        }
+        m_digitAdvances[d] = metrics.advance;
+        m_digitInkLeft[d] = metrics.left;
+        m_digitInkRight[d] = metrics.left + metrics.width;
+        m_digitWidth = max(m_digitWidth, (uint16_t) metrics.advance);
+        m_digitTop = max(m_digitTop, metrics.top);
+        m_digitBottom = max(m_digitBottom, (int16_t) (metrics.height - metrics.top));
+    }
+    m_metricsFont = manager.getFont();
+    m_metricsSize = m_fontSize;
+    return true;
+}
+
+void CellText::drawCell(ScreenManager &manager, const Cell &cell) {
+    // Digits are centered in their cell
+    int32_t x = cell.x;
+    if (isDigit(cell.unicode)) {
+        x += (m_digitWidth - m_digitAdvances[cell.unicode - '0']) / 2;
+    }
+    manager.drawGlyph(cell.unicode, x, m_y + m_digitTop / 2, m_fontSize, m_fgColor, m_bgColor);
+}
+
+void CellText::getInk(const Cell &cell, int32_t &left, int32_t &right) const {
+    left = cell.x;
+    right = cell.x + cell.width;
+    if (isDigit(cell.unicode)) {
+        uint8_t digit = cell.unicode - '0';
+        int32_t x = cell.x + (m_digitWidth - m_digitAdvances[digit]) / 2;
+        left = min(left, x + m_digitInkLeft[digit]);
+        right = max(right, x + m_digitInkRight[digit]);
+    }
+}
+
+uint8_t CellText::decode(const char *text, uint16_t *codes) {
+    uint8_t count = 0;
+    const uint8_t *p = (const uint8_t *) text;
+    while (*p != '\0' && count < CELL_TEXT_MAX_CELLS) {
+        uint16_t code = *p++;
+        if ((code & 0xE0) == 0xC0 && (*p & 0xC0) == 0x80) {
+            code = ((code & 0x1F) << 6) | (*p++ & 0x3F);
+        } else if ((code & 0xF0) == 0xE0 && (p[0] & 0xC0) == 0x80 && (p[1] & 0xC0) == 0x80) {
+            code = ((code & 0x0F) << 12) | ((p[0] & 0x3F) << 6) | (p[1] & 0x3F);
+            p += 2;
+        } else if (code >= 0x80) {
+            // Longer or broken sequences are skipped
+            while ((*p & 0xC0) == 0x80) {
+                p++;
+            }
+            continue;
+        }
+        codes[count++] = code;
+    }
+    return count;
+}
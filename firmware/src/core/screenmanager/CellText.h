@@ -0,0 +1,68 @@
+#ifndef CELL_TEXT_H
+#define CELL_TEXT_H
+
+#include "ScreenManager.h"
+
+#ifndef CELL_TEXT_MAX_CELLS
+    #define CELL_TEXT_MAX_CELLS 24 // Characters per line, longer text is cut
+#endif
+
+/**
+ * A line of text laid out in cells: digits get the width of the widest digit, any other
+ * character its own advance. The line remembers what it drew, so when only digits change
+ * (the minutes of a clock) just their cells are cleared and drawn again. A change of layout
+ * or colors repaints the whole line. Glyphs are placed by their own metrics. A digit's ink can
+ * reach past its cell, so a changed digit clears its old ink as well as the cell, and neighbours
+ * that clearing touched are drawn again.
+ */
+class CellText {
+public:
+    // y is the vertical middle of the digits, only the horizontal part of align is used
+    void setPosition(int x, int y, unsigned int fontSize, Align align);
+    // Draw UTF-8 text on the selected screen with the current font, repainting only what changed
+    void draw(ScreenManager &manager, const char *text, uint32_t fgColor, uint32_t bgColor);
+    // Forget what was drawn, e.g. after the screen was cleared
+    void invalidate() { m_drawn = false; }
+
+private:
+    struct Cell {
+        uint16_t unicode;
+        int16_t x;
+        uint16_t width;
+    };
+
+    bool updateMetrics(ScreenManager &manager);
+    void drawCell(ScreenManager &manager, const Cell &cell);
+    // Horizontal extent of the cell and the ink of its glyph
+    void getInk(const Cell &cell, int32_t &left, int32_t &right) const;
+    static uint8_t decode(const char *text, uint16_t *codes);
+    static bool isDigit(uint16_t unicode) { return unicode >= '0' && unicode <= '9'; }
+
+    int16_t m_x = 0;
+    int16_t m_y = 0;
+    uint16_t m_fontSize = 0;
+    Align m_align = Align::Left;
+
+    // Digit metrics of the font they were measured with
+    TTF_Font m_metricsFont = TTF_Font::NONE;
+    uint16_t m_metricsSize = 0;
+    uint16_t m_digitWidth = 0;
+    int16_t m_digitAdvances[10];
+    int16_t m_digitInkLeft[10]; // Relative to the glyph's origin
+    int16_t m_digitInkRight[10];
+    int16_t m_digitTop = 0;
+    int16_t m_digitBottom = 0;
+
+    // What is on the screen
+    bool m_drawn = false;
+    Cell m_cells[CELL_TEXT_MAX_CELLS];
+    uint8_t m_cellCount = 0;
+    int16_t m_left = 0;
+    int16_t m_right = 0;
+    int16_t m_top = 0;
+    int16_t m_bottom = 0;
+    uint32_t m_fgColor = 0;
+    uint32_t m_bgColor = 0;
+};
+
+#endif // CELL_TEXT_H
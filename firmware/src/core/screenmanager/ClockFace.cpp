@@ -0,0 +1,35 @@
+#include "ClockFace.h"
+
+void ClockFace::setClock(int x, int y, unsigned int fontSize, int gap) {
+    m_x = x;
+    m_hour.setPosition(x - gap, y, fontSize, Align::MiddleRight);
+    m_colon.setPosition(x, y, fontSize, Align::MiddleCenter);
+    m_minute.setPosition(x + gap, y, fontSize, Align::MiddleLeft);
+}
+
+void ClockFace::setLine(uint8_t line, int y, unsigned int fontSize) {
+    if (line < CLOCK_FACE_LINES) {
+        m_lines[line].setPosition(m_x, y, fontSize, Align::MiddleCenter);
+    }
+}
+
+void ClockFace::draw(ScreenManager &manager, const char *hour, const char *minute, uint32_t fgColor, uint32_t bgColor) {
+    m_hour.draw(manager, hour, fgColor, bgColor);
+    m_colon.draw(manager, ":", fgColor, bgColor);
+    m_minute.draw(manager, minute, fgColor, bgColor);
+}
+
+void ClockFace::drawLine(ScreenManager &manager, uint8_t line, const char *text, uint32_t fgColor, uint32_t bgColor) {
+    if (line < CLOCK_FACE_LINES) {
+        m_lines[line].draw(manager, text, fgColor, bgColor);
+    }
+}
+
+void ClockFace::invalidate() {
+    m_hour.invalidate();
+    m_colon.invalidate();
+    m_minute.invalidate();
+    for (uint8_t i = 0; i < CLOCK_FACE_LINES; i++) {
+        m_lines[i].invalidate();
+    }
+}
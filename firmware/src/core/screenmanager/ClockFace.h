@@ -0,0 +1,36 @@
+#ifndef CLOCK_FACE_H
+#define CLOCK_FACE_H
+
+#include "CellText.h"
+
+#ifndef CLOCK_FACE_LINES
+    #define CLOCK_FACE_LINES 2 // Extra text lines, e.g. date and weekday
+#endif
+
+/**
+ * Digital clock face shared by the widgets that show a time on an orb: hour and minute
+ * on both sides of a colon plus a few centered text lines. Every part is a CellText, so a
+ * new minute repaints only the digit cells that changed instead of the whole screen.
+ */
+class ClockFace {
+public:
+    // Colon centered on x/y, hour right of x - gap and minute left of x + gap
+    void setClock(int x, int y, unsigned int fontSize, int gap);
+    // Text line centered on the clock's x
+    void setLine(uint8_t line, int y, unsigned int fontSize);
+
+    // Draw on the selected screen with the current font
+    void draw(ScreenManager &manager, const char *hour, const char *minute, uint32_t fgColor, uint32_t bgColor);
+    void drawLine(ScreenManager &manager, uint8_t line, const char *text, uint32_t fgColor, uint32_t bgColor);
+    // Call after the screen was cleared
+    void invalidate();
+
+private:
+    int16_t m_x = 0;
+    CellText m_hour;
+    CellText m_colon;
+    CellText m_minute;
+    CellText m_lines[CLOCK_FACE_LINES];
+};
+
+#endif // CLOCK_FACE_H
@@ -0,0 +1,108 @@
+#include "DisplayList.h"
+#include <stddef.h>
+
+void DisplayList::clear() {
+    m_count = 0;
+    m_textUsed = 0;
+    m_overflowed = false;
+}
+
+DisplayItem *DisplayList::add(DisplayOp op, const DisplayRect &bounds, const char *text) {
+    size_t length = text != nullptr ? strlen(text) : 0;
+    if (m_count >= DISPLAY_LIST_ITEMS || (text != nullptr && m_textUsed + length + 1 > DISPLAY_LIST_TEXT)) {
+        m_overflowed = true;
+        return nullptr;
+    }
+    DisplayItem *item = &m_items[m_count++];
+    // Padding is hashed as well
+    memset(item, 0, sizeof(DisplayItem));
+    item->op = op;
+    item->bounds = bounds;
+    if (text != nullptr) {
+        memcpy(m_text + m_textUsed, text, length + 1);
+        item->data = (const uint8_t *) (m_text + m_textUsed);
+        item->size = length;
+        m_textUsed += length + 1;
+    }
+    return item;
+}
+
+void DisplayList::seal(DisplayItem &item) {
+    item.hash = hash(2166136261UL, (const uint8_t *) &item, offsetof(DisplayItem, data));
+    if (item.data != nullptr) {
+        item.hash = hash(item.hash, item.data, item.size);
+    }
+}
+
+uint8_t DisplayList::diff(const DisplayList &previous, const DisplayRect &screen, DisplayRect *dirty) const {
+    if (previous.isEmpty()) {
+        dirty[0] = screen;
+        return 1;
+    }
+
+    // Match items in order, everything skipped on either side is added, changed or removed
+    uint8_t count = 0;
+    uint8_t next = 0;
+    for (uint8_t i = 0; i < m_count; i++) {
+        const DisplayItem &item = m_items[i];
+        uint8_t match = next;
+        while (match < previous.m_count && previous.m_items[match].hash != item.hash) {
+            match++;
+        }
+        if (match == previous.m_count) {
+            count = addDirty(dirty, count, item.bounds, screen);
+            continue;
+        }
+        for (; next < match; next++) {
+            count = addDirty(dirty, count, previous.m_items[next].bounds, screen);
+        }
+        next = match + 1;
+    }
+    for (; next < previous.m_count; next++) {
+        count = addDirty(dirty, count, previous.m_items[next].bounds, screen);
+    }
+    return count;
+}
+
+uint8_t DisplayList::addDirty(DisplayRect *dirty, uint8_t count, DisplayRect rect, const DisplayRect &screen) {
+    rect.left = max(rect.left, screen.left);
+    rect.top = max(rect.top, screen.top);
+    rect.right = min(rect.right, screen.right);
+    rect.bottom = min(rect.bottom, screen.bottom);
+    if (rect.isEmpty()) {
+        return count;
+    }
+
+    // Overlapping areas are repainted as one, merging can make more of them overlap
+    uint8_t i = 0;
+    while (i < count) {
+        if (dirty[i].intersects(rect)) {
+            rect.left = min(rect.left, dirty[i].left);
+            rect.top = min(rect.top, dirty[i].top);
+            rect.right = max(rect.right, dirty[i].right);
+            rect.bottom = max(rect.bottom, dirty[i].bottom);
+            dirty[i] = dirty[--count];
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+    if (count == DISPLAY_LIST_DIRTY_RECTS) {
+        DisplayRect &last = dirty[count - 1];
+        last.left = min(last.left, rect.left);
+        last.top = min(last.top, rect.top);
+        last.right = max(last.right, rect.right);
+        last.bottom = max(last.bottom, rect.bottom);
+        return count;
+    }
+    dirty[count] = rect;
+    return count + 1;
+}
+
+// FNV-1a
+uint32_t DisplayList::hash(uint32_t hash, const uint8_t *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619UL;
+    }
+    return hash;
+}
@@ -0,0 +1,98 @@
+#ifndef DISPLAY_LIST_H
+#define DISPLAY_LIST_H
+
+#include "ttf-fonts.h"
+#include <Arduino.h>
+#include <OpenFontRender.h>
+
+#ifndef DISPLAY_LIST_ITEMS
+    #define DISPLAY_LIST_ITEMS 32 // Primitives per recorded screen, more are dropped
+#endif
+
+#ifndef DISPLAY_LIST_TEXT
+    #define DISPLAY_LIST_TEXT 384 // Bytes of text per recorded screen
+#endif
+
+#ifndef DISPLAY_LIST_DIRTY_RECTS
+    #define DISPLAY_LIST_DIRTY_RECTS 6 // Areas repainted per commit, more are merged
+#endif
+
+enum class DisplayOp : uint8_t {
+    FillScreen,
+    FillRect,
+    FillCircle,
+    String,
+    Arc,
+    SmoothArc,
+    Jpg,
+};
+
+// Screen area, right and bottom are exclusive
+struct DisplayRect {
+    int16_t left;
+    int16_t top;
+    int16_t right;
+    int16_t bottom;
+
+    bool isEmpty() const { return left >= right || top >= bottom; }
+    bool intersects(const DisplayRect &other) const {
+        return left < other.right && other.left < right && top < other.bottom && other.top < bottom;
+    }
+};
+
+// One recorded drawing call with resolved parameters (scaled font size, dimmed colors)
+struct DisplayItem {
+    DisplayOp op;
+    uint8_t flags; // Align of a string, smooth/round ends of an arc, scale of an image
+    uint16_t fontSize;
+    TTF_Font font;
+    int16_t x;
+    int16_t y;
+    int16_t w; // Width of a rect, radius of a circle or arc
+    int16_t h; // Height of a rect, inner radius of an arc
+    uint16_t startAngle;
+    uint16_t endAngle;
+    uint32_t fgColor; // Image color of an image
+    uint32_t bgColor; // Brightness an image is dimmed with
+    uint32_t size; // Bytes of text or image data
+    // Not part of the hash
+    const uint8_t *data; // Text (in the list) or image data (owned by the widget)
+    uint32_t hash;
+    DisplayRect bounds;
+};
+
+/**
+ * The drawing calls of one screen, as recorded by ScreenManager in retained mode. Comparing
+ * the list of a new frame with the one of the last frame tells which areas of the screen
+ * changed: primitives that are in both lists (same parameters and content, same order) are
+ * already on the screen, the bounds of all others have to be repainted.
+ */
+class DisplayList {
+public:
+    // Forget all primitives, an empty list doesn't describe the screen
+    void clear();
+    bool isEmpty() const { return m_count == 0; }
+    bool isOverflowed() const { return m_overflowed; }
+    uint8_t getCount() const { return m_count; }
+    const DisplayItem &getItem(uint8_t index) const { return m_items[index]; }
+
+    // Zeroed item with op, bounds and a copy of text set, nullptr if the list is full
+    DisplayItem *add(DisplayOp op, const DisplayRect &bounds, const char *text = nullptr);
+    // Call after all parameters of item are set
+    void seal(DisplayItem &item);
+
+    // Areas that differ from previous (all of the screen if previous is empty), returns their count
+    uint8_t diff(const DisplayList &previous, const DisplayRect &screen, DisplayRect *dirty) const;
+
+private:
+    static uint8_t addDirty(DisplayRect *dirty, uint8_t count, DisplayRect rect, const DisplayRect &screen);
+    static uint32_t hash(uint32_t hash, const uint8_t *data, size_t size);
+
+    DisplayItem m_items[DISPLAY_LIST_ITEMS];
+    uint8_t m_count = 0;
+    char m_text[DISPLAY_LIST_TEXT];
+    uint16_t m_textUsed = 0;
+    bool m_overflowed = false;
+};
+
+#endif // DISPLAY_LIST_H
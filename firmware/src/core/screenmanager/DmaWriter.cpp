@@ -0,0 +1,105 @@
+#include "DmaWriter.h"
+#include "DrawStats.h"
+#include <ArduinoLog.h>
+#include <esp_heap_caps.h>
+
+DmaWriter::DmaWriter(TFT_eSPI &tft) : m_tft(tft) {
+}
+
+bool DmaWriter::begin() {
+    if (!DMA_WRITER_ENABLED || m_ready) {
+        return m_ready;
+    }
+    for (uint8_t i = 0; i < 2; i++) {
+        m_buffers[i] = (uint16_t *) heap_caps_malloc(DMA_BUFFER_PIXELS * sizeof(uint16_t), MALLOC_CAP_DMA);
+    }
+    m_ready = m_buffers[0] != nullptr && m_buffers[1] != nullptr && m_tft.initDMA();
+    if (!m_ready) {
+        Log.warningln("DMA not available, pixels are pushed by the CPU");
+    }
+    return m_ready;
+}
+
+void DmaWriter::startWrite() {
+    m_tft.startWrite();
+    DrawStats::transaction();
+    m_writing = true;
+    m_writeStart = micros();
+    m_sectionStart = m_stats;
+}
+
+void DmaWriter::endWrite() {
+    wait();
+    m_tft.endWrite();
+    m_writing = false;
+    m_stats.activeMicros += micros() - m_writeStart;
+    uint32_t transfers = m_stats.transfers - m_sectionStart.transfers;
+    if (transfers > 0) {
+        uint32_t bytes = m_stats.bytes - m_sectionStart.bytes;
+        uint32_t active = m_stats.activeMicros - m_sectionStart.activeMicros;
+        Log.traceln("DMA: %d transfers, %d bytes in %d us, bus %d%%, CPU idle %d%%", (int) transfers, (int) bytes, (int) active,
+                    (int) percent(busMicros(bytes), active), (int) percent(m_stats.waitMicros - m_sectionStart.waitMicros, active));
+    }
+}
+
+void DmaWriter::push(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *pixels, uint16_t stride) {
+    if (!m_ready || !m_writing || w * h > DMA_BUFFER_PIXELS) {
+        wait();
+        if (!m_writing) {
+            DrawStats::transaction();
+        }
+        if (stride == w) {
+            m_tft.pushImage(x, y, w, h, (uint16_t *) pixels);
+            DrawStats::write(1, w * h);
+            return;
+        }
+        for (int32_t row = 0; row < h; row++) {
+            m_tft.pushImage(x, y + row, w, 1, (uint16_t *) pixels + row * stride);
+        }
+        DrawStats::write(h, w * h);
+        return;
+    }
+
+    // The other buffer may still be in flight, this one was sent before it
+    uint16_t *buffer = m_buffers[m_next];
+    for (int32_t row = 0; row < h; row++) {
+        memcpy(buffer + row * w, pixels + row * stride, w * sizeof(uint16_t));
+    }
+    wait();
+    m_tft.pushImageDMA(x, y, w, h, buffer);
+    DrawStats::write(1, w * h);
+    m_pending = true;
+    m_next ^= 1;
+    m_stats.transfers++;
+    m_stats.bytes += w * h * sizeof(uint16_t);
+}
+
+void DmaWriter::wait() {
+    if (!m_pending) {
+        return;
+    }
+    uint32_t start = micros();
+    m_tft.dmaWait();
+    m_stats.waitMicros += micros() - start;
+    m_pending = false;
+}
+
+uint8_t DmaWriter::getBusUtilization() const {
+    return percent(busMicros(m_stats.bytes), m_stats.activeMicros);
+}
+
+uint8_t DmaWriter::getCpuIdle() const {
+    return percent(m_stats.waitMicros, m_stats.activeMicros);
+}
+
+// Time the bytes take on the bus at SPI_FREQUENCY
+uint32_t DmaWriter::busMicros(uint32_t bytes) {
+    return (uint64_t) bytes * 8000000ULL / SPI_FREQUENCY;
+}
+
+uint8_t DmaWriter::percent(uint32_t part, uint32_t whole) {
+    if (whole == 0) {
+        return 0;
+    }
+    return min((uint64_t) 100, (uint64_t) part * 100 / whole);
+}
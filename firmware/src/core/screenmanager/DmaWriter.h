@@ -0,0 +1,63 @@
+#ifndef DMA_WRITER_H
+#define DMA_WRITER_H
+
+#include "config_helper.h"
+#include <TFT_eSPI.h>
+
+#ifndef DMA_WRITER_ENABLED
+    #define DMA_WRITER_ENABLED 1 // Send image blocks and tiles with DMA while the CPU prepares the next one
+#endif
+
+#ifndef DMA_BUFFER_PIXELS
+    #define DMA_BUFFER_PIXELS 256 // Pixels per DMA buffer (two of them), larger blocks are pushed without DMA
+#endif
+
+// Totals since boot
+struct DmaStats {
+    uint32_t transfers;
+    uint32_t bytes;
+    uint32_t activeMicros; // Time spent in write sections
+    uint32_t waitMicros; // Time the CPU waited for a transfer to finish
+};
+
+/**
+ * Pushes pixel blocks to the selected screens through two alternating DMA buffers: a block is
+ * copied into the free buffer while the other one is still being sent, so decoding or rendering
+ * the next block overlaps with the transfer. The bus is held from startWrite() to endWrite(),
+ * wait() has to be called before the chip selects change.
+ */
+class DmaWriter {
+public:
+    DmaWriter(TFT_eSPI &tft);
+
+    // Set up DMA and the buffers, false if DMA isn't available (or disabled)
+    bool begin();
+    void startWrite();
+    void endWrite();
+    bool isWriting() const { return m_writing; }
+    // Send rows of w pixels, stride apart, to x/y. Outside a write section it's a blocking push.
+    void push(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *pixels, uint16_t stride);
+    // Wait for the transfer in flight
+    void wait();
+
+    const DmaStats &getStats() const { return m_stats; }
+    // Estimated bus time (bytes at SPI_FREQUENCY) and CPU wait in percent of the time in write sections
+    uint8_t getBusUtilization() const;
+    uint8_t getCpuIdle() const;
+
+private:
+    static uint32_t busMicros(uint32_t bytes);
+    static uint8_t percent(uint32_t part, uint32_t whole);
+
+    TFT_eSPI &m_tft;
+    uint16_t *m_buffers[2] = {nullptr, nullptr};
+    uint8_t m_next = 0;
+    bool m_ready = false;
+    bool m_writing = false;
+    bool m_pending = false;
+    uint32_t m_writeStart = 0;
+    DmaStats m_stats = {0, 0, 0, 0};
+    DmaStats m_sectionStart;
+};
+
+#endif // DMA_WRITER_H
@@ -0,0 +1,184 @@
+#include "DrawStats.h"
+#include <ArduinoJson.h>
+#include <ArduinoLog.h>
+
+DrawCounters DrawStats::s_bus = {};
+DrawCounters DrawStats::s_orbs[NUM_SCREENS] = {};
+DrawCounters DrawStats::s_frame = {};
+DrawCounters DrawStats::s_frameOrbs[NUM_SCREENS] = {};
+WidgetDrawStats DrawStats::s_widgets[DRAW_STATS_WIDGETS] = {};
+uint8_t DrawStats::s_widgetCount = 0;
+WidgetDrawStats *DrawStats::s_widget = nullptr;
+uint8_t DrawStats::s_screens = 0;
+
+void DrawCounters::add(const DrawCounters &other) {
+    drawCalls += other.drawCalls;
+    transactions += other.transactions;
+    windows += other.windows;
+    pixels += other.pixels;
+    bytes += other.bytes;
+}
+
+void DrawStats::setScreens(uint8_t screens) {
+    s_screens = screens;
+}
+
+void DrawStats::beginFrame(const char *name) {
+    if (s_widget != nullptr) {
+        // A forced draw restarts an unfinished one, the traffic so far is still counted
+        endFrame();
+    }
+    s_widget = findWidget(name);
+    s_frame = {};
+    memset(s_frameOrbs, 0, sizeof(s_frameOrbs));
+}
+
+void DrawStats::endFrame() {
+    if (s_widget == nullptr) {
+        return;
+    }
+    s_widget->frames++;
+    s_widget->last = s_frame;
+    s_widget->total.add(s_frame);
+    if (s_frame.drawCalls > 0 || s_frame.bytes > 0) {
+        // Share of a full screen each orb was sent, anything near 100% on a small change is waste
+        char orbs[NUM_SCREENS * 6 + 1] = "";
+        for (int i = 0; i < NUM_SCREENS; i++) {
+            uint32_t share = s_frameOrbs[i].pixels * 100 / (SCREEN_SIZE * SCREEN_SIZE);
+            snprintf(orbs + strlen(orbs), sizeof(orbs) - strlen(orbs), " %d%%", (int) min(share, (uint32_t) 999));
+        }
+        Log.traceln("Frame of %s: %d calls, %d transactions, %d windows, %d px, %d bytes, orbs:%s", s_widget->name, (int) s_frame.drawCalls,
+                    (int) s_frame.transactions, (int) s_frame.windows, (int) s_frame.pixels, (int) s_frame.bytes, orbs);
+    }
+    s_widget = nullptr;
+}
+
+void DrawStats::drawCall() {
+    add({1, 0, 0, 0, 0});
+}
+
+void DrawStats::transaction(uint32_t count) {
+    add({0, count, 0, 0, 0});
+}
+
+void DrawStats::write(uint32_t windows, uint32_t pixels) {
+    add({0, 0, windows, pixels, (uint64_t) windows * DRAW_STATS_WINDOW_BYTES + (uint64_t) pixels * 2});
+}
+
+void DrawStats::primitive(uint32_t windows, uint32_t pixels) {
+    add({1, 1, windows, pixels, (uint64_t) windows * DRAW_STATS_WINDOW_BYTES + (uint64_t) pixels * 2});
+}
+
+// Filled: a line per row, outline: a window per pixel
+void DrawStats::circle(int32_t r, bool filled) {
+    if (filled) {
+        primitive(2 * r + 1, (uint32_t) (PI * r * r));
+    } else {
+        primitive((uint32_t) (2 * PI * r), (uint32_t) (2 * PI * r));
+    }
+}
+
+// The share of the ring between the angles, edge pixels are blended one by one
+void DrawStats::arc(int32_t r, int32_t ir, uint32_t startAngle, uint32_t endAngle) {
+    uint32_t degrees = endAngle >= startAngle ? endAngle - startAngle : endAngle + 360 - startAngle;
+    float sweep = degrees / 360.0f;
+    primitive((uint32_t) (2 * r + 2 * PI * (r + ir) * sweep), (uint32_t) (PI * (r * r - ir * ir) * sweep));
+}
+
+// Runs of pixels on a row or column, a window each
+void DrawStats::line(int32_t dx, int32_t dy) {
+    primitive(min(abs(dx), abs(dy)) + 1, max(abs(dx), abs(dy)) + 1);
+}
+
+void DrawStats::reset() {
+    s_bus = {};
+    memset(s_orbs, 0, sizeof(s_orbs));
+    for (uint8_t i = 0; i < s_widgetCount; i++) {
+        s_widgets[i].frames = 0;
+        s_widgets[i].last = {};
+        s_widgets[i].total = {};
+    }
+}
+
+// Sent once on the bus, received by each selected orb
+void DrawStats::add(const DrawCounters &counters) {
+    if (!DRAW_STATS_ENABLED) {
+        return;
+    }
+    s_bus.add(counters);
+    for (int i = 0; i < NUM_SCREENS; i++) {
+        if (s_screens & SCREEN_MASK(i)) {
+            s_orbs[i].add(counters);
+            s_frameOrbs[i].add(counters);
+        }
+    }
+    if (s_widget != nullptr) {
+        s_frame.add(counters);
+    }
+}
+
+WidgetDrawStats *DrawStats::findWidget(const char *name) {
+    for (uint8_t i = 0; i < s_widgetCount; i++) {
+        if (s_widgets[i].name == name || strcmp(s_widgets[i].name, name) == 0) {
+            return &s_widgets[i];
+        }
+    }
+    if (s_widgetCount == DRAW_STATS_WIDGETS) {
+        return nullptr;
+    }
+    WidgetDrawStats &widget = s_widgets[s_widgetCount++];
+    widget = {};
+    widget.name = name;
+    return &widget;
+}
+
+void DrawStats::printSummary() {
+    Log.noticeln("Draw calls and SPI traffic since boot:");
+    print("bus", s_bus);
+    for (int i = 0; i < NUM_SCREENS; i++) {
+        char name[8];
+        snprintf(name, sizeof(name), "orb %d", i);
+        print(name, s_orbs[i]);
+    }
+    for (uint8_t i = 0; i < s_widgetCount; i++) {
+        const WidgetDrawStats &widget = s_widgets[i];
+        print(widget.name, widget.total);
+        if (widget.frames > 0) {
+            Log.noticeln("    %d frames, %d KB per frame, last %d KB", (int) widget.frames, (int) (widget.total.bytes / widget.frames / 1024),
+                         (int) (widget.last.bytes / 1024));
+        }
+    }
+}
+
+void DrawStats::print(const char *name, const DrawCounters &counters) {
+    Log.noticeln("  %s: %d calls, %d transactions, %d k windows, %d k px, %d KB", name, (int) counters.drawCalls, (int) counters.transactions,
+                 (int) (counters.windows / 1000), (int) (counters.pixels / 1000), (int) (counters.bytes / 1024));
+}
+
+static void countersToJson(JsonObject object, const DrawCounters &counters) {
+    object["drawCalls"] = counters.drawCalls;
+    object["transactions"] = counters.transactions;
+    object["windows"] = counters.windows;
+    object["pixels"] = counters.pixels;
+    object["bytes"] = counters.bytes;
+}
+
+String DrawStats::getSummaryJson() {
+    JsonDocument doc;
+    countersToJson(doc["bus"].to<JsonObject>(), s_bus);
+    JsonArray orbs = doc["orbs"].to<JsonArray>();
+    for (int i = 0; i < NUM_SCREENS; i++) {
+        countersToJson(orbs.add<JsonObject>(), s_orbs[i]);
+    }
+    JsonArray widgets = doc["widgets"].to<JsonArray>();
+    for (uint8_t i = 0; i < s_widgetCount; i++) {
+        JsonObject widget = widgets.add<JsonObject>();
+        widget["name"] = s_widgets[i].name;
+        widget["frames"] = s_widgets[i].frames;
+        countersToJson(widget["last"].to<JsonObject>(), s_widgets[i].last);
+        countersToJson(widget["total"].to<JsonObject>(), s_widgets[i].total);
+    }
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
@@ -0,0 +1,90 @@
+#ifndef DRAW_STATS_H
+#define DRAW_STATS_H
+
+#include "ScreenManager.h"
+#include <Arduino.h>
+
+#ifndef DRAW_STATS_ENABLED
+    #define DRAW_STATS_ENABLED 1 // Count the draw calls and SPI traffic of each orb and widget
+#endif
+
+#ifndef DRAW_STATS_WIDGETS
+    #define DRAW_STATS_WIDGETS 16 // Widgets with counters of their own, more are not counted
+#endif
+
+#ifndef DRAW_STATS_WINDOW_BYTES
+    #define DRAW_STATS_WINDOW_BYTES 11 // CASET, RASET and RAMWR commands with their parameters
+#endif
+
+// What the panels were sent, bytes are the address windows plus 2 bytes per pixel
+struct DrawCounters {
+    uint64_t drawCalls;
+    uint64_t transactions;
+    uint64_t windows;
+    uint64_t pixels;
+    uint64_t bytes;
+
+    void add(const DrawCounters &other);
+};
+
+// Counters of the last complete draw() of a widget and since boot (or reset())
+struct WidgetDrawStats {
+    const char *name;
+    uint32_t frames;
+    DrawCounters last;
+    DrawCounters total;
+};
+
+/**
+ * Accounts for what ScreenManager sends over the shared SPI bus: draw calls, transactions,
+ * address windows, pixels and bytes. Traffic to several selected screens is sent once on the
+ * bus but counted for each orb that receives it. A frame is a draw() of a widget from its first
+ * step to its last, WidgetSet logs each one at trace level, so a widget that repaints what is
+ * already on screen (e.g. a full refill on every update) shows up. Pixels of shapes that
+ * TFT_eSPI rasterizes itself (circles, arcs, lines, legacy fonts) are estimated from their area.
+ * All calls are made from the drawing task. The summary is printed and served at /draws.
+ */
+class DrawStats {
+public:
+    // The selected screens receive the following traffic
+    static void setScreens(uint8_t screens);
+    // Traffic is accounted to the widget until endFrame(), name has to stay valid (interned)
+    static void beginFrame(const char *name);
+    static void endFrame();
+
+    static void drawCall();
+    static void transaction(uint32_t count = 1);
+    // Address windows and the pixels written into them
+    static void write(uint32_t windows, uint32_t pixels);
+    // A primitive with a transaction of its own
+    static void primitive(uint32_t windows, uint32_t pixels);
+    // Estimates for the shapes TFT_eSPI rasterizes, all are primitives
+    static void circle(int32_t r, bool filled);
+    static void arc(int32_t r, int32_t ir, uint32_t startAngle, uint32_t endAngle);
+    static void line(int32_t dx, int32_t dy);
+
+    static const DrawCounters &getBus() { return s_bus; }
+    static const DrawCounters &getOrb(uint8_t screen) { return s_orbs[screen]; }
+    static uint8_t getWidgetCount() { return s_widgetCount; }
+    static const WidgetDrawStats &getWidget(uint8_t index) { return s_widgets[index]; }
+    static void reset();
+
+    static void printSummary();
+    static String getSummaryJson();
+
+private:
+    static void add(const DrawCounters &counters);
+    static void print(const char *name, const DrawCounters &counters);
+    static WidgetDrawStats *findWidget(const char *name);
+
+    static DrawCounters s_bus;
+    static DrawCounters s_orbs[NUM_SCREENS];
+    static DrawCounters s_frame;
+    static DrawCounters s_frameOrbs[NUM_SCREENS];
+    static WidgetDrawStats s_widgets[DRAW_STATS_WIDGETS];
+    static uint8_t s_widgetCount;
+    static WidgetDrawStats *s_widget;
+    static uint8_t s_screens;
+};
+
+#endif // DRAW_STATS_H
@@ -0,0 +1,213 @@
+#include "GlyphAtlas.h"
+#include "DrawStats.h"
+#include "Utils.h"
+#include <ArduinoLog.h>
+
+static const uint16_t s_atlasChars[GLYPH_ATLAS_CHAR_COUNT] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', ':', '-', '.', '%', 0xB0, ' '};
+
+GlyphAtlas::GlyphAtlas(OpenFontRender &render, TFT_eSPI &tft) : m_render(render), m_tft(tft) {
+}
+
+bool GlyphAtlas::add(TTF_Font font, unsigned int fontSize) {
+    if (GLYPH_ATLAS_BUDGET == 0 || find(font, fontSize) != nullptr) {
+        return true;
+    }
+    if (m_entryCount == GLYPH_ATLAS_MAX_SIZES) {
+        Log.warningln("Glyph atlas full, font %d at %dpx not added", (int) font, (int) fontSize);
+        return false;
+    }
+    m_entries[m_entryCount].font = font;
+    m_entries[m_entryCount].fontSize = fontSize;
+    m_entryCount++;
+    return true;
+}
+
+bool GlyphAtlas::prepare(TTF_Font font, unsigned int fontSize, const char *text) {
+    Entry *entry = find(font, fontSize);
+    if (entry == nullptr || *text == '\0') {
+        return false;
+    }
+    while (*text != '\0') {
+        int8_t index = indexOf(nextChar(text));
+        if (index < 0) {
+            return false;
+        }
+        Glyph &glyph = entry->glyphs[index];
+        if (glyph.state == GlyphState::Pending) {
+            glyph.state = rasterize(s_atlasChars[index], glyph) ? GlyphState::Cached : GlyphState::Failed;
+        }
+        if (glyph.state == GlyphState::Failed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void GlyphAtlas::draw(TTF_Font font, unsigned int fontSize, const char *text, const FT_BBox &box, uint16_t fgColor, uint16_t bgColor) {
+    Entry *entry = find(font, fontSize);
+    if (entry == nullptr) {
+        return;
+    }
+    // The box starts at the leftmost ink and the highest glyph top, like OpenFontRender lays out the line
+    int32_t pen = 0;
+    int32_t minX = INT32_MAX;
+    int16_t maxTop = INT16_MIN;
+    for (const char *p = text; *p != '\0';) {
+        const Glyph &glyph = entry->glyphs[indexOf(nextChar(p))];
+        if (pen + glyph.left < minX) {
+            minX = pen + glyph.left;
+        }
+        if (glyph.top > maxTop) {
+            maxTop = glyph.top;
+        }
+        pen += glyph.advance;
+    }
+
+    uint16_t colors[16];
+    blendColors(colors, fgColor, bgColor);
+    m_tft.startWrite();
+    pen = 0;
+    for (const char *p = text; *p != '\0';) {
+        const Glyph &glyph = entry->glyphs[indexOf(nextChar(p))];
+        blit(glyph, box.xMin + pen + glyph.left - minX, box.yMin + maxTop - glyph.top, colors);
+        pen += glyph.advance;
+    }
+    m_tft.endWrite();
+    DrawStats::transaction();
+}
+
+bool GlyphAtlas::drawGlyph(TTF_Font font, unsigned int fontSize, uint16_t unicode, int32_t x, int32_t y, uint16_t fgColor, uint16_t bgColor) {
+    Entry *entry = find(font, fontSize);
+    int8_t index = indexOf(unicode);
+    if (entry == nullptr || index < 0) {
+        return false;
+    }
+    Glyph &glyph = entry->glyphs[index];
+    if (glyph.state == GlyphState::Pending) {
+        glyph.state = rasterize(unicode, glyph) ? GlyphState::Cached : GlyphState::Failed;
+    }
+    if (glyph.state == GlyphState::Failed) {
+        return false;
+    }
+    uint16_t colors[16];
+    blendColors(colors, fgColor, bgColor);
+    m_tft.startWrite();
+    blit(glyph, x + glyph.left, y - glyph.top, colors);
+    m_tft.endWrite();
+    DrawStats::transaction();
+    return true;
+}
+
+GlyphAtlas::Entry *GlyphAtlas::find(TTF_Font font, unsigned int fontSize) {
+    for (uint8_t i = 0; i < m_entryCount; i++) {
+        if (m_entries[i].font == font && m_entries[i].fontSize == fontSize) {
+            return &m_entries[i];
+        }
+    }
+    return nullptr;
+}
+
+bool GlyphAtlas::rasterize(uint16_t unicode, Glyph &glyph) {
+    FT_BitmapGlyph rendered;
+    int32_t advance;
+    if (m_render.renderGlyph(unicode, rendered, advance) != FT_Err_Ok) {
+        return false;
+    }
+    const FT_Bitmap &bitmap = rendered->bitmap;
+    size_t pitch = (bitmap.width + 1) / 2;
+    size_t size = pitch * bitmap.rows;
+    if (m_bytes + size > GLYPH_ATLAS_BUDGET) {
+        Log.warningln("Glyph atlas budget used up, glyph %d at %dpx not cached", (int) unicode, (int) m_render.getFontSize());
+        return false;
+    }
+    if (size > 0) {
+        glyph.bitmap = (uint8_t *) calloc(size, 1);
+        if (glyph.bitmap == nullptr) {
+            return false;
+        }
+        for (uint32_t y = 0; y < bitmap.rows; y++) {
+            const uint8_t *src = bitmap.buffer + y * bitmap.pitch;
+            uint8_t *dst = glyph.bitmap + y * pitch;
+            for (uint32_t x = 0; x < bitmap.width; x++) {
+                uint8_t level = (src[x] * 15 + 127) / 255;
+                dst[x / 2] |= (x & 1) ? level : level << 4;
+            }
+        }
+    }
+    glyph.left = rendered->left;
+    glyph.top = rendered->top;
+    glyph.width = bitmap.width;
+    glyph.height = bitmap.rows;
+    glyph.advance = advance;
+    m_bytes += size;
+    m_glyphCount++;
+    return true;
+}
+
+void GlyphAtlas::blit(const Glyph &glyph, int32_t x, int32_t y, const uint16_t *colors) {
+    // Opaque runs as lines, anti-aliased edges as pixels, transparent pixels are skipped
+    size_t pitch = (glyph.width + 1) / 2;
+    const uint8_t *row = glyph.bitmap;
+    uint32_t windows = 0;
+    uint32_t pixels = 0;
+    for (uint16_t dy = 0; dy < glyph.height; dy++, row += pitch) {
+        int32_t runStart = -1;
+        for (uint16_t dx = 0; dx < glyph.width; dx++) {
+            uint8_t level = (dx & 1) ? row[dx / 2] & 0x0F : row[dx / 2] >> 4;
+            if (level == 15) {
+                if (runStart < 0) {
+                    runStart = dx;
+                }
+                continue;
+            }
+            if (runStart >= 0) {
+                m_tft.drawFastHLine(x + runStart, y + dy, dx - runStart, colors[15]);
+                windows++;
+                pixels += dx - runStart;
+                runStart = -1;
+            }
+            if (level > 0) {
+                m_tft.drawPixel(x + dx, y + dy, colors[level]);
+                windows++;
+                pixels++;
+            }
+        }
+        if (runStart >= 0) {
+            m_tft.drawFastHLine(x + runStart, y + dy, glyph.width - runStart, colors[15]);
+            windows++;
+            pixels += glyph.width - runStart;
+        }
+    }
+    DrawStats::write(windows, pixels);
+}
+
+void GlyphAtlas::blendColors(uint16_t *colors, uint16_t fgColor, uint16_t bgColor) {
+    for (uint8_t level = 1; level < 15; level++) {
+        colors[level] = Utils::rgb565alphaBlend(level * 17, fgColor, bgColor);
+    }
+    colors[15] = fgColor;
+}
+
+int8_t GlyphAtlas::indexOf(uint16_t unicode) {
+    for (int8_t i = 0; i < GLYPH_ATLAS_CHAR_COUNT; i++) {
+        if (s_atlasChars[i] == unicode) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+uint16_t GlyphAtlas::nextChar(const char *&text) {
+    uint8_t c = *text++;
+    if (c < 0x80) {
+        return c;
+    }
+    if ((c & 0xE0) == 0xC0 && (*text & 0xC0) == 0x80) {
+        return ((c & 0x1F) << 6) | (*text++ & 0x3F);
+    }
+    // Longer sequences are never in the atlas
+    while ((*text & 0xC0) == 0x80) {
+        text++;
+    }
+    return 0xFFFF;
+}
@@ -0,0 +1,77 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include "ttf-fonts.h"
+#include <OpenFontRender.h>
+#include <TFT_eSPI.h>
+
+#ifndef GLYPH_ATLAS_BUDGET
+    #define GLYPH_ATLAS_BUDGET 40960 // Bytes of RAM for pre-rasterized glyphs, 0 = disabled
+#endif
+
+#ifndef GLYPH_ATLAS_MAX_SIZES
+    #define GLYPH_ATLAS_MAX_SIZES 8 // Number of (font, size) pairs that can be registered
+#endif
+
+// Digits, colon, minus, decimal point, percent, degree and space
+#define GLYPH_ATLAS_CHAR_COUNT 16
+
+/**
+ * Keeps the glyphs of clocks and numeric readouts as 4-bit alpha bitmaps, so drawing them
+ * at a registered (font, size) pair is a blit instead of a FreeType rasterization. Glyphs
+ * are rasterized at first use until GLYPH_ATLAS_BUDGET is used up, text with any other
+ * character (or a glyph that didn't fit) is left to OpenFontRender.
+ */
+class GlyphAtlas {
+public:
+    GlyphAtlas(OpenFontRender &render, TFT_eSPI &tft);
+
+    // fontSize is in pixels, as passed to OpenFontRender
+    bool add(TTF_Font font, unsigned int fontSize);
+    // Rasterizes missing glyphs with the current font of the renderer, false if text can't be drawn from the atlas
+    bool prepare(TTF_Font font, unsigned int fontSize, const char *text);
+    // Draw prepared text so its ink covers box (as calculated by OpenFontRender for the same text)
+    void draw(TTF_Font font, unsigned int fontSize, const char *text, const FT_BBox &box, uint16_t fgColor, uint16_t bgColor);
+    // Draw a single glyph with its origin (left end of the baseline) at x/y, false if it isn't in the atlas
+    bool drawGlyph(TTF_Font font, unsigned int fontSize, uint16_t unicode, int32_t x, int32_t y, uint16_t fgColor, uint16_t bgColor);
+
+    size_t getBytes() const { return m_bytes; }
+    uint16_t getGlyphCount() const { return m_glyphCount; }
+
+private:
+    enum class GlyphState : uint8_t {
+        Pending,
+        Cached,
+        Failed
+    };
+    struct Glyph {
+        uint8_t *bitmap = nullptr; // Two pixels per byte, rows start at a full byte
+        int16_t left = 0;
+        int16_t top = 0;
+        uint16_t width = 0;
+        uint16_t height = 0;
+        int16_t advance = 0;
+        GlyphState state = GlyphState::Pending;
+    };
+    struct Entry {
+        TTF_Font font;
+        uint16_t fontSize;
+        Glyph glyphs[GLYPH_ATLAS_CHAR_COUNT];
+    };
+
+    Entry *find(TTF_Font font, unsigned int fontSize);
+    bool rasterize(uint16_t unicode, Glyph &glyph);
+    void blit(const Glyph &glyph, int32_t x, int32_t y, const uint16_t *colors);
+    static void blendColors(uint16_t *colors, uint16_t fgColor, uint16_t bgColor);
+    static int8_t indexOf(uint16_t unicode);
+    static uint16_t nextChar(const char *&text);
+
+    OpenFontRender &m_render;
+    TFT_eSPI &m_tft;
+    Entry m_entries[GLYPH_ATLAS_MAX_SIZES];
+    uint8_t m_entryCount = 0;
+    size_t m_bytes = 0;
+    uint16_t m_glyphCount = 0;
+};
+
+#endif // GLYPH_ATLAS_H
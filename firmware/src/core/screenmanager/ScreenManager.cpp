@@ -1,13 +1,17 @@
 #include "ScreenManager.h"
+#include "CellText.h"
 #include "ConfigManager.h"
+#include "DrawStats.h"
+#include "FrameString.h"
 #include "Utils.h"
 #include <Arduino.h>
 #include <ArduinoLog.h>
 #include <LittleFS.h>
+#include <soc/gpio_reg.h>
 
 ScreenManager *ScreenManager::instance = nullptr;
 
-ScreenManager::ScreenManager(TFT_eSPI &tft) : m_tft(tft) {
+ScreenManager::ScreenManager(TFT_eSPI &tft) : m_tft(tft), m_target(&tft), m_atlas(m_render, tft), m_dma(tft), m_tiles(tft, m_dma) {
 
     for (int i = 0; i < NUM_SCREENS; i++) {
         pinMode(m_screen_cs[i], OUTPUT);
@@ -24,6 +28,8 @@ ScreenManager::ScreenManager(TFT_eSPI &tft) : m_tft(tft) {
         // applyCustomRotation(180, false); // Rotate 0°, mirror X
     }
 
+    m_dma.begin();
+    cacheChipSelects();
     reset();
 
     // Init TJpg_Decode
@@ -36,7 +42,7 @@ ScreenManager::ScreenManager(TFT_eSPI &tft) : m_tft(tft) {
     // Needs more testing to find the sweet spot.
     m_render.setCacheSize(8, 8, 4096);
     setFont(DEFAULT_FONT);
-    m_render.setDrawer(m_tft);
+    setScreenDrawer();
 
     Log.noticeln("ScreenManager initialized");
     Log.noticeln("TFT_MOSI: %s", String(TFT_MOSI));
@@ -100,14 +106,80 @@ OpenFontRender &ScreenManager::getRender() {
     return m_render;
 }
 
+// OpenFontRender draws on the screen, the pixels it writes are counted (see flushRenderStats())
+void ScreenManager::setScreenDrawer() {
+    m_render.set_drawPixel([this](int32_t x, int32_t y, uint16_t c) {
+        m_tft.drawPixel(x, y, c);
+        m_renderWindows++;
+        m_renderPixels++;
+    });
+    m_render.set_drawFastHLine([this](int32_t x, int32_t y, int32_t w, uint16_t c) {
+        m_tft.drawFastHLine(x, y, w, c);
+        m_renderWindows++;
+        m_renderPixels += w;
+    });
+    m_render.set_startWrite([this]() {
+        m_tft.startWrite();
+        m_renderTransactions++;
+    });
+    m_render.set_endWrite([this]() { m_tft.endWrite(); });
+}
+
+void ScreenManager::flushRenderStats() {
+    if (m_renderTransactions > 0) {
+        DrawStats::transaction(m_renderTransactions);
+    }
+    if (m_renderWindows > 0) {
+        DrawStats::write(m_renderWindows, m_renderPixels);
+    }
+    m_renderTransactions = 0;
+    m_renderWindows = 0;
+    m_renderPixels = 0;
+}
+
+// Pixels of a rect within the screen, or the area drawAreas() repaints
+uint32_t ScreenManager::clippedArea(int32_t x, int32_t y, int32_t w, int32_t h) {
+    int32_t left = max(x, m_clipping ? (int32_t) m_clip.left : 0);
+    int32_t top = max(y, m_clipping ? (int32_t) m_clip.top : 0);
+    int32_t right = min(x + w, m_clipping ? (int32_t) m_clip.right : (int32_t) m_tft.width());
+    int32_t bottom = min(y + h, m_clipping ? (int32_t) m_clip.bottom : (int32_t) m_tft.height());
+    return left < right && top < bottom ? (right - left) * (bottom - top) : 0;
+}
+
+// Changing the orb rotation requires a restart, so it's only read once
+void ScreenManager::cacheChipSelects() {
+    int orbRotation = ConfigManager::getInstance()->getConfigInt("orbRotation", ORB_ROTATION);
+    bool rotateDisplays = orbRotation == 1 || orbRotation == 2;
+    for (int i = 0; i < NUM_SCREENS; i++) {
+        uint8_t pin = m_screen_cs[rotateDisplays ? NUM_SCREENS - i - 1 : i];
+        m_csBits[i][0] = pin < 32 ? 1UL << pin : 0;
+        m_csBits[i][1] = pin >= 32 ? 1UL << (pin - 32) : 0;
+    }
+}
+
 // Selects a single screen
 void ScreenManager::selectScreen(int screen) {
+    selectScreens(screen >= 0 && screen < NUM_SCREENS ? SCREEN_MASK(screen) : 0);
+}
+
+// Selects any set of screens, the (active low) chip selects are set with one register write per GPIO bank
+void ScreenManager::selectScreens(uint8_t screens) {
+    m_dma.wait();
+    uint32_t select[2] = {0, 0};
+    uint32_t deselect[2] = {0, 0};
     for (int i = 0; i < NUM_SCREENS; i++) {
-        int orbRotation = ConfigManager::getInstance()->getConfigInt("orbRotation", ORB_ROTATION);
-        bool rotateDisplays = orbRotation == 1 || orbRotation == 2;
-        int currentDisplay = rotateDisplays ? NUM_SCREENS - i - 1 : i;
-        digitalWrite(m_screen_cs[currentDisplay], i == screen ? LOW : HIGH);
+        uint32_t *bits = (screens & SCREEN_MASK(i)) ? select : deselect;
+        bits[0] |= m_csBits[i][0];
+        bits[1] |= m_csBits[i][1];
     }
+    // Deselect first, so no screen sees a transfer meant for the others
+    REG_WRITE(GPIO_OUT_W1TS_REG, deselect[0]);
+    REG_WRITE(GPIO_OUT1_W1TS_REG, deselect[1]);
+    REG_WRITE(GPIO_OUT_W1TC_REG, select[0]);
+    REG_WRITE(GPIO_OUT1_W1TC_REG, select[1]);
+    m_selectedScreens = screens & ALL_SCREENS;
+    m_selectedScreen = __builtin_popcount(m_selectedScreens) == 1 ? __builtin_ctz(m_selectedScreens) : -1;
+    DrawStats::setScreens(m_selectedScreens);
 }
 
 // Fills all screens with a color
@@ -131,9 +203,42 @@ void ScreenManager::clearScreen(int screen) {
 }
 
 void ScreenManager::fillScreen(uint32_t color) {
-    m_tft.fillScreen(dim(color));
     // Set background for aliasing as well
     m_render.setBackgroundColor(dim(color));
+    if (m_recordScreen >= 0) {
+        DisplayItem *item = record(DisplayOp::FillScreen, 0, 0, m_tft.width(), m_tft.height());
+        if (item != nullptr) {
+            item->fgColor = dim(color);
+            m_recordList->seal(*item);
+        }
+        return;
+    }
+    m_tft.fillScreen(dim(color));
+    DrawStats::primitive(1, m_tft.width() * m_tft.height());
+    invalidateScreens(m_selectedScreens);
+    // The tiles of retained screens are known again
+    for (int i = 0; i < NUM_SCREENS; i++) {
+        if (m_tileHashes[i] != nullptr && (m_selectedScreens & SCREEN_MASK(i))) {
+            m_tiles.fill(m_tileHashes[i], dim(color));
+        }
+    }
+}
+
+// Forget the numbers and display lists drawn on screens
+void ScreenManager::invalidateScreens(uint8_t screens) {
+    for (int i = 0; i < NUM_SCREENS; i++) {
+        if ((screens & SCREEN_MASK(i)) == 0) {
+            continue;
+        }
+        for (int slot = 0; slot < SCREEN_NUMBER_SLOTS; slot++) {
+            if (m_numberSlots[i][slot] != nullptr) {
+                m_numberSlots[i][slot]->invalidate();
+            }
+        }
+        if (m_displayLists[i] != nullptr) {
+            m_displayLists[i]->clear();
+        }
+    }
 }
 
 bool ScreenManager::setBrightness(uint8_t brightness) {
@@ -167,6 +272,10 @@ void ScreenManager::setAlignment(Align align) {
     m_render.setAlignment(align);
 }
 
+bool ScreenManager::addToGlyphAtlas(TTF_Font font, unsigned int fontSize, bool applyScale) {
+    return m_atlas.add(font, applyScale ? getScaledFontSize(fontSize, font) : fontSize);
+}
+
 void ScreenManager::setFontSize(uint32_t size) {
     m_render.setFontSize(size);
 }
@@ -175,16 +284,12 @@ void ScreenManager::setFontSize(uint32_t size) {
 // I don't think that state should be used, It's kinda weird saying "ow select
 // all the screens to "off"
 void ScreenManager::selectAllScreens() {
-    for (int i = 0; i < NUM_SCREENS; i++) {
-        digitalWrite(m_screen_cs[i], LOW);
-    }
+    selectScreens(ALL_SCREENS);
 }
 
 // Unselect all screens
 void ScreenManager::reset() {
-    for (int i = 0; i < NUM_SCREENS; i++) {
-        digitalWrite(m_screen_cs[i], HIGH);
-    }
+    selectScreens(0);
 }
 
 unsigned int ScreenManager::calculateFitFontSize(uint32_t limit_width, uint32_t limit_height, Layout layout, const String &text) {
@@ -193,12 +298,20 @@ unsigned int ScreenManager::calculateFitFontSize(uint32_t limit_width, uint32_t
     return calcFontSize;
 }
 
-void ScreenManager::drawString(const String &text, int x, int y) {
+void ScreenManager::drawString(const char *text, int x, int y) {
     // Use current font size and alignment
     drawString(text, x, y, 0, m_render.getAlignment());
 }
 
+void ScreenManager::drawString(const String &text, int x, int y) {
+    drawString(text.c_str(), x, y);
+}
+
 void ScreenManager::drawString(const String &text, int x, int y, unsigned int fontSize, Align align, int32_t fgColor, int32_t bgColor, bool applyScale) {
+    drawString(text.c_str(), x, y, fontSize, align, fgColor, bgColor, applyScale);
+}
+
+void ScreenManager::drawString(const char *text, int x, int y, unsigned int fontSize, Align align, int32_t fgColor, int32_t bgColor, bool applyScale) {
 
     if (fontSize == 0) {
         // Keep current font size
@@ -221,16 +334,347 @@ void ScreenManager::drawString(const String &text, int x, int y, unsigned int fo
 
     // Dirty hack to correct misaligned Y
     // See https://github.com/takkaO/OpenFontRender/issues/38
-    FT_BBox box = m_render.calculateBoundingBox(0, 0, fontSize, Align::TopLeft, Layout::Horizontal, text.c_str());
+    FT_BBox box = m_render.calculateBoundingBox(0, 0, fontSize, Align::TopLeft, Layout::Horizontal, text);
+    if (m_recordScreen >= 0) {
+        // One pixel around the ink for antialiasing
+        FT_BBox inkBox = m_render.calculateBoundingBox(x, y - box.yMin, fontSize, align, Layout::Horizontal, text);
+        DisplayItem *item = record(DisplayOp::String, inkBox.xMin - 1, inkBox.yMin - 1, inkBox.xMax - inkBox.xMin + 3, inkBox.yMax - inkBox.yMin + 3, text);
+        if (item != nullptr) {
+            item->x = x;
+            item->y = y - box.yMin;
+            item->fontSize = fontSize;
+            item->font = m_curFont;
+            item->flags = (uint8_t) align;
+            item->fgColor = fgColor;
+            item->bgColor = bgColor;
+            m_recordList->seal(*item);
+        }
+        return;
+    }
+    DrawStats::drawCall();
+    renderString(text, x, y - box.yMin, fontSize, align, fgColor, bgColor);
+}
+
+// drawString() with scaled font size, dimmed colors and corrected y
+void ScreenManager::renderString(const char *text, int x, int y, unsigned int fontSize, Align align, uint16_t fgColor, uint16_t bgColor) {
     m_render.setAlignment(align);
     m_render.setFontSize(fontSize);
-    m_render.drawString(text.c_str(), x, y - box.yMin, fgColor, bgColor);
+    // The atlas draws on the screen only, not into a band
+    if (m_target == &m_tft && m_atlas.prepare(m_curFont, fontSize, text)) {
+        // Only the layout is calculated, the glyphs come from the atlas
+        FT_BBox inkBox = m_render.calculateBoundingBox(x, y, fontSize, align, Layout::Horizontal, text);
+        m_atlas.draw(m_curFont, fontSize, text, inkBox, fgColor, bgColor);
+        return;
+    }
+    m_render.drawString(text, x, y, fgColor, bgColor);
+    flushRenderStats();
 }
 
-void ScreenManager::drawCentreString(const String &text, int x, int y, unsigned int fontSize) {
+bool ScreenManager::getGlyphMetrics(uint16_t unicode, unsigned int fontSize, GlyphMetrics &metrics) {
+    m_render.setFontSize(getScaledFontSize(fontSize));
+    FT_BitmapGlyph glyph;
+    int32_t advance;
+    if (m_render.renderGlyph(unicode, glyph, advance) != FT_Err_Ok) {
+        return false;
+    }
+    metrics = {(int16_t) glyph->left, (int16_t) glyph->top, (uint16_t) glyph->bitmap.width, (uint16_t) glyph->bitmap.rows, (int16_t) advance};
+    return true;
+}
+
+void ScreenManager::drawGlyph(uint16_t unicode, int x, int y, unsigned int fontSize, uint32_t fgColor, uint32_t bgColor) {
+    fontSize = getScaledFontSize(fontSize);
+    uint16_t fg = dim(fgColor);
+    uint16_t bg = dim(bgColor);
+    m_render.setFontSize(fontSize);
+    DrawStats::drawCall();
+    if (m_atlas.drawGlyph(m_curFont, fontSize, unicode, x, y, fg, bg)) {
+        return;
+    }
+    FT_BitmapGlyph glyph;
+    int32_t advance;
+    if (m_render.renderGlyph(unicode, glyph, advance) != FT_Err_Ok) {
+        return;
+    }
+    // Opaque runs as lines and anti-aliased pixels blended like OpenFontRender does
+    const FT_Bitmap &bitmap = glyph->bitmap;
+    x += glyph->left;
+    y -= glyph->top;
+    uint32_t windows = 0;
+    uint32_t pixels = 0;
+    m_tft.startWrite();
+    for (uint32_t row = 0; row < bitmap.rows; row++) {
+        const uint8_t *src = bitmap.buffer + row * bitmap.pitch;
+        uint32_t col = 0;
+        while (col < bitmap.width) {
+            uint32_t start = col;
+            if (src[col] == 0xFF) {
+                while (col < bitmap.width && src[col] == 0xFF) {
+                    col++;
+                }
+                m_tft.drawFastHLine(x + start, y + row, col - start, fg);
+                windows++;
+                pixels += col - start;
+                continue;
+            }
+            if (src[col] != 0) {
+                m_tft.drawPixel(x + col, y + row, Utils::rgb565alphaBlend(src[col], fg, bg));
+                windows++;
+                pixels++;
+            }
+            col++;
+        }
+    }
+    m_tft.endWrite();
+    DrawStats::transaction();
+    DrawStats::write(windows, pixels);
+}
+
+void ScreenManager::drawNumber(uint8_t slot, const char *text, int x, int y, unsigned int fontSize, Align align, uint32_t fgColor, uint32_t bgColor) {
+    if (m_selectedScreen < 0 || m_recordScreen >= 0 || slot >= SCREEN_NUMBER_SLOTS) {
+        // Nothing to compare with, e.g. when drawing on all screens at once, or the display list does it
+        drawString(text, x, y, fontSize, align, fgColor, bgColor);
+        return;
+    }
+    CellText *&number = m_numberSlots[m_selectedScreen][slot];
+    if (number == nullptr) {
+        number = new CellText();
+    }
+    number->setPosition(x, y, fontSize, align);
+    number->draw(*this, text, fgColor, bgColor);
+}
+
+bool ScreenManager::beginRecording() {
+    if (m_selectedScreen < 0) {
+        return false;
+    }
+    if (m_recordList == nullptr) {
+        m_recordList = new DisplayList();
+    }
+    if (m_displayLists[m_selectedScreen] == nullptr) {
+        m_displayLists[m_selectedScreen] = new DisplayList();
+    }
+    m_recordList->clear();
+    m_recordScreen = m_selectedScreen;
+    return true;
+}
+
+void ScreenManager::commitRecording() {
+    if (m_recordScreen < 0) {
+        return;
+    }
+    int screen = m_recordScreen;
+    m_recordScreen = -1;
+    DisplayList *list = m_recordList;
+    DisplayList *previous = m_displayLists[screen];
+    if (list->isOverflowed()) {
+        Log.warningln("Display list of screen %d is full, increase DISPLAY_LIST_ITEMS or DISPLAY_LIST_TEXT", screen);
+    }
+
+    DisplayRect screenRect = {0, 0, m_tft.width(), m_tft.height()};
+    DisplayRect dirty[DISPLAY_LIST_DIRTY_RECTS];
+    uint8_t dirtyCount = list->diff(*previous, screenRect, dirty);
+
+    selectScreen(screen);
+    TTF_Font font = m_curFont;
+    uint32_t *&hashes = m_tileHashes[screen];
+    if (hashes == nullptr && m_tiles.begin()) {
+        hashes = new uint32_t[TILE_COUNT];
+        m_tiles.forget(hashes);
+    }
+    int drawn;
+    if (hashes != nullptr && m_tiles.begin()) {
+        drawn = drawTiles(*list, dirty, dirtyCount, hashes);
+        const TileStats &stats = m_tiles.getStats();
+        Log.traceln("Screen %d: drew %d of %d primitives, pushed %d tiles, skipped %d (%d bytes saved)", screen, drawn, (int) list->getCount(),
+                    (int) stats.lastPushed, (int) stats.lastSkipped, (int) stats.lastSkipped * TILE_SIZE * TILE_SIZE * 2);
+    } else {
+        drawn = drawAreas(*list, dirty, dirtyCount);
+        Log.traceln("Screen %d: drew %d of %d primitives in %d areas", screen, drawn, (int) list->getCount(), (int) dirtyCount);
+    }
+    setFont(font);
+
+    // The recording is what's on screen now, the old list is recorded into next time
+    m_displayLists[screen] = list;
+    m_recordList = previous;
+}
+
+// Repaint each area from the bottom up, clipped to it. Without a filled screen below it's black.
+int ScreenManager::drawAreas(const DisplayList &list, const DisplayRect *dirty, uint8_t dirtyCount) {
+    bool filled = !list.isEmpty() && list.getItem(0).op == DisplayOp::FillScreen;
+    int drawn = 0;
+    for (uint8_t i = 0; i < dirtyCount; i++) {
+        const DisplayRect &rect = dirty[i];
+        m_tft.setViewport(rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top, false);
+        m_clip = rect;
+        m_clipping = true;
+        if (!filled) {
+            m_tft.fillRect(rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top, TFT_BLACK);
+            DrawStats::primitive(1, clippedArea(rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top));
+        }
+        for (uint8_t j = 0; j < list.getCount(); j++) {
+            if (list.getItem(j).bounds.intersects(rect)) {
+                execute(list.getItem(j));
+                drawn++;
+            }
+        }
+        m_tft.resetViewport();
+        m_clipping = false;
+    }
+    return drawn;
+}
+
+// Render the tile rows that touch an area into the band and push the tiles that changed
+int ScreenManager::drawTiles(const DisplayList &list, const DisplayRect *dirty, uint8_t dirtyCount, uint32_t *hashes) {
+    bool filled = !list.isEmpty() && list.getItem(0).op == DisplayOp::FillScreen;
+    int drawn = 0;
+    m_tiles.beginFrame();
+    m_dma.startWrite();
+    for (uint8_t row = 0; row < TILE_ROWS; row++) {
+        DisplayRect band = {0, (int16_t) (row * TILE_SIZE), SCREEN_SIZE, (int16_t) ((row + 1) * TILE_SIZE)};
+        uint32_t columns = 0;
+        for (uint8_t i = 0; i < dirtyCount; i++) {
+            if (dirty[i].intersects(band)) {
+                for (int16_t column = dirty[i].left / TILE_SIZE; column <= (dirty[i].right - 1) / TILE_SIZE; column++) {
+                    columns |= 1UL << column;
+                }
+            }
+        }
+        if (columns == 0) {
+            continue;
+        }
+        band.left = (__builtin_ffs(columns) - 1) * TILE_SIZE;
+        band.right = (32 - __builtin_clz(columns)) * TILE_SIZE;
+
+        // Glyphs go into the band without touching the bus, the last tile may still be in flight
+        TFT_eSprite &sprite = m_tiles.beginBand(row);
+        m_target = &sprite;
+        m_render.set_drawPixel([&sprite](int32_t x, int32_t y, uint16_t c) { sprite.drawPixel(x, y, c); });
+        m_render.set_drawFastHLine([&sprite](int32_t x, int32_t y, int32_t w, uint16_t c) { sprite.drawFastHLine(x, y, w, c); });
+        m_render.set_startWrite([]() {});
+        m_render.set_endWrite([]() {});
+        if (!filled) {
+            sprite.fillRect(0, band.top, SCREEN_SIZE, TILE_SIZE, TFT_BLACK);
+        }
+        for (uint8_t j = 0; j < list.getCount(); j++) {
+            if (list.getItem(j).bounds.intersects(band)) {
+                execute(list.getItem(j));
+                drawn++;
+            }
+        }
+        m_tiles.pushBand(hashes, columns);
+    }
+    m_dma.endWrite();
+    m_target = &m_tft;
+    setScreenDrawer();
+    return drawn;
+}
+
+DisplayItem *ScreenManager::record(DisplayOp op, int32_t x, int32_t y, int32_t w, int32_t h, const char *text) {
+    DisplayRect bounds = {(int16_t) x, (int16_t) y, (int16_t) (x + w), (int16_t) (y + h)};
+    return m_recordList->add(op, bounds, text);
+}
+
+void ScreenManager::execute(const DisplayItem &item) {
+    TFT_eSPI &tft = *m_target;
+    // Primitives rendered into a band are no draw calls, the tiles pushed are counted
+    bool onScreen = &tft == &m_tft;
+    if (onScreen) {
+        DrawStats::drawCall();
+    }
+    switch (item.op) {
+    case DisplayOp::FillScreen:
+        // Not fillScreen(), a band is smaller than the screen
+        tft.fillRect(0, 0, m_tft.width(), m_tft.height(), item.fgColor);
+        if (onScreen) {
+            DrawStats::write(1, clippedArea(0, 0, m_tft.width(), m_tft.height()));
+            DrawStats::transaction();
+        }
+        break;
+    case DisplayOp::FillRect:
+        tft.fillRect(item.x, item.y, item.w, item.h, item.fgColor);
+        if (onScreen) {
+            DrawStats::write(1, clippedArea(item.x, item.y, item.w, item.h));
+            DrawStats::transaction();
+        }
+        break;
+    case DisplayOp::FillCircle:
+        tft.fillCircle(item.x, item.y, item.w, item.fgColor);
+        if (onScreen) {
+            DrawStats::circle(item.w, true);
+        }
+        break;
+    case DisplayOp::String:
+        setFont(item.font);
+        renderString((const char *) item.data, item.x, item.y, item.fontSize, (Align) item.flags, item.fgColor, item.bgColor);
+        break;
+    case DisplayOp::Arc:
+        tft.drawArc(item.x, item.y, item.w, item.h, item.startAngle, item.endAngle, item.fgColor, item.bgColor, item.flags != 0);
+        if (onScreen) {
+            DrawStats::arc(item.w, item.h, item.startAngle, item.endAngle);
+        }
+        break;
+    case DisplayOp::SmoothArc:
+        tft.drawSmoothArc(item.x, item.y, item.w, item.h, item.startAngle, item.endAngle, item.fgColor, item.bgColor, item.flags != 0);
+        if (onScreen) {
+            DrawStats::arc(item.w, item.h, item.startAngle, item.endAngle);
+        }
+        break;
+    case DisplayOp::Jpg:
+        TJpgDec.setJpgScale(item.flags);
+        m_imageColor = item.fgColor;
+        decodeJpg(item.x, item.y, item.data, item.size, nullptr);
+        m_imageColor = 0;
+        break;
+    }
+}
+
+void ScreenManager::traceString(const char *text, int x, int y, unsigned int fontSize, Align align, GlyphSink sink) {
+    fontSize = getScaledFontSize(fontSize);
+    FT_BBox box = m_render.calculateBoundingBox(0, 0, fontSize, Align::TopLeft, Layout::Horizontal, text);
+    m_render.setAlignment(align);
+    m_render.setFontSize(fontSize);
+    m_render.set_glyphSink(sink);
+    m_render.drawString(text, x, y - box.yMin, m_render.getFontColor(), m_render.getBackgroundColor());
+    m_render.set_glyphSink(nullptr);
+}
+
+void ScreenManager::drawAlphaRuns(const AlphaRun *runs, size_t count, int32_t x, int32_t y, uint32_t fgColor, uint32_t bgColor, uint8_t quarterTurns) {
+    uint16_t fg = dim(fgColor);
+    uint16_t bg = dim(bgColor);
+    uint32_t pixels = 0;
+    m_tft.startWrite();
+    for (size_t i = 0; i < count; i++) {
+        const AlphaRun &run = runs[i];
+        pixels += run.length;
+        uint16_t color = run.alpha == 0xFF ? fg : Utils::rgb565alphaBlend(run.alpha, fg, bg);
+        // (dx, dy) turns into (-dy, dx) per quarter turn, so odd turns make the runs vertical
+        switch (quarterTurns & 3) {
+        case 0:
+            m_tft.drawFastHLine(x + run.x, y + run.y, run.length, color);
+            break;
+        case 1:
+            m_tft.drawFastVLine(x - run.y, y + run.x, run.length, color);
+            break;
+        case 2:
+            m_tft.drawFastHLine(x - run.x - run.length + 1, y - run.y, run.length, color);
+            break;
+        case 3:
+            m_tft.drawFastVLine(x + run.y, y - run.x - run.length + 1, run.length, color);
+            break;
+        }
+    }
+    m_tft.endWrite();
+    DrawStats::primitive(count, pixels);
+}
+
+void ScreenManager::drawCentreString(const char *text, int x, int y, unsigned int fontSize) {
     drawString(text, x, y, fontSize, Align::MiddleCenter);
 }
 
+void ScreenManager::drawCentreString(const String &text, int x, int y, unsigned int fontSize) {
+    drawString(text.c_str(), x, y, fontSize, Align::MiddleCenter);
+}
+
 void ScreenManager::drawFittedString(const String &text, int x, int y, int limit_w, int limit_h, Align align) {
     unsigned int fontSize = calculateFitFontSize(limit_w, limit_h, Layout::Horizontal, text);
     drawString(text, x, y, fontSize, align, -1, -1, false);
@@ -240,45 +684,225 @@ void ScreenManager::drawFittedString(const String &text, int x, int y, int limit
     drawFittedString(text, x, y, limit_w, limit_h, m_render.getAlignment());
 }
 
+int ScreenManager::wrapText(const char *text, unsigned int fontSize, int y, int lineHeight, TextLine *lines, int maxLines, int maxWidth) {
+    fontSize = getScaledFontSize(fontSize);
+    m_render.setFontSize(fontSize);
+    return wrap(text, ((uint32_t) m_curFont << 16) | fontSize, y, lineHeight, lines, maxLines, maxWidth);
+}
+
+int ScreenManager::wrapLegacyText(const char *text, uint8_t font, int y, int lineHeight, TextLine *lines, int maxLines, int maxWidth) {
+    return wrap(text, 0x80000000 | (font << 8) | m_tft.textsize, y, lineHeight, lines, maxLines, maxWidth);
+}
+
+void ScreenManager::drawWrappedText(const char *text, const TextLine *lines, int count, int x, int y, int lineHeight, unsigned int fontSize) {
+    for (int i = 0; i < count; i++) {
+        drawString(FrameString(text + lines[i].start, lines[i].length), x, y + i * lineHeight, fontSize, Align::MiddleCenter);
+    }
+}
+
+void ScreenManager::drawWrappedLegacyText(const char *text, const TextLine *lines, int count, int x, int y, int lineHeight, uint8_t font) {
+    for (int i = 0; i < count; i++) {
+        drawLegacyString(FrameString(text + lines[i].start, lines[i].length), x, y + i * lineHeight, font);
+    }
+}
+
+int ScreenManager::wrap(const char *text, uint32_t key, int y, int lineHeight, TextLine *lines, int maxLines, int maxWidth) {
+    if (key != m_advancesKey) {
+        memset(m_advances, 0xFF, sizeof(m_advances));
+        m_advancesKey = key;
+        m_pairWidth = 0;
+    }
+    const int radius = ScreenWidth / 2;
+    int count = 0;
+    const char *p = text;
+    while (*p != '\0' && count < maxLines) {
+        // Widest chord of the orb over the height of this line
+        int lineY = y + count * lineHeight;
+        int dy = max(abs(lineY - lineHeight / 2 - radius), abs(lineY + lineHeight / 2 - radius));
+        int limit = dy < radius ? 2 * sqrt(radius * radius - dy * dy) - 2 * TEXT_WRAP_MARGIN : 0;
+        if (maxWidth > 0 && maxWidth < limit) {
+            limit = maxWidth;
+        }
+        if (limit <= 0) {
+            break;
+        }
+        while (*p == ' ') {
+            p++;
+        }
+        const char *start = p;
+        const char *lastSpace = nullptr;
+        int width = 0;
+        while (*p != '\0' && *p != '\n') {
+            if (*p == ' ') {
+                lastSpace = p;
+            }
+            uint8_t bytes = 1;
+            while (bytes < 4 && (p[bytes] & 0xC0) == 0x80) {
+                bytes++;
+            }
+            width += getAdvance(p, bytes, key);
+            if (width > limit && p > start) {
+                break;
+            }
+            p += bytes;
+        }
+        const char *end = p;
+        if (*p == '\n') {
+            p++;
+        } else if (*p != '\0' && lastSpace != nullptr) {
+            // Break at the last space, otherwise the word is too long for a line and gets split
+            end = lastSpace;
+            p = lastSpace + 1;
+        }
+        while (end > start && end[-1] == ' ') {
+            end--;
+        }
+        lines[count].start = start - text;
+        lines[count].length = end - start;
+        count++;
+    }
+    return count;
+}
+
+uint16_t ScreenManager::getAdvance(const char *glyph, uint8_t bytes, uint32_t key) {
+    if (bytes > 1 || *glyph < ' ' || *glyph > '~') {
+        return measureAdvance(glyph, bytes, key);
+    }
+    uint8_t &advance = m_advances[*glyph - ' '];
+    if (advance == 0xFF) {
+        advance = min(measureAdvance(glyph, bytes, key), (uint16_t) 0xFE);
+    }
+    return advance;
+}
+
+uint16_t ScreenManager::measureAdvance(const char *glyph, uint8_t bytes, uint32_t key) {
+    char str[4 + 1] = {0};
+    memcpy(str, glyph, bytes);
+    if (key & 0x80000000) {
+        // Legacy fonts are fixed bitmaps, the width is the advance
+        return m_tft.textWidth(str, (key >> 8) & 0xFF);
+    }
+    // The bounding box includes the side bearings, measure between two reference glyphs instead
+    char framed[4 + 3] = {'x'};
+    memcpy(framed + 1, glyph, bytes);
+    framed[bytes + 1] = 'x';
+    if (m_pairWidth == 0) {
+        m_pairWidth = m_render.getTextWidth("xx");
+    }
+    uint32_t width = m_render.getTextWidth("%s", framed);
+    return width > m_pairWidth ? width - m_pairWidth : 0;
+}
+
 void ScreenManager::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
     m_tft.drawRect(x, y, w, h, dim(color));
+    DrawStats::primitive(4, 2 * (w + h));
 }
 
 void ScreenManager::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    if (m_recordScreen >= 0) {
+        DisplayItem *item = record(DisplayOp::FillRect, x, y, w, h);
+        if (item != nullptr) {
+            item->x = x;
+            item->y = y;
+            item->w = w;
+            item->h = h;
+            item->fgColor = dim(color);
+            m_recordList->seal(*item);
+        }
+        return;
+    }
     m_tft.fillRect(x, y, w, h, dim(color));
+    DrawStats::primitive(1, clippedArea(x, y, w, h));
 }
 
 void ScreenManager::drawLine(int32_t xs, int32_t ys, int32_t xe, int32_t ye, uint32_t color) {
     m_tft.drawLine(xs, ys, xe, ye, dim(color));
+    DrawStats::line(xe - xs, ye - ys);
 }
 
 void ScreenManager::drawArc(int32_t x, int32_t y, int32_t r, int32_t ir, uint32_t startAngle, uint32_t endAngle, uint32_t fg_color, uint32_t bg_color, bool smoothArc) {
+    if (m_recordScreen >= 0) {
+        DisplayItem *item = record(DisplayOp::Arc, x - r, y - r, 2 * r + 1, 2 * r + 1);
+        if (item != nullptr) {
+            item->x = x;
+            item->y = y;
+            item->w = r;
+            item->h = ir;
+            item->startAngle = startAngle;
+            item->endAngle = endAngle;
+            item->flags = smoothArc;
+            item->fgColor = dim(fg_color);
+            item->bgColor = dim(bg_color);
+            m_recordList->seal(*item);
+        }
+        return;
+    }
     m_tft.drawArc(x, y, r, ir, startAngle, endAngle, dim(fg_color), dim(bg_color), smoothArc);
+    DrawStats::arc(r, ir, startAngle, endAngle);
 }
 
 void ScreenManager::drawSmoothArc(int32_t x, int32_t y, int32_t r, int32_t ir, uint32_t startAngle, uint32_t endAngle, uint32_t fg_color, uint32_t bg_color, bool roundEnds) {
+    if (m_recordScreen >= 0) {
+        DisplayItem *item = record(DisplayOp::SmoothArc, x - r, y - r, 2 * r + 1, 2 * r + 1);
+        if (item != nullptr) {
+            item->x = x;
+            item->y = y;
+            item->w = r;
+            item->h = ir;
+            item->startAngle = startAngle;
+            item->endAngle = endAngle;
+            item->flags = roundEnds;
+            item->fgColor = dim(fg_color);
+            item->bgColor = dim(bg_color);
+            m_recordList->seal(*item);
+        }
+        return;
+    }
     m_tft.drawSmoothArc(x, y, r, ir, startAngle, endAngle, dim(fg_color), dim(bg_color), roundEnds);
+    DrawStats::arc(r, ir, startAngle, endAngle);
 }
 
 void ScreenManager::drawTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, uint32_t color) {
     m_tft.drawTriangle(x1, y1, x2, y2, x3, y3, dim(color));
+    DrawStats::line(x2 - x1, y2 - y1);
+    DrawStats::line(x3 - x2, y3 - y2);
+    DrawStats::line(x1 - x3, y1 - y3);
 }
 
 void ScreenManager::fillTriangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3, uint32_t color) {
     m_tft.fillTriangle(x1, y1, x2, y2, x3, y3, dim(color));
+    // A line per row
+    DrawStats::primitive(max(y1, max(y2, y3)) - min(y1, min(y2, y3)) + 1, abs((x2 - x1) * (y3 - y1) - (x3 - x1) * (y2 - y1)) / 2);
 }
 
 void ScreenManager::drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color) {
     m_tft.drawCircle(x, y, r, dim(color));
+    DrawStats::circle(r, false);
 }
 
 void ScreenManager::fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color) {
+    if (m_recordScreen >= 0) {
+        DisplayItem *item = record(DisplayOp::FillCircle, x - r, y - r, 2 * r + 1, 2 * r + 1);
+        if (item != nullptr) {
+            item->x = x;
+            item->y = y;
+            item->w = r;
+            item->fgColor = dim(color);
+            m_recordList->seal(*item);
+        }
+        return;
+    }
     m_tft.fillCircle(x, y, r, dim(color));
+    DrawStats::circle(r, true);
 }
 
 unsigned int ScreenManager::getScaledFontSize(unsigned int fontSize) {
+    return getScaledFontSize(fontSize, m_curFont);
+}
+
+unsigned int ScreenManager::getScaledFontSize(unsigned int fontSize, TTF_Font font) {
     for (TTF_FontMetric metric : ttfFontMetrics) {
-        if (metric.font == m_curFont) {
+        if (metric.font == font) {
             return round(metric.scale * fontSize);
         }
     }
@@ -315,15 +939,24 @@ void ScreenManager::setLegacyTextFont(uint8_t font) {
 }
 
 void ScreenManager::drawLegacyString(const String &string, int32_t x, int32_t y) {
-    m_tft.drawString(string, x, y);
+    int16_t width = m_tft.drawString(string, x, y);
+    DrawStats::primitive(string.length(), width * m_tft.fontHeight());
 }
 
 void ScreenManager::drawLegacyString(const String &string, int32_t x, int32_t y, uint8_t font) {
-    m_tft.drawString(string, x, y, font);
+    drawLegacyString(string.c_str(), x, y, font);
+}
+
+void ScreenManager::drawLegacyString(const char *string, int32_t x, int32_t y, uint8_t font) {
+    int16_t width = m_tft.drawString(string, x, y, font);
+    // Estimated as a window per character
+    DrawStats::primitive(strlen(string), width * m_tft.fontHeight(font));
 }
 
 int16_t ScreenManager::drawLegacyChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font) {
-    return m_tft.drawChar(uniCode, x, y, font);
+    int16_t width = m_tft.drawChar(uniCode, x, y, font);
+    DrawStats::primitive(1, width * m_tft.fontHeight(font));
+    return width;
 }
 
 int16_t ScreenManager::width() {
@@ -358,9 +991,12 @@ void ScreenManager::setTextSize(uint8_t s) {
 
 void ScreenManager::print(String s) {
     m_tft.print(s);
+    DrawStats::primitive(s.length(), m_tft.textWidth(s) * m_tft.fontHeight());
 }
 void ScreenManager::print(char c) {
     m_tft.print(c);
+    char str[2] = {c, '\0'};
+    DrawStats::primitive(1, m_tft.textWidth(str) * m_tft.fontHeight());
 }
 
 // Static function to be used in TJpgDec callback
@@ -371,7 +1007,8 @@ bool ScreenManager::tftOutput(int16_t x, int16_t y, uint16_t w, uint16_t h, uint
     }
     uint8_t brightness = instance->getBrightness();
     uint32_t imageColor = instance->m_imageColor;
-    TFT_eSPI &tft = instance->getDisplay();
+    // The screen or the band of the tile cache
+    TFT_eSPI &tft = *instance->m_target;
     if (y >= tft.height() || x >= tft.width())
         return 0;
     if (imageColor != 0) {
@@ -382,31 +1019,72 @@ bool ScreenManager::tftOutput(int16_t x, int16_t y, uint16_t w, uint16_t h, uint
         // Dim bitmap
         Utils::rgb565dimBitmap(bitmap, w * h, brightness, true);
     }
-    tft.pushImage(x, y, w, h, bitmap);
+    if (&tft == &instance->m_tft) {
+        // Sent while the next block is decoded
+        instance->m_dma.push(x, y, w, h, bitmap, w);
+    } else {
+        tft.pushImage(x, y, w, h, bitmap);
+    }
     return true;
 }
 
 JRESULT ScreenManager::drawJpg(int32_t x, int32_t y, const uint8_t jpeg_data[], uint32_t data_size, uint8_t scale, uint32_t imageColor) {
+    if (m_recordScreen >= 0) {
+        uint16_t w = 0, h = 0;
+        JRESULT result = TJpgDec.getJpgSize(&w, &h, jpeg_data, data_size);
+        if (result != JDR_OK) {
+            return result;
+        }
+        scale = max(scale, (uint8_t) 1);
+        DisplayItem *item = record(DisplayOp::Jpg, x, y, (w + scale - 1) / scale, (h + scale - 1) / scale);
+        if (item != nullptr) {
+            item->x = x;
+            item->y = y;
+            item->flags = scale;
+            item->fgColor = imageColor;
+            // Images are dimmed while they are drawn
+            item->bgColor = m_brightness;
+            item->data = jpeg_data;
+            item->size = data_size;
+            m_recordList->seal(*item);
+        }
+        return JDR_OK;
+    }
+    DrawStats::drawCall();
     // Set scale
     TJpgDec.setJpgScale(scale);
     // Set image color
     m_imageColor = imageColor;
-    JRESULT result = TJpgDec.drawJpg(x, y, jpeg_data, data_size);
+    JRESULT result = decodeJpg(x, y, jpeg_data, data_size, nullptr);
     // Reset image color
     m_imageColor = 0;
     return result;
 }
 
 JRESULT ScreenManager::drawFsJpg(int32_t x, int32_t y, const char *filename, uint8_t scale, uint32_t imageColor) {
+    DrawStats::drawCall();
     // Set scale
     TJpgDec.setJpgScale(scale);
     // Set image color
     m_imageColor = imageColor;
-    JRESULT result = TJpgDec.drawFsJpg(x, y, filename, LittleFS);
+    JRESULT result = decodeJpg(x, y, nullptr, 0, filename);
     // Reset image color
     m_imageColor = 0;
     return result;
 }
+
+// Decode from memory or a file, on the screen each block is sent while the next one is decoded
+JRESULT ScreenManager::decodeJpg(int32_t x, int32_t y, const uint8_t jpeg_data[], uint32_t data_size, const char *filename) {
+    bool onScreen = m_target == &m_tft;
+    if (onScreen) {
+        m_dma.startWrite();
+    }
+    JRESULT result = filename != nullptr ? TJpgDec.drawFsJpg(x, y, filename, LittleFS) : TJpgDec.drawJpg(x, y, jpeg_data, data_size);
+    if (onScreen) {
+        m_dma.endWrite();
+    }
+    return result;
+}
 uint16_t ScreenManager::color565FromHex(const String &hex) {
     if (hex.length() != 7 || hex[0] != '#') {
         return TFT_WHITE; // Default color if invalid format
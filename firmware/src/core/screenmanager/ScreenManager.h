@@ -2,6 +2,10 @@
 #define SCREENMANAGER_H
 
 // Include any necessary libraries here
+#include "DisplayList.h"
+#include "DmaWriter.h"
+#include "GlyphAtlas.h"
+#include "TileCache.h"
 #include "config_helper.h"
 #include "ttf-fonts.h"
 #include <OpenFontRender.h>
@@ -10,6 +14,9 @@
 #include <TJpg_Decoder.h>
 
 #define NUM_SCREENS 5
+// Screen masks for selectScreens()
+#define SCREEN_MASK(screen) (1 << (screen))
+#define ALL_SCREENS ((1 << NUM_SCREENS) - 1)
 
 #ifndef DEFAULT_FONT
     #define DEFAULT_FONT ROBOTO_REGULAR
@@ -19,11 +26,49 @@
     #define TFT_BRIGHTNESS 255
 #endif
 
+#ifndef SCREEN_NUMBER_SLOTS
+    #define SCREEN_NUMBER_SLOTS 4 // Numbers per screen that drawNumber() keeps track of
+#endif
+
+#ifndef TEXT_WRAP_MARGIN
+    #define TEXT_WRAP_MARGIN 8 // Min. distance of wrapped text to the edge of the orb in px
+#endif
+
+// A line of wrapped text, as a byte range of the source string
+struct TextLine {
+    uint16_t start;
+    uint16_t length;
+};
+
+// Pixels of equal glyph coverage in a row, relative to an origin
+struct AlphaRun {
+    uint8_t x;
+    uint8_t y;
+    uint8_t length;
+    uint8_t alpha;
+};
+
+// Placement of a single glyph relative to its origin (left end of the baseline), in pixels
+struct GlyphMetrics {
+    int16_t left;
+    int16_t top;
+    uint16_t width;
+    uint16_t height;
+    int16_t advance;
+};
+
+class CellText;
+
+// Receives a rendered glyph and the screen position of its top left pixel
+using GlyphSink = std::function<void(FT_BitmapGlyph, int32_t, int32_t)>;
+
 class ScreenManager {
 public:
     ScreenManager(TFT_eSPI &tft);
 
     void selectScreen(int screen);
+    // Draw calls go to all screens in the mask at once, e.g. to clear them or draw the same frame on each
+    void selectScreens(uint8_t screens);
     void selectAllScreens();
     void reset();
 
@@ -37,20 +82,56 @@ public:
 
     // Set TTF parameters for next drawString()
     void setFont(TTF_Font font);
+    TTF_Font getFont() const { return m_curFont; }
     void setFontColor(uint32_t color);
     void setFontColor(uint32_t color, uint32_t background);
     void setBackgroundColor(uint32_t color);
     void setFontSize(uint32_t size);
     void setAlignment(Align align);
+    // Keep the digits and signs of font at fontSize (as passed to drawString) pre-rasterized
+    bool addToGlyphAtlas(TTF_Font font, unsigned int fontSize, bool applyScale = true);
 
     // Helper functions
     unsigned int calculateFitFontSize(uint32_t limit_width, uint32_t limit_height, Layout layout, const String &text);
 
+    // Wrap text at spaces and newlines by the measured width of the current font. Line i is
+    // centred on y + i * lineHeight and has to fit into maxWidth (0 = no limit) and the round
+    // orb at that height. Fills lines and returns their count, text beyond maxLines is dropped.
+    int wrapText(const char *text, unsigned int fontSize, int y, int lineHeight, TextLine *lines, int maxLines, int maxWidth = 0);
+    int wrapLegacyText(const char *text, uint8_t font, int y, int lineHeight, TextLine *lines, int maxLines, int maxWidth = 0);
+    // Draw the result of wrapText() / wrapLegacyText(), centred on x
+    void drawWrappedText(const char *text, const TextLine *lines, int count, int x, int y, int lineHeight, unsigned int fontSize);
+    void drawWrappedLegacyText(const char *text, const TextLine *lines, int count, int x, int y, int lineHeight, uint8_t font);
+
     // Draw string functions
+    void drawString(const char *text, int x, int y, unsigned int fontSize, Align align, int32_t fgColor = -1, int32_t bgColor = -1, bool applyScale = true);
     void drawString(const String &text, int x, int y, unsigned int fontSize, Align align, int32_t fgColor = -1, int32_t bgColor = -1, bool applyScale = true);
+    void drawString(const char *text, int x, int y);
     void drawString(const String &text, int x, int y);
+    // Single glyphs of the current font, for callers that do their own layout (e.g. CellText)
+    bool getGlyphMetrics(uint16_t unicode, unsigned int fontSize, GlyphMetrics &metrics);
+    void drawGlyph(uint16_t unicode, int x, int y, unsigned int fontSize, uint32_t fgColor, uint32_t bgColor);
+    // Text that changes in place (prices, temperatures) in a tabular layout, y is the middle of the digits.
+    // Only the cells that differ from what slot last showed on the selected screen are cleared and drawn,
+    // filling the screen resets its slots.
+    void drawNumber(uint8_t slot, const char *text, int x, int y, unsigned int fontSize, Align align, uint32_t fgColor, uint32_t bgColor);
+    // Retained mode for the selected screen: until commitRecording(), fillScreen(), fillRect(), fillCircle(), drawString(),
+    // drawArc(), drawSmoothArc() and drawJpg() are recorded instead of drawn (other calls still draw right away).
+    // Committing compares the recording with the last one and repaints only the areas of primitives that were added,
+    // changed or removed. Image data has to stay valid until the commit. Filling the screen otherwise starts over.
+    // With the tile cache, areas are rendered in bands of 16px and only the 16x16 tiles that changed are pushed.
+    bool beginRecording();
+    void commitRecording();
+    const TileStats &getTileStats() const { return m_tiles.getStats(); }
+    // Image blocks and tiles are sent with DMA, see DmaWriter for bus utilization and CPU idle
+    const DmaWriter &getDma() const { return m_dma; }
+    // Lay out and rasterize text exactly like drawString() (without the glyph atlas), but hand the glyphs to sink instead of the screen
+    void traceString(const char *text, int x, int y, unsigned int fontSize, Align align, GlyphSink sink);
+    // Draw coverage runs at x/y with the blending of drawString(), turned clockwise around x/y by quarterTurns * 90°
+    void drawAlphaRuns(const AlphaRun *runs, size_t count, int32_t x, int32_t y, uint32_t fgColor, uint32_t bgColor, uint8_t quarterTurns = 0);
 
     // Draw centered string
+    void drawCentreString(const char *text, int x, int y, unsigned int fontSize = 0);
     void drawCentreString(const String &text, int x, int y, unsigned int fontSize = 0);
 
     // Draw string with a max width/height (auto-sizing)
@@ -77,6 +158,7 @@ public:
     void setLegacyTextFont(uint8_t font);
     void drawLegacyString(const String &string, int32_t x, int32_t y);
     void drawLegacyString(const String &string, int32_t x, int32_t y, uint8_t font);
+    void drawLegacyString(const char *string, int32_t x, int32_t y, uint8_t font);
     int16_t drawLegacyChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font);
 
     // Image functions
@@ -112,15 +194,59 @@ private:
 
     uint8_t m_screen_cs[5] = {SCREEN_1_CS, SCREEN_2_CS, SCREEN_3_CS, SCREEN_4_CS, SCREEN_5_CS};
     TFT_eSPI &m_tft;
+    TFT_eSPI *m_target; // Where display list primitives are drawn to
     OpenFontRender m_render;
+    GlyphAtlas m_atlas;
+    DmaWriter m_dma;
+    TileCache m_tiles;
     TTF_Font m_curFont = TTF_Font::NONE;
+    int m_selectedScreen = -1; // -1 for none or several
+    uint8_t m_selectedScreens = 0;
+    // Chip select of each screen (in the order of the orb rotation) as bit in the GPIO banks for pins 0-31 and 32-39
+    uint32_t m_csBits[NUM_SCREENS][2];
+    CellText *m_numberSlots[NUM_SCREENS][SCREEN_NUMBER_SLOTS] = {};
+    // What retained mode last drew on each screen and the list being recorded for m_recordScreen (-1 = not recording)
+    DisplayList *m_displayLists[NUM_SCREENS] = {};
+    DisplayList *m_recordList = nullptr;
+    int m_recordScreen = -1;
+    // Tile hashes of the screens that were committed with the tile cache
+    uint32_t *m_tileHashes[NUM_SCREENS] = {};
     uint8_t m_brightness = TFT_BRIGHTNESS;
     uint32_t m_imageColor = 0;
 
+    // Area drawAreas() repaints, TFT_eSPI's viewport getters don't report it when it's set without datum
+    DisplayRect m_clip = {};
+    bool m_clipping = false;
+
+    // Traffic of OpenFontRender's hooks, added to DrawStats once per string instead of per pixel
+    uint32_t m_renderTransactions = 0;
+    uint32_t m_renderWindows = 0;
+    uint32_t m_renderPixels = 0;
+
+    // Advances of the printable ASCII characters for the font and size last wrapped with
+    uint8_t m_advances[95];
+    uint32_t m_advancesKey = 0;
+    uint32_t m_pairWidth = 0;
+
     TFT_eSPI &getDisplay();
     OpenFontRender &getRender();
+    void setScreenDrawer();
+    void flushRenderStats();
+    uint32_t clippedArea(int32_t x, int32_t y, int32_t w, int32_t h);
     unsigned int getScaledFontSize(unsigned int fontSize);
+    unsigned int getScaledFontSize(unsigned int fontSize, TTF_Font font);
+    int wrap(const char *text, uint32_t key, int y, int lineHeight, TextLine *lines, int maxLines, int maxWidth);
+    uint16_t getAdvance(const char *glyph, uint8_t bytes, uint32_t key);
+    uint16_t measureAdvance(const char *glyph, uint8_t bytes, uint32_t key);
     uint16_t dim(uint16_t color);
+    void cacheChipSelects();
+    void invalidateScreens(uint8_t screens);
+    DisplayItem *record(DisplayOp op, int32_t x, int32_t y, int32_t w, int32_t h, const char *text = nullptr);
+    int drawAreas(const DisplayList &list, const DisplayRect *dirty, uint8_t dirtyCount);
+    int drawTiles(const DisplayList &list, const DisplayRect *dirty, uint8_t dirtyCount, uint32_t *hashes);
+    void execute(const DisplayItem &item);
+    JRESULT decodeJpg(int32_t x, int32_t y, const uint8_t jpeg_data[], uint32_t data_size, const char *filename);
+    void renderString(const char *text, int x, int y, unsigned int fontSize, Align align, uint16_t fgColor, uint16_t bgColor);
 
 #ifndef MIRROR_DISPLAY
     #define MIRROR_DISPLAY false
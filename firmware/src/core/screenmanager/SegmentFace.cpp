@@ -0,0 +1,191 @@
+#include "SegmentFace.h"
+#include <ArduinoLog.h>
+#include <algorithm>
+#include <vector>
+
+SegmentFace::~SegmentFace() {
+    free(m_runs);
+}
+
+bool SegmentFace::build(ScreenManager &manager, const char *fill, int x, int y, unsigned int fontSize, Align align, const SegmentSymbol *symbols, uint8_t count) {
+    m_state = BuildState::Failed;
+    if (count > SEGMENT_FACE_MAX_SYMBOLS) {
+        return false;
+    }
+
+    // The full glyph as runs of equal coverage, rows are indexed for the lookups below
+    std::vector<AlphaRun> runs;
+    std::vector<uint16_t> rowStart;
+    int glyphs = 0;
+    manager.traceString(fill, x, y, fontSize, align, [&](FT_BitmapGlyph glyph, int32_t left, int32_t top) {
+        const FT_Bitmap &bitmap = glyph->bitmap;
+        if (++glyphs > 1 || bitmap.width > 255 || bitmap.rows > 255) {
+            return;
+        }
+        m_originX = left;
+        m_originY = top;
+        rowStart.assign(bitmap.rows + 1, 0);
+        for (uint32_t row = 0; row < bitmap.rows; row++) {
+            rowStart[row] = runs.size();
+            const uint8_t *src = bitmap.buffer + row * bitmap.pitch;
+            for (uint32_t col = 0; col < bitmap.width; col++) {
+                if (src[col] == 0) {
+                    continue;
+                }
+                if (runs.size() > rowStart[row] && runs.back().x + runs.back().length == col && runs.back().alpha == src[col]) {
+                    runs.back().length++;
+                } else {
+                    runs.push_back({(uint8_t) col, (uint8_t) row, 1, src[col]});
+                }
+            }
+        }
+        rowStart[bitmap.rows] = runs.size();
+    });
+    if (glyphs != 1 || runs.empty() || runs.size() > UINT16_MAX) {
+        Log.warningln("Segment face '%s' can't be built, drawn as text", fill);
+        return false;
+    }
+
+    // A symbol belongs to the face if each of its pixels has the coverage of the full glyph
+    // and it covers runs completely, the runs it covers are its lit segments
+    int32_t height = rowStart.size() - 1;
+    std::vector<uint16_t> litBy(runs.size(), 0);
+    std::vector<uint8_t> hits(runs.size(), 0);
+    m_symbolCount = count;
+    m_usable = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        m_symbols[i] = symbols[i].symbol;
+        char text[2] = {symbols[i].symbol, '\0'};
+        bool aligned = true;
+        manager.traceString(text, symbols[i].x, symbols[i].y, fontSize, align, [&](FT_BitmapGlyph glyph, int32_t left, int32_t top) {
+            const FT_Bitmap &bitmap = glyph->bitmap;
+            for (uint32_t row = 0; row < bitmap.rows && aligned; row++) {
+                int32_t faceY = top + row - m_originY;
+                const uint8_t *src = bitmap.buffer + row * bitmap.pitch;
+                for (uint32_t col = 0; col < bitmap.width && aligned; col++) {
+                    if (src[col] == 0) {
+                        continue;
+                    }
+                    int32_t faceX = left + col - m_originX;
+                    aligned = false;
+                    if (faceY < 0 || faceY >= height) {
+                        break;
+                    }
+                    for (uint16_t r = rowStart[faceY]; r < rowStart[faceY + 1]; r++) {
+                        if (faceX >= runs[r].x && faceX < runs[r].x + runs[r].length) {
+                            aligned = runs[r].alpha == src[col];
+                            hits[r]++;
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+        for (size_t r = 0; r < runs.size(); r++) {
+            if (hits[r] == runs[r].length) {
+                litBy[r] |= 1 << i;
+            } else if (hits[r] != 0) {
+                aligned = false;
+            }
+            hits[r] = 0;
+        }
+        if (aligned) {
+            m_usable |= 1 << i;
+        } else {
+            Log.infoln("Segment face '%s': '%c' doesn't line up, drawn as text", fill, symbols[i].symbol);
+            for (size_t r = 0; r < runs.size(); r++) {
+                litBy[r] &= ~(1 << i);
+            }
+        }
+    }
+
+    // Group the runs into segments of the same symbols
+    std::vector<uint16_t> order(runs.size());
+    for (size_t r = 0; r < order.size(); r++) {
+        order[r] = r;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint16_t a, uint16_t b) { return litBy[a] < litBy[b]; });
+    m_segmentCount = 0;
+    for (size_t r = 0; r < order.size(); r++) {
+        if (r == 0 || litBy[order[r]] != litBy[order[r - 1]]) {
+            if (m_segmentCount == SEGMENT_FACE_MAX_SEGMENTS) {
+                Log.warningln("Segment face '%s' has more than %d segments, drawn as text", fill, SEGMENT_FACE_MAX_SEGMENTS);
+                return false;
+            }
+            m_segments[m_segmentCount++] = {litBy[order[r]], (uint16_t) r, 0};
+        }
+        m_segments[m_segmentCount - 1].count++;
+    }
+    m_runs = (AlphaRun *) malloc(runs.size() * sizeof(AlphaRun));
+    if (m_runs == nullptr) {
+        return false;
+    }
+    for (size_t r = 0; r < order.size(); r++) {
+        m_runs[r] = runs[order[r]];
+    }
+    m_runCount = runs.size();
+    m_state = BuildState::Ready;
+    Log.infoln("Segment face '%s' at %dpx: %d segments, %d runs, %d bytes", fill, (int) fontSize, (int) m_segmentCount, (int) m_runCount, (int) (m_runCount * sizeof(AlphaRun)));
+    return true;
+}
+
+bool SegmentFace::draw(ScreenManager &manager, int screen, char lastSymbol, char symbol, uint32_t color, uint32_t shadowColor, bool shadowing) {
+    ScreenState &state = m_screens[screen];
+    int8_t index = indexOf(symbol);
+    int8_t lastIndex = indexOf(lastSymbol);
+    if (m_state != BuildState::Ready || index < 0 || (lastSymbol != '\0' && lastIndex < 0)) {
+        state.valid = false;
+        return false;
+    }
+    uint16_t bit = 1 << index;
+    uint16_t lastBit = lastIndex >= 0 ? 1 << lastIndex : 0;
+    // Segments that already show the right color are skipped if we drew lastSymbol the same way
+    bool unchanged = state.valid && state.symbol == lastSymbol && state.shadowing == shadowing && state.color == color && state.shadowColor == shadowColor;
+    for (uint8_t i = 0; i < m_segmentCount; i++) {
+        const Segment &segment = m_segments[i];
+        bool lit = segment.symbols & bit;
+        bool wasLit = segment.symbols & lastBit;
+        uint32_t segmentColor;
+        if (lit) {
+            if (unchanged && wasLit) {
+                continue;
+            }
+            segmentColor = color;
+        } else if (shadowing) {
+            if (unchanged && !wasLit) {
+                continue;
+            }
+            segmentColor = shadowColor;
+        } else if (wasLit) {
+            segmentColor = TFT_BLACK;
+        } else {
+            continue;
+        }
+        manager.drawAlphaRuns(m_runs + segment.first, segment.count, m_originX, m_originY, segmentColor, TFT_BLACK);
+    }
+    state.valid = true;
+    state.symbol = symbol;
+    state.shadowing = shadowing;
+    state.color = color;
+    state.shadowColor = shadowColor;
+    return true;
+}
+
+void SegmentFace::invalidate() {
+    for (int i = 0; i < NUM_SCREENS; i++) {
+        invalidate(i);
+    }
+}
+
+void SegmentFace::invalidate(int screen) {
+    m_screens[screen].valid = false;
+}
+
+int8_t SegmentFace::indexOf(char symbol) const {
+    for (uint8_t i = 0; i < m_symbolCount; i++) {
+        if (m_symbols[i] == symbol) {
+            return (m_usable & (1 << i)) ? i : -1;
+        }
+    }
+    return -1;
+}
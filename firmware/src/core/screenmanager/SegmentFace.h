@@ -0,0 +1,77 @@
+#ifndef SEGMENT_FACE_H
+#define SEGMENT_FACE_H
+
+#include "ScreenManager.h"
+
+#ifndef SEGMENT_FACE_MAX_SEGMENTS
+    #define SEGMENT_FACE_MAX_SEGMENTS 24 // Pixel groups a face may split into (7 for clean seven-segment glyphs)
+#endif
+
+// Symbols per face, they are tracked as bits of a uint16_t
+#define SEGMENT_FACE_MAX_SYMBOLS 16
+
+// A character of a segment face and where drawString() would draw it
+struct SegmentSymbol {
+    char symbol;
+    int16_t x;
+    int16_t y;
+};
+
+/**
+ * Draws the characters of a segment font (like DSEG7) as the set of segments they light. The
+ * glyph with every segment lit (e.g. "8") is rasterized once and its pixels are grouped by
+ * which symbols cover them, so changing the shown symbol only repaints the segments that
+ * toggle, with the coverage and blending drawString() would use. A symbol whose pixels don't
+ * line up exactly with the full glyph is not part of the face and left to drawString().
+ */
+class SegmentFace {
+public:
+    ~SegmentFace();
+
+    // Rasterize the face with the current font, only attempted once
+    bool build(ScreenManager &manager, const char *fill, int x, int y, unsigned int fontSize, Align align, const SegmentSymbol *symbols, uint8_t count);
+    bool isBuilt() const { return m_state != BuildState::Pending; }
+
+    // Change the selected screen from lastSymbol ('\0' = nothing) to symbol like drawString() would:
+    // with shadowing, unlit segments show shadowColor, without the segments of lastSymbol are cleared.
+    // Returns false if the face can't draw this change, the caller has to draw it as text then.
+    bool draw(ScreenManager &manager, int screen, char lastSymbol, char symbol, uint32_t color, uint32_t shadowColor, bool shadowing);
+    // Forget what is on the screen(s), e.g. after clearing them
+    void invalidate();
+    void invalidate(int screen);
+
+private:
+    enum class BuildState : uint8_t {
+        Pending,
+        Ready,
+        Failed
+    };
+    struct Segment {
+        uint16_t symbols; // Bit i is set if m_symbols[i] lights this segment
+        uint16_t first;
+        uint16_t count;
+    };
+    struct ScreenState {
+        bool valid = false;
+        char symbol = '\0';
+        bool shadowing = false;
+        uint32_t color = 0;
+        uint32_t shadowColor = 0;
+    };
+
+    int8_t indexOf(char symbol) const;
+
+    BuildState m_state = BuildState::Pending;
+    AlphaRun *m_runs = nullptr;
+    uint16_t m_runCount = 0;
+    Segment m_segments[SEGMENT_FACE_MAX_SEGMENTS];
+    uint8_t m_segmentCount = 0;
+    int32_t m_originX = 0;
+    int32_t m_originY = 0;
+    char m_symbols[SEGMENT_FACE_MAX_SYMBOLS];
+    uint8_t m_symbolCount = 0;
+    uint16_t m_usable = 0;
+    ScreenState m_screens[NUM_SCREENS];
+};
+
+#endif // SEGMENT_FACE_H
@@ -0,0 +1,69 @@
+#include "TextStamp.h"
+#include <vector>
+
+// Run in screen coordinates, before the stamp's origin is known
+struct ScreenRun {
+    int32_t x;
+    int32_t y;
+    uint8_t length;
+    uint8_t alpha;
+};
+
+TextStamp::~TextStamp() {
+    free(m_runs);
+}
+
+bool TextStamp::capture(ScreenManager &manager, const char *text, int x, int y, unsigned int fontSize, Align align) {
+    free(m_runs);
+    m_runs = nullptr;
+    m_runCount = 0;
+
+    // Glyphs are kept in drawing order, so overlapping pixels end up like drawString() leaves them
+    std::vector<ScreenRun> runs;
+    int32_t minX = INT32_MAX, minY = INT32_MAX, maxX = INT32_MIN, maxY = INT32_MIN;
+    manager.traceString(text, x, y, fontSize, align, [&](FT_BitmapGlyph glyph, int32_t left, int32_t top) {
+        const FT_Bitmap &bitmap = glyph->bitmap;
+        for (uint32_t row = 0; row < bitmap.rows; row++) {
+            size_t rowStart = runs.size();
+            const uint8_t *src = bitmap.buffer + row * bitmap.pitch;
+            for (uint32_t col = 0; col < bitmap.width; col++) {
+                if (src[col] == 0) {
+                    continue;
+                }
+                int32_t px = left + col;
+                if (runs.size() > rowStart && runs.back().x + runs.back().length == px && runs.back().alpha == src[col] && runs.back().length < 255) {
+                    runs.back().length++;
+                } else {
+                    runs.push_back({px, (int32_t) (top + row), 1, src[col]});
+                }
+                minX = min(minX, px);
+                maxX = max(maxX, px);
+            }
+            if (runs.size() > rowStart) {
+                minY = min(minY, (int32_t) (top + row));
+                maxY = max(maxY, (int32_t) (top + row));
+            }
+        }
+    });
+    if (runs.empty() || runs.size() > UINT16_MAX || maxX - minX > 255 || maxY - minY > 255) {
+        return false;
+    }
+
+    m_runs = (AlphaRun *) malloc(runs.size() * sizeof(AlphaRun));
+    if (m_runs == nullptr) {
+        return false;
+    }
+    for (size_t i = 0; i < runs.size(); i++) {
+        m_runs[i] = {(uint8_t) (runs[i].x - minX), (uint8_t) (runs[i].y - minY), runs[i].length, runs[i].alpha};
+    }
+    m_runCount = runs.size();
+    m_x = minX;
+    m_y = minY;
+    return true;
+}
+
+void TextStamp::draw(ScreenManager &manager, uint32_t fgColor, uint32_t bgColor) const {
+    if (m_runs != nullptr) {
+        manager.drawAlphaRuns(m_runs, m_runCount, m_x, m_y, fgColor, bgColor);
+    }
+}
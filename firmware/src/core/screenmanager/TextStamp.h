@@ -0,0 +1,28 @@
+#ifndef TEXT_STAMP_H
+#define TEXT_STAMP_H
+
+#include "ScreenManager.h"
+
+/**
+ * A short text rasterized once with the current font, redrawn as coverage runs in any color
+ * without touching the font. Erasing (drawing it in the background color) hits exactly the
+ * pixels it drew before.
+ */
+class TextStamp {
+public:
+    ~TextStamp();
+
+    // Position and size as for drawString(), false if the text is too large (over 255px) or out of memory
+    bool capture(ScreenManager &manager, const char *text, int x, int y, unsigned int fontSize, Align align);
+    // Draw on the selected screen
+    void draw(ScreenManager &manager, uint32_t fgColor, uint32_t bgColor) const;
+    bool isCaptured() const { return m_runs != nullptr; }
+
+private:
+    AlphaRun *m_runs = nullptr;
+    uint16_t m_runCount = 0;
+    int32_t m_x = 0;
+    int32_t m_y = 0;
+};
+
+#endif // TEXT_STAMP_H
@@ -0,0 +1,86 @@
+#include "TileCache.h"
+#include <ArduinoLog.h>
+
+static_assert(SCREEN_SIZE % TILE_SIZE == 0, "SCREEN_SIZE has to be a multiple of TILE_SIZE");
+static_assert(TILE_COLUMNS <= 32, "Tile columns have to fit into a 32 bit mask");
+
+TileCache::TileCache(TFT_eSPI &tft, DmaWriter &dma) : m_tft(tft), m_dma(dma), m_band(&tft) {
+}
+
+bool TileCache::begin() {
+    if (!TILE_CACHE_ENABLED || m_ready) {
+        return m_ready;
+    }
+    m_band.setColorDepth(16);
+    m_ready = m_band.createSprite(SCREEN_SIZE, TILE_SIZE) != nullptr;
+    if (!m_ready) {
+        Log.warningln("Not enough memory for the tile cache, retained screens are drawn directly");
+    }
+    return m_ready;
+}
+
+void TileCache::fill(uint32_t *hashes, uint16_t color) {
+    // Sprites keep their pixels byte swapped, ready to be pushed
+    uint16_t pixel = (color >> 8) | (color << 8);
+    for (uint16_t i = 0; i < TILE_SIZE * TILE_SIZE; i++) {
+        m_tile[i] = pixel;
+    }
+    uint32_t hash = hashTile(m_tile, TILE_SIZE);
+    for (uint16_t i = 0; i < TILE_COUNT; i++) {
+        hashes[i] = hash;
+    }
+}
+
+void TileCache::forget(uint32_t *hashes) {
+    memset(hashes, 0, TILE_COUNT * sizeof(uint32_t));
+}
+
+TFT_eSprite &TileCache::beginBand(uint8_t row) {
+    m_row = row;
+    // The datum moves the row to the top of the sprite, the height ends image decoding below it
+    int32_t top = row * TILE_SIZE;
+    m_band.setViewport(0, -top, SCREEN_SIZE, top + TILE_SIZE, true);
+    return m_band;
+}
+
+void TileCache::pushBand(uint32_t *hashes, uint32_t columns) {
+    m_band.resetViewport();
+    const uint16_t *pixels = (const uint16_t *) m_band.getPointer();
+    uint32_t *rowHashes = hashes + m_row * TILE_COLUMNS;
+    // Like TFT_eSprite::pushSprite(), the pixels are already in panel order
+    bool swapBytes = m_tft.getSwapBytes();
+    m_tft.setSwapBytes(false);
+    for (uint8_t column = 0; column < TILE_COLUMNS; column++) {
+        if ((columns & (1UL << column)) == 0) {
+            continue;
+        }
+        uint32_t hash = hashTile(pixels + column * TILE_SIZE, SCREEN_SIZE);
+        if (hash == rowHashes[column]) {
+            m_stats.lastSkipped++;
+            m_stats.savedBytes += TILE_SIZE * TILE_SIZE * 2;
+            continue;
+        }
+        m_dma.push(column * TILE_SIZE, m_row * TILE_SIZE, TILE_SIZE, TILE_SIZE, pixels + column * TILE_SIZE, SCREEN_SIZE);
+        rowHashes[column] = hash;
+        m_stats.lastPushed++;
+        m_stats.pushedBytes += TILE_SIZE * TILE_SIZE * 2;
+    }
+    m_tft.setSwapBytes(swapBytes);
+}
+
+void TileCache::beginFrame() {
+    m_stats.lastPushed = 0;
+    m_stats.lastSkipped = 0;
+}
+
+// FNV-1a over whole pixels, never 0 so that unknown tiles always differ
+uint32_t TileCache::hashTile(const uint16_t *pixels, uint16_t stride) {
+    uint32_t hash = 2166136261UL;
+    for (uint8_t y = 0; y < TILE_SIZE; y++) {
+        const uint16_t *line = pixels + y * stride;
+        for (uint8_t x = 0; x < TILE_SIZE; x++) {
+            hash = (hash ^ line[x]) * 16777619UL;
+        }
+    }
+    return hash != 0 ? hash : 1;
+}
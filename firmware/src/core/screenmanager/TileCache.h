@@ -0,0 +1,64 @@
+#ifndef TILE_CACHE_H
+#define TILE_CACHE_H
+
+#include "DmaWriter.h"
+#include "config_helper.h"
+#include <TFT_eSPI.h>
+
+#ifndef TILE_CACHE_ENABLED
+    #define TILE_CACHE_ENABLED 1 // Render retained screens in bands and push only the tiles that changed
+#endif
+
+#define TILE_SIZE 16
+#define TILE_COLUMNS (SCREEN_SIZE / TILE_SIZE)
+#define TILE_ROWS TILE_COLUMNS
+#define TILE_COUNT (TILE_COLUMNS * TILE_ROWS)
+
+// Tiles pushed and skipped by the last commit and since boot
+struct TileStats {
+    uint16_t lastPushed;
+    uint16_t lastSkipped;
+    uint32_t pushedBytes;
+    uint32_t savedBytes;
+};
+
+/**
+ * Hashes of the 16x16 tiles of a screen stand in for a framebuffer (the panels can't be read back
+ * and there is no RAM for one per orb, TILE_COUNT hashes are about 900 bytes). A band of one tile
+ * row is rendered into a sprite, its tiles are hashed and only the ones that differ from what the
+ * panel shows are pushed. A hash of 0 means the tile is unknown.
+ */
+class TileCache {
+public:
+    TileCache(TFT_eSPI &tft, DmaWriter &dma);
+
+    // Allocate the band on first use, false if there is no RAM for it (or the cache is disabled)
+    bool begin();
+    // The screen of hashes shows a single color now
+    void fill(uint32_t *hashes, uint16_t color);
+    // Nothing is known about the screen of hashes
+    void forget(uint32_t *hashes);
+
+    // Sprite to render tile row into, drawn on with screen coordinates
+    TFT_eSprite &beginBand(uint8_t row);
+    // Push the tiles of the band with their bit set in columns that differ from hashes to the selected screens.
+    // Within a write section of the DmaWriter the next band can be rendered while the last tile is sent.
+    void pushBand(uint32_t *hashes, uint32_t columns);
+    // Start counting the tiles of a new commit
+    void beginFrame();
+
+    const TileStats &getStats() const { return m_stats; }
+
+private:
+    static uint32_t hashTile(const uint16_t *pixels, uint16_t stride);
+
+    TFT_eSPI &m_tft;
+    DmaWriter &m_dma;
+    TFT_eSprite m_band;
+    bool m_ready = false;
+    uint8_t m_row = 0;
+    uint16_t m_tile[TILE_SIZE * TILE_SIZE];
+    TileStats m_stats = {0, 0, 0, 0};
+};
+
+#endif // TILE_CACHE_H
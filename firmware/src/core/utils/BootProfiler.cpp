@@ -0,0 +1,79 @@
+#include "BootProfiler.h"
+#include <ArduinoJson.h>
+#include <ArduinoLog.h>
+
+BootProfiler::Phase BootProfiler::s_phases[BOOT_PROFILER_MAX_PHASES];
+uint8_t BootProfiler::s_phaseCount = 0;
+uint32_t BootProfiler::s_firstFrame = 0;
+portMUX_TYPE BootProfiler::s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void BootProfiler::begin(const char *name) {
+    uint32_t now = millis();
+    portENTER_CRITICAL(&s_lock);
+    if (s_phaseCount < BOOT_PROFILER_MAX_PHASES && s_firstFrame == 0) {
+        s_phases[s_phaseCount++] = {name, now, 0};
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void BootProfiler::end(const char *name) {
+    uint32_t now = millis();
+    portENTER_CRITICAL(&s_lock);
+    for (uint8_t i = 0; i < s_phaseCount; i++) {
+        if (s_phases[i].end == 0 && strcmp(s_phases[i].name, name) == 0) {
+            s_phases[i].end = now;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void BootProfiler::firstFrame() {
+    if (s_firstFrame != 0) {
+        return;
+    }
+    s_firstFrame = millis();
+    printSummary();
+}
+
+bool BootProfiler::isDone() {
+    return s_firstFrame != 0;
+}
+
+void BootProfiler::printSummary() {
+    Log.noticeln("Boot phases (ms since reset):");
+    for (uint8_t i = 0; i < s_phaseCount; i++) {
+        const Phase &phase = s_phases[i];
+        if (phase.end == 0) {
+            Log.noticeln("  %s: %d - (running)", phase.name, phase.start);
+        } else {
+            Log.noticeln("  %s: %d - %d (%d ms)", phase.name, phase.start, phase.end, phase.end - phase.start);
+        }
+    }
+    if (s_firstFrame != 0) {
+        Log.noticeln("First frame after %d ms", s_firstFrame);
+    }
+}
+
+String BootProfiler::getSummaryJson() {
+    JsonDocument doc;
+    JsonArray phases = doc["phases"].to<JsonArray>();
+    portENTER_CRITICAL(&s_lock);
+    uint8_t count = s_phaseCount;
+    portEXIT_CRITICAL(&s_lock);
+    for (uint8_t i = 0; i < count; i++) {
+        JsonObject phase = phases.add<JsonObject>();
+        phase["name"] = s_phases[i].name;
+        phase["start"] = s_phases[i].start;
+        if (s_phases[i].end != 0) {
+            phase["end"] = s_phases[i].end;
+            phase["duration"] = s_phases[i].end - s_phases[i].start;
+        }
+    }
+    if (s_firstFrame != 0) {
+        doc["firstFrame"] = s_firstFrame;
+    }
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
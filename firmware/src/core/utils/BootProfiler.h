@@ -0,0 +1,41 @@
+#ifndef BOOT_PROFILER_H
+#define BOOT_PROFILER_H
+
+#include <Arduino.h>
+
+#ifndef BOOT_PROFILER_MAX_PHASES
+    #define BOOT_PROFILER_MAX_PHASES 16
+#endif
+
+/**
+ * Records when the boot phases start and end (ms since reset).
+ *
+ * Phases are identified by name and may overlap, e.g. WiFi association runs while the
+ * config is loaded. begin()/end() can be called from any task. The boot ends with the
+ * first complete widget frame, then the summary is printed and served at /boot.
+ */
+class BootProfiler {
+public:
+    static void begin(const char *name);
+    static void end(const char *name);
+    // The first widget frame is on screen, ends the boot
+    static void firstFrame();
+    static bool isDone();
+
+    static void printSummary();
+    static String getSummaryJson();
+
+private:
+    struct Phase {
+        const char *name;
+        uint32_t start;
+        uint32_t end;
+    };
+
+    static Phase s_phases[BOOT_PROFILER_MAX_PHASES];
+    static uint8_t s_phaseCount;
+    static uint32_t s_firstFrame;
+    static portMUX_TYPE s_lock;
+};
+
+#endif // BOOT_PROFILER_H
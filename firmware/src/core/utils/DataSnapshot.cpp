@@ -0,0 +1,229 @@
+#include "DataSnapshot.h"
+#include "GlobalTime.h"
+#include <ArduinoLog.h>
+#include <memory>
+#include <new>
+
+static const uint32_t s_snapshotMagic = 0x5342524F; // "ORBS"
+
+SnapshotWriter::SnapshotWriter(const char *name, uint8_t version, const String &key) {
+    m_path = DataSnapshot::getPath(name);
+    // Write to a temporary file, so a reset while writing doesn't destroy the previous snapshot
+    m_file = LittleFS.open(m_path + ".tmp", "w", true);
+    if (!m_file) {
+        Log.warningln("Snapshot: failed to open %s for writing", m_path.c_str());
+        return;
+    }
+    m_ok = true;
+    uint32_t savedAt = GlobalTime::getUnixEpochIfAvailable();
+    if (savedAt == 0) {
+        // Saved before the time was synced, keep the time of the replaced snapshot, so it still expires
+        savedAt = DataSnapshot::getSavedAt(name);
+    }
+    write(s_snapshotMagic);
+    write(version);
+    write(savedAt);
+    write(key);
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    if (m_file) {
+        // Not committed
+        m_file.close();
+        LittleFS.remove(m_path + ".tmp");
+    }
+}
+
+void SnapshotWriter::write(const String &value) {
+    uint16_t length = value.length();
+    write(length);
+    writeBytes(value.c_str(), length);
+}
+
+void SnapshotWriter::write(const char *value) {
+    uint16_t length = strlen(value);
+    write(length);
+    writeBytes(value, length);
+}
+
+void SnapshotWriter::writeJson(JsonVariantConst value) {
+    size_t size = measureMsgPack(value);
+    if (size > UINT16_MAX) {
+        m_ok = false;
+        return;
+    }
+    write((uint16_t) size);
+    if (m_ok && serializeMsgPack(value, m_file) != size) {
+        m_ok = false;
+    }
+}
+
+void SnapshotWriter::writeBytes(const void *data, size_t size) {
+    if (m_ok && m_file.write((const uint8_t *) data, size) != size) {
+        m_ok = false;
+    }
+}
+
+bool SnapshotWriter::commit() {
+    if (!m_file) {
+        return false;
+    }
+    size_t size = m_file.size();
+    m_file.close();
+    String tmpPath = m_path + ".tmp";
+    if (!m_ok) {
+        Log.warningln("Snapshot: failed to write %s", m_path.c_str());
+        LittleFS.remove(tmpPath);
+        return false;
+    }
+    if (!LittleFS.rename(tmpPath, m_path)) {
+        LittleFS.remove(m_path);
+        if (!LittleFS.rename(tmpPath, m_path)) {
+            Log.warningln("Snapshot: failed to replace %s", m_path.c_str());
+            LittleFS.remove(tmpPath);
+            return false;
+        }
+    }
+    Log.traceln("Snapshot: saved %s (%d bytes)", m_path.c_str(), (int) size);
+    return true;
+}
+
+SnapshotReader::SnapshotReader(const char *name, uint8_t version, const String &key) {
+    String path = DataSnapshot::getPath(name);
+    if (!LittleFS.exists(path)) {
+        return;
+    }
+    m_file = LittleFS.open(path, "r");
+    if (!m_file) {
+        return;
+    }
+    m_ok = true;
+    uint32_t magic = 0;
+    uint8_t fileVersion = 0;
+    uint32_t savedAt = 0;
+    String fileKey;
+    if (!read(magic) || !read(fileVersion) || !read(savedAt) || !read(fileKey)) {
+        Log.warningln("Snapshot: %s is truncated", path.c_str());
+        return;
+    }
+    m_savedAt = savedAt;
+    if (magic != s_snapshotMagic || fileVersion != version) {
+        Log.infoln("Snapshot: %s has an old format, ignoring it", path.c_str());
+        m_ok = false;
+    } else if (fileKey != key) {
+        Log.infoln("Snapshot: %s was saved for other settings, ignoring it", path.c_str());
+        m_ok = false;
+    } else if (isOutdated(m_savedAt)) {
+        Log.infoln("Snapshot: %s is outdated, ignoring it", path.c_str());
+        m_ok = false;
+    }
+}
+
+bool SnapshotReader::isAgeKnown() const {
+    return m_savedAt != 0 && GlobalTime::getUnixEpochIfAvailable() != 0;
+}
+
+uint32_t SnapshotReader::getAge() const {
+    time_t now = GlobalTime::getUnixEpochIfAvailable();
+    if (m_savedAt == 0 || now < m_savedAt) {
+        return 0;
+    }
+    return now - m_savedAt;
+}
+
+// Once the time is known a snapshot without a save time is treated as outdated, it would never expire otherwise
+bool SnapshotReader::isOutdated(time_t savedAt) {
+    time_t now = GlobalTime::getUnixEpochIfAvailable();
+    if (DATA_SNAPSHOT_MAX_AGE == 0 || now == 0) {
+        return false;
+    }
+    return savedAt == 0 || (now > savedAt && now - savedAt > DATA_SNAPSHOT_MAX_AGE);
+}
+
+bool SnapshotReader::read(String &value) {
+    uint16_t length = 0;
+    if (!read(length)) {
+        return false;
+    }
+    char buffer[64];
+    value = "";
+    value.reserve(length);
+    while (length > 0) {
+        size_t chunk = std::min<size_t>(length, sizeof(buffer));
+        if (!readBytes(buffer, chunk)) {
+            return false;
+        }
+        value.concat(buffer, chunk);
+        length -= chunk;
+    }
+    return true;
+}
+
+bool SnapshotReader::read(InternedString &value) {
+    String string;
+    if (!read(string)) {
+        return false;
+    }
+    value = string;
+    return true;
+}
+
+bool SnapshotReader::readJson(JsonDocument &doc) {
+    uint16_t size = 0;
+    if (!read(size)) {
+        return false;
+    }
+    // A corrupt size must not abort the boot, it's read again on every start
+    if (size > m_file.available()) {
+        m_ok = false;
+        return false;
+    }
+    std::unique_ptr<uint8_t[]> buffer(new (std::nothrow) uint8_t[size]);
+    if (!buffer) {
+        Log.warningln("Snapshot: no memory for %d bytes of JSON", (int) size);
+        m_ok = false;
+        return false;
+    }
+    if (!readBytes(buffer.get(), size)) {
+        return false;
+    }
+    if (deserializeMsgPack(doc, buffer.get(), size)) {
+        m_ok = false;
+    }
+    return m_ok;
+}
+
+bool SnapshotReader::readBytes(void *data, size_t size) {
+    if (!m_ok || m_file.read((uint8_t *) data, size) != size) {
+        m_ok = false;
+    }
+    return m_ok;
+}
+
+String DataSnapshot::getPath(const char *name) {
+    return String(DATA_SNAPSHOT_DIR) + "/" + name + ".bin";
+}
+
+time_t DataSnapshot::getSavedAt(const char *name) {
+    File file = LittleFS.open(getPath(name), "r");
+    if (!file) {
+        return 0;
+    }
+    uint32_t magic = 0;
+    uint8_t version = 0;
+    uint32_t savedAt = 0;
+    if (file.read((uint8_t *) &magic, sizeof(magic)) != sizeof(magic) || magic != s_snapshotMagic ||
+        file.read(&version, sizeof(version)) != sizeof(version) || file.read((uint8_t *) &savedAt, sizeof(savedAt)) != sizeof(savedAt)) {
+        savedAt = 0;
+    }
+    file.close();
+    return savedAt;
+}
+
+bool DataSnapshot::exists(const char *name) {
+    return LittleFS.exists(getPath(name));
+}
+
+void DataSnapshot::remove(const char *name) {
+    LittleFS.remove(getPath(name));
+}
@@ -0,0 +1,111 @@
+#ifndef DATA_SNAPSHOT_H
+#define DATA_SNAPSHOT_H
+
+#include "FixedString.h"
+#include "StringPool.h"
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+#include <type_traits>
+
+#ifndef DATA_SNAPSHOT_DIR
+    #define DATA_SNAPSHOT_DIR "/snapshots"
+#endif
+
+#ifndef DATA_SNAPSHOT_MAX_AGE
+    #define DATA_SNAPSHOT_MAX_AGE 86400 // Ignore snapshots older than X seconds (if the time is known), 0 = no limit
+#endif
+
+/**
+ * Compact binary snapshots of widget data models on LittleFS, so the orbs can show the
+ * last known data right after boot while fresh data is loaded in the background.
+ *
+ * File layout: magic, format version, save time (unix epoch, the time of the replaced snapshot
+ * if the time wasn't synced yet, 0 if there was none),
+ * key, followed by the model's fields in the order they were written. Strings are stored
+ * as uint16 length + bytes, JSON as uint16 length + MessagePack, numbers as in memory.
+ * A snapshot is only restored if version and key match, so bump the version when the
+ * layout changes and put the settings that select the data (e.g. location, symbols) into the key.
+ */
+class SnapshotWriter {
+public:
+    SnapshotWriter(const char *name, uint8_t version, const String &key = "");
+    ~SnapshotWriter();
+
+    template <typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Use write(String) for strings");
+        writeBytes(&value, sizeof(T));
+    }
+    void write(const String &value);
+    void write(const char *value);
+    template <size_t N>
+    void write(const FixedString<N> &value) {
+        write(value.c_str());
+    }
+    void write(const InternedString &value) { write(value.c_str()); }
+    // Stored as MessagePack, for models that are kept as parsed JSON
+    void writeJson(JsonVariantConst value);
+
+    // Replace the previous snapshot, returns false (and keeps the previous one) if a write failed
+    bool commit();
+
+private:
+    void writeBytes(const void *data, size_t size);
+
+    File m_file;
+    String m_path;
+    bool m_ok = false;
+};
+
+class SnapshotReader {
+public:
+    SnapshotReader(const char *name, uint8_t version, const String &key = "");
+
+    // False if there is no matching snapshot or a read failed
+    bool ok() const { return m_ok; }
+    // Unix epoch of when the snapshot was saved, 0 if unknown
+    time_t getSavedAt() const { return m_savedAt; }
+    // False while the time isn't synced or if the snapshot was saved before it was
+    bool isAgeKnown() const;
+    // Seconds since the snapshot was saved, 0 if unknown
+    uint32_t getAge() const;
+    // Older than DATA_SNAPSHOT_MAX_AGE (or of unknown save time), false while the time isn't synced
+    static bool isOutdated(time_t savedAt);
+
+    template <typename T>
+    bool read(T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Use read(String &) for strings");
+        return readBytes(&value, sizeof(T));
+    }
+    bool read(String &value);
+    template <size_t N>
+    bool read(FixedString<N> &value) {
+        String string;
+        if (!read(string)) {
+            return false;
+        }
+        value = string;
+        return true;
+    }
+    bool read(InternedString &value);
+    bool readJson(JsonDocument &doc);
+
+private:
+    bool readBytes(void *data, size_t size);
+
+    File m_file;
+    time_t m_savedAt = 0;
+    bool m_ok = false;
+};
+
+class DataSnapshot {
+public:
+    static String getPath(const char *name);
+    // Unix epoch the snapshot was saved at, 0 if unknown or there is none
+    static time_t getSavedAt(const char *name);
+    static bool exists(const char *name);
+    static void remove(const char *name);
+};
+
+#endif // DATA_SNAPSHOT_H
@@ -0,0 +1,73 @@
+#ifndef FIXED_STRING_H
+#define FIXED_STRING_H
+
+#include <Arduino.h>
+
+/**
+ * String with an inline buffer for up to N - 1 bytes, for data model fields.
+ *
+ * Unlike String it never allocates, so models don't fragment the heap and getters can
+ * return a const reference instead of a copy. Longer values are cut at a UTF-8 character
+ * boundary. Converts to const char *, use toString() where a String is needed.
+ */
+template <size_t N>
+class FixedString {
+public:
+    FixedString() = default;
+    FixedString(const char *value) { set(value); }
+    FixedString(const String &value) { set(value.c_str()); }
+
+    // Returns true if the value changed
+    bool set(const char *value) {
+        if (value == nullptr) {
+            value = "";
+        }
+        size_t length = strnlen(value, N - 1);
+        if (value[length] != '\0') {
+            // Truncated, don't cut a multi-byte character in half
+            while (length > 0 && (value[length] & 0xC0) == 0x80) {
+                length--;
+            }
+        }
+        if (strncmp(m_data, value, length) == 0 && m_data[length] == '\0') {
+            return false;
+        }
+        memcpy(m_data, value, length);
+        m_data[length] = '\0';
+        return true;
+    }
+    bool set(const String &value) { return set(value.c_str()); }
+
+    FixedString &operator=(const char *value) {
+        set(value);
+        return *this;
+    }
+    FixedString &operator=(const String &value) {
+        set(value.c_str());
+        return *this;
+    }
+
+    const char *c_str() const { return m_data; }
+    operator const char *() const { return m_data; }
+    String toString() const { return String(m_data); }
+    size_t length() const { return strlen(m_data); }
+    static constexpr size_t capacity() { return N - 1; }
+    bool isEmpty() const { return m_data[0] == '\0'; }
+    void clear() { m_data[0] = '\0'; }
+    int indexOf(const char *needle) const {
+        const char *found = strstr(m_data, needle);
+        return found ? found - m_data : -1;
+    }
+
+    bool operator==(const char *other) const { return strcmp(m_data, other ? other : "") == 0; }
+    bool operator==(const String &other) const { return strcmp(m_data, other.c_str()) == 0; }
+    template <size_t M>
+    bool operator==(const FixedString<M> &other) const { return strcmp(m_data, other.c_str()) == 0; }
+    template <typename T>
+    bool operator!=(const T &other) const { return !(*this == other); }
+
+private:
+    char m_data[N] = {0};
+};
+
+#endif // FIXED_STRING_H
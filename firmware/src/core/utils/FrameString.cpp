@@ -0,0 +1,140 @@
+#include "FrameString.h"
+#include <ArduinoLog.h>
+#include <stdarg.h>
+
+char FrameArena::s_buffer[FRAME_ARENA_SIZE];
+size_t FrameArena::s_used = 0;
+size_t FrameArena::s_last = 0;
+size_t FrameArena::s_requested = 0;
+size_t FrameArena::s_peak = 0;
+char *FrameArena::s_overflowBlocks[FRAME_ARENA_OVERFLOW_BLOCKS] = {};
+uint8_t FrameArena::s_overflowCount = 0;
+uint32_t FrameArena::s_overflows = 0;
+
+char *FrameArena::allocate(size_t size) {
+    s_requested += size;
+    if (s_used + size <= FRAME_ARENA_SIZE) {
+        s_last = s_used;
+        s_used += size;
+        return s_buffer + s_last;
+    }
+    if (s_overflowCount == FRAME_ARENA_OVERFLOW_BLOCKS) {
+        return nullptr;
+    }
+    char *block = (char *) malloc(size);
+    if (block != nullptr) {
+        s_overflowBlocks[s_overflowCount++] = block;
+        s_overflows++;
+    }
+    return block;
+}
+
+bool FrameArena::extend(const char *block, size_t newSize) {
+    if (s_used == 0 || block != s_buffer + s_last || s_last + newSize > FRAME_ARENA_SIZE) {
+        return false;
+    }
+    s_requested += s_last + newSize - s_used;
+    s_used = s_last + newSize;
+    return true;
+}
+
+void FrameArena::reset() {
+    for (uint8_t i = 0; i < s_overflowCount; i++) {
+        free(s_overflowBlocks[i]);
+    }
+    s_overflowCount = 0;
+    if (s_requested > s_peak) {
+        s_peak = s_requested;
+        if (s_peak > FRAME_ARENA_SIZE) {
+            Log.warningln("Frame arena needed %d of %d bytes, consider raising FRAME_ARENA_SIZE", (int) s_peak, FRAME_ARENA_SIZE);
+        }
+    }
+    s_used = 0;
+    s_last = 0;
+    s_requested = 0;
+}
+
+FrameString::FrameString(const char *value) : FrameString(value, value ? strlen(value) : 0) {
+}
+
+FrameString::FrameString(const char *value, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    m_data = FrameArena::allocate(length + 1);
+    if (m_data == nullptr) {
+        return;
+    }
+    memcpy(m_data, value, length);
+    m_data[length] = '\0';
+    m_length = length;
+}
+
+FrameString::FrameString(FrameString &&other) : m_data(other.m_data), m_length(other.m_length) {
+    other.m_data = nullptr;
+    other.m_length = 0;
+}
+
+FrameString &FrameString::operator=(FrameString &&other) {
+    if (this != &other) {
+        m_data = other.m_data;
+        m_length = other.m_length;
+        other.m_data = nullptr;
+        other.m_length = 0;
+    }
+    return *this;
+}
+
+FrameString FrameString::format(const char *format, ...) {
+    FrameString result;
+    va_list args;
+    va_list argsCopy;
+    va_start(args, format);
+    va_copy(argsCopy, args);
+    int length = vsnprintf(nullptr, 0, format, argsCopy);
+    va_end(argsCopy);
+    if (length > 0) {
+        result.m_data = FrameArena::allocate(length + 1);
+        if (result.m_data != nullptr) {
+            vsnprintf(result.m_data, length + 1, format, args);
+            result.m_length = length;
+        }
+    }
+    va_end(args);
+    return result;
+}
+
+FrameString &FrameString::append(const char *value, size_t length) {
+    if (length == 0) {
+        return *this;
+    }
+    if (m_data == nullptr) {
+        *this = FrameString(value, length);
+        return *this;
+    }
+    size_t newLength = m_length + length;
+    // Usually the string was the last allocation and just grows
+    if (!FrameArena::extend(m_data, newLength + 1)) {
+        char *data = FrameArena::allocate(newLength + 1);
+        if (data == nullptr) {
+            return *this;
+        }
+        memcpy(data, m_data, m_length);
+        m_data = data;
+    }
+    memmove(m_data + m_length, value, length);
+    m_length = newLength;
+    m_data[m_length] = '\0';
+    return *this;
+}
+
+FrameString FrameString::operator+(const char *value) && {
+    *this += value;
+    return std::move(*this);
+}
+
+FrameString FrameString::operator+(const char *value) const & {
+    FrameString result(c_str(), m_length);
+    result += value;
+    return result;
+}
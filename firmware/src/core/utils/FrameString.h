@@ -0,0 +1,80 @@
+#ifndef FRAME_STRING_H
+#define FRAME_STRING_H
+
+#include <Arduino.h>
+
+#ifndef FRAME_ARENA_SIZE
+    #define FRAME_ARENA_SIZE 2048 // Bytes for temporary strings per main loop pass
+#endif
+
+#ifndef FRAME_ARENA_OVERFLOW_BLOCKS
+    #define FRAME_ARENA_OVERFLOW_BLOCKS 8 // Heap blocks borrowed per loop pass once the arena is full
+#endif
+
+/**
+ * Bump allocator for the temporary strings built while drawing. Allocating is a pointer
+ * increment and everything is released at once by reset() at the start of each main loop
+ * pass, so formatting a frame doesn't touch the heap. If a pass needs more than
+ * FRAME_ARENA_SIZE, blocks are borrowed from the heap and freed on reset (logged as a
+ * warning whenever a new peak is reached). Main loop only.
+ */
+class FrameArena {
+public:
+    // Returns nullptr if both the arena and the overflow blocks are used up
+    static char *allocate(size_t size);
+    // Grow the most recent allocation in place, false if it isn't the last one or doesn't fit
+    static bool extend(const char *block, size_t newSize);
+    static void reset();
+
+    static size_t getUsed() { return s_used; }
+    // Most bytes requested in a single loop pass, including overflow
+    static size_t getPeak() { return s_peak; }
+    static uint32_t getOverflows() { return s_overflows; }
+
+private:
+    static char s_buffer[FRAME_ARENA_SIZE];
+    static size_t s_used;
+    static size_t s_last;
+    static size_t s_requested;
+    static size_t s_peak;
+    static char *s_overflowBlocks[FRAME_ARENA_OVERFLOW_BLOCKS];
+    static uint8_t s_overflowCount;
+    static uint32_t s_overflows;
+};
+
+/**
+ * String in the frame arena, only valid until the end of the current main loop pass:
+ * pass it to the draw calls or logs, never keep it in a member. Move-only, so appending
+ * can extend the buffer in place. If the arena runs out, appended text is dropped.
+ */
+class FrameString {
+public:
+    FrameString() = default;
+    FrameString(const char *value);
+    FrameString(const char *value, size_t length);
+    FrameString(FrameString &&other);
+    FrameString &operator=(FrameString &&other);
+    FrameString(const FrameString &) = delete;
+    FrameString &operator=(const FrameString &) = delete;
+
+    static FrameString format(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+    FrameString &append(const char *value, size_t length);
+    FrameString &operator+=(const char *value) { return append(value, value ? strlen(value) : 0); }
+    FrameString &operator+=(char c) { return append(&c, 1); }
+    // Chained temporaries grow in place, named values are copied
+    FrameString operator+(const char *value) &&;
+    FrameString operator+(const char *value) const &;
+
+    const char *c_str() const { return m_data ? m_data : ""; }
+    operator const char *() const { return c_str(); }
+    String toString() const { return String(c_str()); }
+    size_t length() const { return m_length; }
+    bool isEmpty() const { return m_length == 0; }
+
+private:
+    char *m_data = nullptr;
+    size_t m_length = 0;
+};
+
+#endif // FRAME_STRING_H
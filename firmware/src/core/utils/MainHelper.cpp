@@ -1,5 +1,8 @@
 #include "MainHelper.h"
+#include "BootProfiler.h"
+#include "DrawStats.h"
 #include "LittleFSHelper.h"
+#include "Scheduler.h"
 #include "Translations.h"
 #include "config_helper.h"
 #include "icons.h"
@@ -19,6 +22,7 @@ static ScreenManager *s_screenManager = nullptr;
 static WidgetSet *s_widgetSet = nullptr;
 static int s_widgetCycleDelay = WIDGET_CYCLE_DELAY;
 static unsigned long s_widgetCycleDelayPrev = 0;
+static unsigned long s_widgetPrefetchedFor = 0; // cycle slot (start time) the next widget was prefetched for
 static int s_orbRotation = ORB_ROTATION;
 static std::string s_timezoneLocation = TIMEZONE_API_LOCATION;
 static std::string s_ntpServer = NTP_SERVER;
@@ -40,9 +44,18 @@ void MainHelper::init(WiFiManager *wm, ConfigManager *cm, ScreenManager *sm, Wid
 /**
  * The ISR handlers must be static
  */
-void MainHelper::isrButtonChangeLeft() { buttonLeft.isrButtonChange(); }
-void MainHelper::isrButtonChangeMiddle() { buttonMiddle.isrButtonChange(); }
-void MainHelper::isrButtonChangeRight() { buttonRight.isrButtonChange(); }
+void MainHelper::isrButtonChangeLeft() {
+    buttonLeft.isrButtonChange();
+    Scheduler::notifyFromISR();
+}
+void MainHelper::isrButtonChangeMiddle() {
+    buttonMiddle.isrButtonChange();
+    Scheduler::notifyFromISR();
+}
+void MainHelper::isrButtonChangeRight() {
+    buttonRight.isrButtonChange();
+    Scheduler::notifyFromISR();
+}
 
 void MainHelper::setupButtons() {
     bool invertButtons = s_orbRotation == 1 || s_orbRotation == 2;
@@ -80,6 +93,19 @@ void MainHelper::setupConfig() {
     s_configManager->addConfigComboBox("TFT Settings", "dimStartHour", &s_dimStartHour, optHours, 24, t_dimStartHour, true);
     s_configManager->addConfigComboBox("TFT Settings", "dimEndHour", &s_dimEndHour, optHours, 24, t_dimEndHour, true);
     s_configManager->addConfigInt("TFT Settings", "dimBrightness", &s_dimBrightness, t_dimBrightness, true);
+
+    // Settings that can be applied without a restart
+    s_configManager->addOnChangeCallback("General", "widgetCycDelay", [](const char *section, const char *varName) {
+        resetCycleTimer();
+    });
+    auto applyBrightness = [](const char *section, const char *varName) {
+        updateBrightnessByTime(GlobalTime::getInstance()->getHour24());
+    };
+    s_configManager->addOnChangeCallback("TFT Settings", "nightmode", applyBrightness);
+    s_configManager->addOnChangeCallback("TFT Settings", "tftBrightness", applyBrightness);
+    s_configManager->addOnChangeCallback("TFT Settings", "dimStartHour", applyBrightness);
+    s_configManager->addOnChangeCallback("TFT Settings", "dimEndHour", applyBrightness);
+    s_configManager->addOnChangeCallback("TFT Settings", "dimBrightness", applyBrightness);
 }
 
 void MainHelper::buttonPressed(uint8_t buttonId, ButtonState state) {
@@ -140,6 +166,11 @@ void MainHelper::checkCycleWidgets() {
     if (s_widgetSet && s_widgetCycleDelay > 0 && (s_widgetCycleDelayPrev == 0 || (millis() - s_widgetCycleDelayPrev) >= s_widgetCycleDelay * 1000)) {
         s_widgetSet->next();
         s_widgetCycleDelayPrev = millis();
+    } else if (s_widgetSet && s_widgetCycleDelay > 0 && s_widgetPrefetchedFor != s_widgetCycleDelayPrev &&
+               (millis() - s_widgetCycleDelayPrev) + WIDGET_PREFETCH_LEAD * 1000 >= s_widgetCycleDelay * 1000) {
+        // Next widget is due soon -> refresh its data now, so it doesn't start with stale data
+        s_widgetSet->prefetchNext();
+        s_widgetPrefetchedFor = s_widgetCycleDelayPrev;
     }
 }
 
@@ -414,6 +445,20 @@ void MainHelper::handleEndpointDeleteFile() {
     }
 }
 
+void MainHelper::handleEndpointBoot() {
+    // Boot phase timings, see BootProfiler
+    s_wifiManager->server->send(200, "application/json", BootProfiler::getSummaryJson());
+}
+
+void MainHelper::handleEndpointDraws() {
+    // Draw calls and SPI traffic per orb and widget, see DrawStats. Also printed to the log, ?reset=1 starts over.
+    DrawStats::printSummary();
+    s_wifiManager->server->send(200, "application/json", DrawStats::getSummaryJson());
+    if (s_wifiManager->server->arg("reset") == "1") {
+        DrawStats::reset();
+    }
+}
+
 void MainHelper::setupWebPortalEndpoints() {
     // To simulate button presses call e.g. http://<ip>/button?name=right&state=short
     s_wifiManager->server->on("/button", handleEndpointButton);
@@ -424,6 +469,8 @@ void MainHelper::setupWebPortalEndpoints() {
     s_wifiManager->server->on(
         "/upload", HTTP_POST, [] { s_wifiManager->server->send(200, "text/html", "<h2>File uploaded successfully!</h2><a href='/browse?dir=" + s_wifiManager->server->arg("dir") + "'>Back to file list</a>"); }, handleEndpointUploadFile);
     s_wifiManager->server->on("/delete", HTTP_GET, handleEndpointDeleteFile);
+    s_wifiManager->server->on("/boot", HTTP_GET, handleEndpointBoot);
+    s_wifiManager->server->on("/draws", HTTP_GET, handleEndpointDraws);
 }
 
 void MainHelper::showWelcome() {
@@ -489,6 +536,10 @@ void MainHelper::restartIfNecessary() {
         }
         Log.noticeln("Restarting ESP now");
         ESP.restart();
+    } else if (s_configManager->takeLiveChanges()) {
+        // Config was applied live -> redraw the current widget with the new settings
+        s_screenManager->clearAllScreens();
+        s_widgetSet->drawCurrent(true);
     }
 }
 
@@ -40,6 +40,10 @@
     #define WIDGET_CYCLE_DELAY 0
 #endif
 
+#ifndef WIDGET_PREFETCH_LEAD
+    #define WIDGET_PREFETCH_LEAD 10 // Refresh the data of the next widget X seconds before it is cycled in
+#endif
+
 #ifndef NTP_SERVER
     #define NTP_SERVER "pool.ntp.org"
 #endif
@@ -74,6 +78,8 @@ public:
     static void handleEndpointDeleteFile();
     static void handleEndpointDownloadFile();
     static void handleEndpointFetchFilesFromURL();
+    static void handleEndpointBoot();
+    static void handleEndpointDraws();
 
     static void restartIfNecessary();
 
@@ -0,0 +1,143 @@
+#include "Scheduler.h"
+#include <ArduinoLog.h>
+#include <algorithm>
+
+Scheduler *Scheduler::s_instance = nullptr;
+TaskHandle_t Scheduler::s_loopTask = nullptr;
+
+Scheduler::Scheduler() {
+    // Must be constructed from the task that calls run() (the Arduino loop task)
+    s_loopTask = xTaskGetCurrentTaskHandle();
+}
+
+Scheduler *Scheduler::getInstance() {
+    if (!s_instance) {
+        s_instance = new Scheduler();
+    }
+    return s_instance;
+}
+
+int Scheduler::addJob(const char *name, uint32_t interval, JobCallback callback, bool runOnEvent) {
+    m_jobs.push_back({name, interval, millis(), callback, runOnEvent, 0, false, 0, 0, 0, 0});
+    int jobId = m_jobs.size() - 1;
+    push(jobId);
+    Log.traceln("Scheduler: added job %s, interval %d ms", name, interval);
+    return jobId;
+}
+
+void Scheduler::wakeAt(int jobId, unsigned long deadline) {
+    Job &job = m_jobs[jobId];
+    if (job.queued && job.deadline == deadline) {
+        // Already queued for this deadline, e.g. several wakeIn(job, 0) in the same millisecond
+        return;
+    }
+    job.deadline = deadline;
+    push(jobId);
+}
+
+void Scheduler::wakeIn(int jobId, uint32_t delay) {
+    wakeAt(jobId, millis() + delay);
+}
+
+void Scheduler::run() {
+    unsigned long now = millis();
+    // Take all due jobs first, so a job that reschedules itself immediately
+    // (e.g. an unfinished draw) runs again only after events were handled
+    m_due.clear();
+    while (!m_heap.empty() && !isBefore(now, m_heap.front().deadline)) {
+        std::pop_heap(m_heap.begin(), m_heap.end(), [](const HeapEntry &a, const HeapEntry &b) { return isBefore(b.deadline, a.deadline); });
+        HeapEntry entry = m_heap.back();
+        m_heap.pop_back();
+        Job &job = m_jobs[entry.jobId];
+        if (entry.generation != job.generation) {
+            // Outdated entry, the job was rescheduled with wakeAt()
+            continue;
+        }
+        job.queued = false;
+        m_due.push_back(entry.jobId);
+    }
+    for (int jobId : m_due) {
+        runJob(jobId, now);
+        now = millis();
+    }
+
+#ifdef SCHEDULER_DEBUG
+    if (now - m_lastStats >= SCHEDULER_STATS_INTERVAL) {
+        printStats();
+    }
+#endif
+
+    uint32_t sleep = SCHEDULER_MAX_SLEEP;
+    if (!m_heap.empty()) {
+        long untilNext = (long) (m_heap.front().deadline - now);
+        sleep = untilNext <= 0 ? 0 : std::min<uint32_t>(untilNext, SCHEDULER_MAX_SLEEP);
+    }
+    // Sleep until the next deadline, or less if an event arrives
+    if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(sleep)) > 0) {
+        for (auto &job : m_jobs) {
+            if (job.runOnEvent) {
+                job.callback();
+            }
+        }
+    }
+}
+
+void Scheduler::notify() {
+    if (s_loopTask) {
+        xTaskNotifyGive(s_loopTask);
+    }
+}
+
+void Scheduler::notifyFromISR() {
+    if (s_loopTask) {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(s_loopTask, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
+}
+
+void Scheduler::push(int jobId) {
+    Job &job = m_jobs[jobId];
+    job.generation++;
+    job.queued = true;
+    m_heap.push_back({job.deadline, jobId, job.generation});
+    std::push_heap(m_heap.begin(), m_heap.end(), [](const HeapEntry &a, const HeapEntry &b) { return isBefore(b.deadline, a.deadline); });
+}
+
+void Scheduler::runJob(int jobId, unsigned long now) {
+    Job &job = m_jobs[jobId];
+    uint32_t late = now - job.deadline;
+    // Advance from the previous deadline to avoid drift, skip runs we missed completely
+    unsigned long deadline = job.deadline + job.interval;
+    if (!isBefore(now, deadline)) {
+        deadline = now + job.interval;
+    }
+    // Schedule before running, the job may reschedule itself with wakeAt()
+    wakeAt(jobId, deadline);
+    job.callback();
+
+    uint32_t duration = millis() - now;
+    job.runs++;
+    job.totalLate += late;
+    job.maxLate = std::max(job.maxLate, late);
+    job.maxDuration = std::max(job.maxDuration, duration);
+}
+
+void Scheduler::printStats() {
+    for (auto &job : m_jobs) {
+        if (job.runs > 0) {
+            Log.noticeln("Scheduler: %s runs=%d late avg=%d max=%d ms, max duration=%d ms",
+                         job.name, job.runs, job.totalLate / job.runs, job.maxLate, job.maxDuration);
+        }
+        job.runs = 0;
+        job.totalLate = 0;
+        job.maxLate = 0;
+        job.maxDuration = 0;
+    }
+    m_lastStats = millis();
+}
+
+bool Scheduler::isBefore(unsigned long a, unsigned long b) {
+    // Handles millis() overflow
+    return (long) (a - b) < 0;
+}
@@ -0,0 +1,92 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <functional>
+#include <vector>
+
+// Uncomment to show debug output
+// #define SCHEDULER_DEBUG
+
+#ifndef SCHEDULER_STATS_INTERVAL
+    #define SCHEDULER_STATS_INTERVAL 10000 // Print job timing stats every X ms when SCHEDULER_DEBUG is defined
+#endif
+
+#ifndef SCHEDULER_MAX_SLEEP
+    #define SCHEDULER_MAX_SLEEP 1000 // Max time in ms the main loop sleeps, keeps the watchdog fed
+#endif
+
+/**
+ * Cooperative deadline scheduler for the main loop.
+ *
+ * Jobs are kept in a min-heap ordered by their next deadline. run() executes every due job
+ * and then sleeps until the earliest deadline or until notify()/notifyFromISR() is called.
+ * Periodic deadlines advance by the interval (not from "now"), so they don't drift.
+ * Jobs flagged runOnEvent are run on every notification, e.g. button or task queue handling.
+ */
+class Scheduler {
+public:
+    using JobCallback = std::function<void()>;
+
+    static Scheduler *getInstance();
+
+    // Register a job, returns its id. The first run is due immediately.
+    int addJob(const char *name, uint32_t interval, JobCallback callback, bool runOnEvent = false);
+    // Set the next deadline of a job, replaces the periodic deadline (can be called from within the job)
+    void wakeAt(int jobId, unsigned long deadline);
+    // Same as wakeAt(jobId, millis() + delay)
+    void wakeIn(int jobId, uint32_t delay);
+
+    // Run due jobs and sleep until the next deadline or event. Call from loop().
+    void run();
+
+    // Log how late (jitter) and how long each job ran since the last call, then reset the stats
+    void printStats();
+
+    // Wake the main loop to handle an event, safe to call from any task
+    static void notify();
+    // Wake the main loop to handle an event from an interrupt handler
+    static void notifyFromISR();
+
+private:
+    Scheduler();
+
+    struct Job {
+        const char *name;
+        uint32_t interval;
+        unsigned long deadline;
+        JobCallback callback;
+        bool runOnEvent;
+        // Only the heap entry pushed last is live, older ones are skipped
+        uint32_t generation;
+        // A live entry is in the heap
+        bool queued;
+        // Timing stats since the last printStats()
+        uint32_t runs;
+        uint32_t totalLate;
+        uint32_t maxLate;
+        uint32_t maxDuration;
+    };
+
+    struct HeapEntry {
+        unsigned long deadline;
+        int jobId;
+        uint32_t generation;
+    };
+
+    static Scheduler *s_instance;
+    static TaskHandle_t s_loopTask;
+
+    std::vector<Job> m_jobs;
+    std::vector<HeapEntry> m_heap;
+    std::vector<int> m_due;
+    unsigned long m_lastStats = 0;
+
+    void push(int jobId);
+    void runJob(int jobId, unsigned long now);
+    static bool isBefore(unsigned long a, unsigned long b);
+};
+
+#endif // SCHEDULER_H
@@ -1,4 +1,6 @@
 #include "ShowMemoryUsage.h"
+#include "FrameString.h"
+#include "StringPool.h"
 
 #include "config_helper.h"
 #include <Arduino.h>
@@ -17,7 +19,11 @@ void ShowMemoryUsage::printSerial(bool force, bool newLine) {
     if (force || (!s_lastMemoryUsageShownAt || (millis() - s_lastMemoryUsageShownAt >= interval_ms))) {
         heap_caps_get_info(&info, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
         size_t total = heap_caps_get_total_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
-        Serial.printf("total: %d, allocated: %d, totalFree: %d, minFree: %d, largestFree: %d%s", total, info.total_allocated_bytes, info.total_free_bytes, info.minimum_free_bytes, info.largest_free_block, newLine ? "\n" : "");
+        // blocks = number of live allocations, interned = strings shared by the data models (see StringPool),
+        // frame = peak bytes of temporary strings per loop pass and heap fallbacks (see FrameArena)
+        Serial.printf("total: %d, allocated: %d, blocks: %d, totalFree: %d, minFree: %d, largestFree: %d, interned: %d (%d bytes), frame: %d/%d (%d overflows)%s",
+                      total, info.total_allocated_bytes, info.allocated_blocks, info.total_free_bytes, info.minimum_free_bytes, info.largest_free_block,
+                      StringPool::getCount(), StringPool::getBytes(), FrameArena::getPeak(), FRAME_ARENA_SIZE, FrameArena::getOverflows(), newLine ? "\n" : "");
         s_lastMemoryUsageShownAt = millis();
     }
 }
@@ -0,0 +1,66 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <stddef.h>
+#include <utility>
+
+/**
+ * Lock-free single-producer/single-consumer ring buffer with a fixed capacity.
+ *
+ * Exactly one task may call push() and exactly one task may call pop()/peek()/size()
+ * (they may be the same task, and they may run on different cores).
+ * Items are stored by value in preallocated slots, nothing is allocated at runtime.
+ */
+template <typename T, size_t N>
+class SpscRing {
+public:
+    // Producer: returns false if the ring is full
+    bool push(T item) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t next = advance(head);
+        if (next == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        m_items[head] = std::move(item);
+        m_head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: returns false if the ring is empty
+    bool pop(T &item) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(m_items[tail]);
+        m_items[tail] = T(); // Release resources held by the slot
+        m_tail.store(advance(tail), std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: i-th item from the front, i must be < size()
+    const T &peek(size_t i) const {
+        size_t index = m_tail.load(std::memory_order_relaxed) + i;
+        return m_items[index % (N + 1)];
+    }
+
+    size_t size() const {
+        size_t head = m_head.load(std::memory_order_acquire);
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        return head >= tail ? head - tail : head + N + 1 - tail;
+    }
+
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return N; }
+
+private:
+    static size_t advance(size_t index) { return index == N ? 0 : index + 1; }
+
+    // One slot stays empty to tell "full" from "empty"
+    T m_items[N + 1];
+    std::atomic<size_t> m_head{0};
+    std::atomic<size_t> m_tail{0};
+};
+
+#endif // SPSC_RING_H
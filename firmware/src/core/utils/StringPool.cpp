@@ -0,0 +1,24 @@
+#include "StringPool.h"
+#include <ArduinoLog.h>
+
+std::vector<const char *> StringPool::s_entries;
+size_t StringPool::s_bytes = 0;
+
+const char *StringPool::intern(const char *value) {
+    if (value == nullptr || value[0] == '\0') {
+        return "";
+    }
+    for (const char *entry : s_entries) {
+        if (strcmp(entry, value) == 0) {
+            return entry;
+        }
+    }
+    const char *entry = strdup(value);
+    if (entry == nullptr) {
+        Log.errorln("StringPool: out of memory");
+        return "";
+    }
+    s_entries.push_back(entry);
+    s_bytes += strlen(entry) + 1;
+    return entry;
+}
@@ -0,0 +1,49 @@
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <Arduino.h>
+#include <vector>
+
+/**
+ * Interns strings that repeat across and within data models (currency symbols, icon
+ * names, team colors, ...), so each distinct value is stored once. Entries are never
+ * freed, only intern values from a small, bounded set. Main loop only.
+ */
+class StringPool {
+public:
+    // Returns the pooled copy of value, the pointer stays valid forever
+    static const char *intern(const char *value);
+
+    static size_t getCount() { return s_entries.size(); }
+    static size_t getBytes() { return s_bytes; }
+
+private:
+    static std::vector<const char *> s_entries;
+    static size_t s_bytes;
+};
+
+// Reference to a pooled string, copying it is free
+class InternedString {
+public:
+    InternedString() = default;
+    InternedString(const char *value) : m_data(StringPool::intern(value)) {}
+    InternedString(const String &value) : m_data(StringPool::intern(value.c_str())) {}
+
+    const char *c_str() const { return m_data; }
+    operator const char *() const { return m_data; }
+    String toString() const { return String(m_data); }
+    size_t length() const { return strlen(m_data); }
+    bool isEmpty() const { return m_data[0] == '\0'; }
+
+    // Pooled values are unique, so equal strings have the same pointer
+    bool operator==(const InternedString &other) const { return m_data == other.m_data || (isEmpty() && other.isEmpty()); }
+    bool operator==(const char *other) const { return strcmp(m_data, other ? other : "") == 0; }
+    bool operator==(const String &other) const { return strcmp(m_data, other.c_str()) == 0; }
+    template <typename T>
+    bool operator!=(const T &other) const { return !(*this == other); }
+
+private:
+    const char *m_data = "";
+};
+
+#endif // STRING_POOL_H
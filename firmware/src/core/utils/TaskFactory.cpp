@@ -54,11 +54,8 @@ void TaskFactory::httpGetTask(const String &url, Task::ResponseCallback callback
             preProcess(httpCode, response);
         }
 
-        auto *responseData = new TaskManager::ResponseData{httpCode, response, callback};
-
-        if (xQueueSend(TaskManager::responseQueue, &responseData, 0) != pdPASS) {
+        if (!TaskManager::queueResponse(httpCode, std::move(response), callback)) {
             Log.errorln("Failed to queue response");
-            delete responseData; // Ensure cleanup if queueing fails
         }
     }
     TaskManager::activeRequests--;
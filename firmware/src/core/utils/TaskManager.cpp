@@ -1,24 +1,19 @@
 #include "TaskManager.h"
 #include "GlobalResources.h"
+#include "Scheduler.h"
 #include "Utils.h"
 #include <ArduinoLog.h>
 #include <HTTPClient.h>
 #include <memory>
 
 TaskManager *TaskManager::instance = nullptr;
-QueueHandle_t TaskManager::requestQueue = nullptr;
-QueueHandle_t TaskManager::responseQueue = nullptr;
+SpscRing<TaskManager::TaskParams *, TaskManager::REQUEST_QUEUE_SIZE> TaskManager::requestQueue;
+SpscRing<TaskManager::ResponseData, TaskManager::RESPONSE_QUEUE_SIZE> TaskManager::responseQueue;
 volatile uint32_t TaskManager::activeRequests = 0;
 volatile uint32_t TaskManager::maxConcurrentRequests = 0;
 int TaskManager::taskParamsCount = 0;
 
 TaskManager::TaskManager() {
-    if (!requestQueue) {
-        requestQueue = xQueueCreate(REQUEST_QUEUE_SIZE, REQUEST_QUEUE_ITEM_SIZE);
-    }
-    if (!responseQueue) {
-        responseQueue = xQueueCreate(RESPONSE_QUEUE_SIZE, RESPONSE_QUEUE_ITEM_SIZE);
-    }
 }
 
 TaskManager *TaskManager::getInstance() {
@@ -40,7 +35,7 @@ bool TaskManager::addTask(std::unique_ptr<Task> task) {
     Log.noticeln("TaskParams created: %d", taskParamsCount);
 #endif
 
-    if (xQueueSend(requestQueue, &params, 0) != pdPASS) {
+    if (!requestQueue.push(params)) {
         delete params;
         taskParamsCount--;
 #ifdef TASKMANAGER_DEBUG
@@ -49,12 +44,14 @@ bool TaskManager::addTask(std::unique_ptr<Task> task) {
         return false;
     }
 
+    // Wake the main loop to start the task
+    Scheduler::notify();
     return true;
 }
 
 void TaskManager::processAwaitingTasks() {
     // First check if there are any requests to process
-    if (uxQueueMessagesWaiting(requestQueue) == 0) {
+    if (requestQueue.empty()) {
         return; // No requests in queue
     }
 
@@ -75,7 +72,7 @@ void TaskManager::processAwaitingTasks() {
 
     // Get next request
     TaskParams *taskParams = nullptr;
-    if (xQueueReceive(requestQueue, &taskParams, 0) != pdPASS) {
+    if (!requestQueue.pop(taskParams)) {
         Log.noticeln("⚠️ Queue empty after size check!");
         activeRequests--;
         Utils::setBusy(false);
@@ -86,11 +83,11 @@ void TaskManager::processAwaitingTasks() {
 #ifdef TASKMANAGER_DEBUG
     Log.noticeln("Processing request: %s (Remaining in queue: %d)",
                  taskParams->url.c_str(),
-                 uxQueueMessagesWaiting(requestQueue));
+                 requestQueue.size());
 #endif
 
     TaskHandle_t taskHandle;
-    BaseType_t result = xTaskCreate(
+    BaseType_t result = xTaskCreatePinnedToCore(
         [](void *params) {
             auto *taskParams = static_cast<TaskParams *>(params);
             taskParams->taskExec();
@@ -101,13 +98,16 @@ void TaskManager::processAwaitingTasks() {
             Utils::setBusy(false);
             Log.noticeln("✅ Release semaphore");
             xSemaphoreGive(taskSemaphore);
+            // Wake the main loop to process the response and start the next task
+            Scheduler::notify();
             vTaskDelete(nullptr);
         },
         "TASK_EXEC",
         STACK_SIZE,
         taskParams,
         TASK_PRIORITY,
-        &taskHandle);
+        &taskHandle,
+        TASKMANAGER_CORE);
 
     if (result != pdPASS) {
         Log.errorln("Failed to create HTTP request task");
@@ -130,27 +130,21 @@ void TaskManager::processTaskResponses() {
     }
 #endif
 
-    if (uxQueueMessagesWaiting(responseQueue) == 0) {
-        return;
+    ResponseData responseData;
+    while (responseQueue.pop(responseData)) {
+        responseData.callback(responseData.httpCode, responseData.response);
     }
+}
 
-    ResponseData *responseData;
-    while (xQueueReceive(responseQueue, &responseData, 0) == pdPASS) {
-        responseData->callback(responseData->httpCode, responseData->response);
-        delete responseData; // Ensure the object is deleted after processing
-    }
+bool TaskManager::queueResponse(int httpCode, String &&response, ResponseCallback callback) {
+    return responseQueue.push({httpCode, std::move(response), callback});
 }
 
 bool TaskManager::isUrlInQueue(const String &url) {
-    UBaseType_t queueLength = uxQueueMessagesWaiting(requestQueue);
-    for (UBaseType_t i = 0; i < queueLength; i++) {
-        TaskParams *taskParams;
-        if (xQueuePeek(requestQueue, &taskParams, 0) == pdPASS) {
-            if (taskParams->url == url) {
-                return true;
-            }
-            xQueueReceive(requestQueue, &taskParams, 0);
-            xQueueSend(requestQueue, &taskParams, 0);
+    size_t queueLength = requestQueue.size();
+    for (size_t i = 0; i < queueLength; i++) {
+        if (requestQueue.peek(i)->url == url) {
+            return true;
         }
     }
     return false;
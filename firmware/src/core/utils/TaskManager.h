@@ -7,9 +7,14 @@
 #include <freertos/queue.h>
 #include <freertos/semphr.h>
 #include <freertos/task.h>
+#include "SpscRing.h"
 #include <functional>
 #include <memory>
 
+#ifndef TASKMANAGER_CORE
+    #define TASKMANAGER_CORE 0 // Network tasks run on the PRO core next to WiFi/LwIP, rendering stays on the loop task (core 1)
+#endif
+
 // Forward declaration of TaskManager to avoid circular dependencies
 class TaskManager;
 
@@ -57,18 +62,19 @@ public:
     void processAwaitingTasks();
     void processTaskResponses();
 
+    // Called by task implementations to hand a response to the main loop
+    static bool queueResponse(int httpCode, String &&response, ResponseCallback callback);
+
     // Declare static members as extern
     static volatile uint32_t activeRequests;
     static volatile uint32_t maxConcurrentRequests;
-    static QueueHandle_t requestQueue;
-    static QueueHandle_t responseQueue;
-
-    // Add destructor
-    ~TaskManager() {
-        // Clean up queues
-        vQueueDelete(requestQueue);
-        vQueueDelete(responseQueue);
-    }
+
+    static const size_t REQUEST_QUEUE_SIZE = 20;
+    static const size_t RESPONSE_QUEUE_SIZE = 20;
+    // Requests are added and taken by the main loop.
+    // Responses are added by the running task (only one at a time, see taskSemaphore) and taken by the main loop.
+    static SpscRing<TaskParams *, REQUEST_QUEUE_SIZE> requestQueue;
+    static SpscRing<ResponseData, RESPONSE_QUEUE_SIZE> responseQueue;
 
     // Add a debug function to check for leaks
     static void checkForLeaks() {
@@ -85,11 +91,6 @@ private:
 
     static const uint16_t STACK_SIZE = 6000;
     static const UBaseType_t TASK_PRIORITY = 1;
-    static const UBaseType_t REQUEST_QUEUE_SIZE = 20;
-    static const UBaseType_t REQUEST_QUEUE_ITEM_SIZE = sizeof(TaskParams *);
-    static const UBaseType_t RESPONSE_QUEUE_SIZE = 20;
-    static const UBaseType_t RESPONSE_QUEUE_ITEM_SIZE = sizeof(ResponseData *);
-    static const TickType_t QUEUE_CHECK_DELAY = pdMS_TO_TICKS(100); // 100ms between queue checks
     bool isUrlInQueue(const String &url);
     static int taskParamsCount;
 };
@@ -15,78 +15,6 @@ struct GrayscaleToTargetColorCache {
 
 GrayscaleToTargetColorCache grayscaleToTargetColorCache; // Global cache for grayscaleToTargetColor
 
-int Utils::getWrappedLines(String (&lines)[MAX_WRAPPED_LINES], String str, int limit) {
-    char buf[str.length() + 1];
-    char lineBuf[limit + 1];
-    str.toCharArray(buf, str.length() + 1);
-
-    char *p = buf;
-    char *eol;
-    int lineCount = 0;
-    for (int i = 0; i < MAX_WRAPPED_LINES; i++) {
-        if (p - buf > strlen(buf)) {
-            lines[i] = "";
-            continue;
-        }
-        eol = strchr(p, '\n');
-        if (eol == NULL) {
-            eol = p + strlen(p);
-        }
-
-        if (eol - p > limit) {
-            eol = p + limit;
-            while (*eol != ' ' && *eol != '\n' && eol > p) {
-                eol--;
-            }
-        }
-        strncpy(lineBuf, p, eol - p);
-        lineBuf[eol - p] = '\0';
-
-        lines[i] = String(lineBuf);
-        lineCount++;
-        p = eol + 1;
-    }
-    return lineCount;
-}
-
-String Utils::getWrappedLine(String str, int limit, int lineNum, int maxLines) {
-    if (lineNum > maxLines) {
-        return "";
-    }
-    char buf[str.length() + 1];
-    char lineBuf[limit + 1];
-    str.toCharArray(buf, str.length() + 1);
-
-    String lines[maxLines];
-
-    char *p = buf;
-    char *eol;
-
-    for (int i = 0; i < maxLines && i <= lineNum; i++) {
-        if (p - buf > strlen(buf)) {
-            lines[i] = "";
-            continue;
-        }
-        eol = strchr(p, '\n');
-        if (eol == NULL) {
-            eol = p + strlen(p);
-        }
-
-        if (eol - p > limit) {
-            eol = p + limit;
-            while (*eol != ' ' && *eol != '\n' && eol > p) {
-                eol--;
-            }
-        }
-        strncpy(lineBuf, p, eol - p);
-        lineBuf[eol - p] = '\0';
-
-        lines[i] = String(lineBuf);
-        p = eol + 1;
-    }
-    return lines[lineNum];
-}
-
 int32_t Utils::stringToColor(String color) {
     color.toLowerCase();
     color.replace(" ", "");
@@ -144,10 +72,10 @@ int32_t Utils::stringToColor(String color) {
     }
 }
 
-String Utils::formatFloat(float value, int8_t digits) {
+FrameString Utils::formatFloat(float value, int8_t digits) {
     char tmp[30] = {};
     dtostrf(value, 1, digits, tmp);
-    return tmp;
+    return FrameString(tmp);
 }
 
 int32_t Utils::stringToAlignment(String alignment) {
@@ -232,6 +160,20 @@ void Utils::rgb565dimBitmap(uint16_t *pixel565, size_t length, uint8_t brightnes
     }
 }
 
+// Same blending as OpenFontRender, so cached glyphs look exactly like rendered ones
+uint16_t Utils::rgb565alphaBlend(uint8_t alpha, uint16_t fg565, uint16_t bg565) {
+    uint16_t fgR = ((fg565 >> 10) & 0x3E) + 1;
+    uint16_t fgG = ((fg565 >> 4) & 0x7E) + 1;
+    uint16_t fgB = ((fg565 << 1) & 0x3E) + 1;
+    uint16_t bgR = ((bg565 >> 10) & 0x3E) + 1;
+    uint16_t bgG = ((bg565 >> 4) & 0x7E) + 1;
+    uint16_t bgB = ((bg565 << 1) & 0x3E) + 1;
+    uint16_t r = (((fgR * alpha) + (bgR * (255 - alpha))) >> 9);
+    uint16_t g = (((fgG * alpha) + (bgG * (255 - alpha))) >> 9);
+    uint16_t b = (((fgB * alpha) + (bgB * (255 - alpha))) >> 9);
+    return (r << 11) | (g << 5) | (b << 0);
+}
+
 // Function to extract R, G, B from a 16-bit RGB565 pixel
 uint32_t Utils::rgb565ToRgb888(uint16_t rgb565, bool swapBytes) {
     uint8_t r, g, b;
@@ -411,6 +353,14 @@ ButtonState Utils::stringToButtonState(const String &buttonState) {
     }
 }
 
+uint32_t Utils::hash(const String &str) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < str.length(); i++) {
+        hash = (hash ^ (uint8_t) str[i]) * 16777619u;
+    }
+    return hash;
+}
+
 void Utils::setBusy(bool busy) {
     if (busy) {
         digitalWrite(BUSY_PIN, HIGH);
@@ -2,10 +2,9 @@
 #define UTILS_H
 
 #include "Button.h"
+#include "FrameString.h"
 #include <Arduino.h>
 
-#define MAX_WRAPPED_LINES 10
-
 enum ScreenMode {
     Light = 0,
     Dark = 1
@@ -55,14 +54,13 @@ enum class TimeFrequency : unsigned long {
 class Utils {
 public:
     static void setBusy(bool busy);
-    static int getWrappedLines(String (&lines)[MAX_WRAPPED_LINES], String str, int limit);
-    static String getWrappedLine(String str, int limit, int lineNum, int maxLines);
     static int32_t stringToColor(String color);
-    static String formatFloat(float value, int8_t digits);
+    static FrameString formatFloat(float value, int8_t digits);
     static int32_t stringToAlignment(String alignment);
 
     static uint16_t rgb565dim(uint16_t rgb565, uint8_t brightness, bool swapBytes = false);
     static void rgb565dimBitmap(uint16_t *pixel565, size_t length, uint8_t brightness, bool swapBytes = true);
+    static uint16_t rgb565alphaBlend(uint8_t alpha, uint16_t fg565, uint16_t bg565);
     static uint32_t rgb565ToRgb888(uint16_t rgb565, bool swapBytes = false);
     static uint16_t rgb888ToRgb565(uint32_t rgb888, bool swapBytes = false);
     static String rgb565ToRgb888html(int color565);
@@ -73,6 +71,9 @@ public:
     static Buttons stringToButtonId(const String &buttonName);
     static ButtonState stringToButtonState(const String &buttonState);
 
+    // FNV-1a hash, e.g. to detect changed responses
+    static uint32_t hash(const String &str);
+
     /**
      * Create a new char buffer and copy the contents of the string into it.
      * Warning: This will allocate memory! Remeber to delete[] it after use.
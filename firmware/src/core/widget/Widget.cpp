@@ -1,4 +1,7 @@
 #include "Widget.h"
+#include "DataSnapshot.h"
+#include <ArduinoLog.h>
+#include <algorithm>
 
 Widget::Widget(ScreenManager &manager, ConfigManager &config)
     : m_manager(manager),
@@ -6,6 +9,60 @@ Widget::Widget(ScreenManager &manager, ConfigManager &config)
       m_drawTimer(nullptr),
       m_updateTimer(nullptr) {}
 
+bool Widget::drawStep(bool force, uint8_t step) {
+    draw(force);
+    return true;
+}
+
+bool Widget::takeRedrawRequest() {
+    bool requested = m_redrawRequested;
+    m_redrawRequested = false;
+    return requested;
+}
+
+void Widget::requestRedraw() {
+    m_redrawRequested = true;
+}
+
+void Widget::snapshotRestored(const SnapshotReader &reader) {
+    m_restoredAt = reader.getSavedAt();
+    m_restoredAgeUnknown = !reader.isAgeKnown();
+}
+
+void Widget::dataRefreshed() {
+    m_restoredAgeUnknown = false;
+}
+
+void Widget::checkRestoredAge() {
+    if (!m_restoredAgeUnknown) {
+        return;
+    }
+    m_restoredAgeUnknown = false;
+    if (SnapshotReader::isOutdated(m_restoredAt) && m_updateTimer) {
+        // Refetched on the next update, right away if the widget is on screen
+        Log.infoln("Restored data of %s is outdated, refetching it", getName().c_str());
+        m_updateTimer->expire();
+    }
+}
+
+void Widget::prefetch() {
+    if (isItTimeToUpdate()) {
+        update();
+    }
+}
+
+bool Widget::restoreSnapshot() {
+    return false;
+}
+
+bool Widget::hibernate() {
+    return false;
+}
+
+void Widget::resume() {
+    restoreSnapshot();
+}
+
 WidgetTimer &Widget::addDrawRefreshFrequency(TimeFrequency frequency) {
     if (m_drawTimer) {
         delete m_drawTimer;
@@ -52,6 +109,13 @@ bool Widget::isItTimeToUpdate() {
     return true;
 }
 
+uint32_t Widget::getMillisUntilDue() const {
+    if (!m_drawTimer || !m_updateTimer) {
+        return 0;
+    }
+    return std::min(m_drawTimer->getMillisUntilDue(), m_updateTimer->getMillisUntilDue());
+}
+
 unsigned long Widget::getLastDrawTime() const {
     if (m_drawTimer) {
         return m_drawTimer->getInterval(); // Return the last time isDue() returned true
@@ -7,6 +7,7 @@
 #include "Translations.h" // include for use by all Widgets
 #include "config_helper.h"
 
+class SnapshotReader;
 class WidgetTimer;
 
 class Widget {
@@ -16,9 +17,33 @@ public:
     virtual void setup() = 0;
     virtual void update(bool force = false) = 0;
     virtual void draw(bool force = false) = 0;
+    // Resumable drawing: widgets with long redraws draw one orb (or region) per step.
+    // WidgetSet calls this with step 0, 1, 2, ... until it returns true and yields to the
+    // main loop between steps when WIDGET_DRAW_BUDGET is used up. Default: draw() in one step.
+    virtual bool drawStep(bool force, uint8_t step);
+    // Called shortly before the widget is cycled in. Must not draw.
+    // Default: update the data if it's due, widgets can also precompute layout here.
+    virtual void prefetch();
+    // Called once at boot before the first update. Widgets that persist their data model
+    // (see DataSnapshot) restore it here and return true if they have data to show.
+    virtual bool restoreSnapshot();
+    // Called when the widget has been off screen for WIDGET_HIBERNATE_DELAY. Widgets free their
+    // heap-allocated data models and buffers here if they can get them back later (e.g. from their
+    // snapshot) and return true. Inline data (FixedString, fixed arrays) frees nothing, keep it.
+    // Default: keep everything.
+    virtual bool hibernate();
+    // Called before a hibernated widget is used again. Default: restoreSnapshot()
+    virtual void resume();
     virtual void buttonPressed(uint8_t buttonId, ButtonState state) = 0;
     virtual String getName() = 0;
 
+    // Set by requestRedraw(), WidgetSet restarts the stepped draw with force (cancelling pending steps)
+    bool isRedrawRequested() const { return m_redrawRequested; }
+    bool takeRedrawRequest();
+
+    // Called by WidgetSet once the time is synced, restored data that turns out to be outdated is refetched
+    void checkRestoredAge();
+
     WidgetTimer &addDrawRefreshFrequency(TimeFrequency frequency);
     WidgetTimer &addUpdateRefreshFrequency(TimeFrequency frequency);
     void resetTimer(WidgetTimer &timer);
@@ -28,15 +53,27 @@ public:
 
     bool isItTimeToDraw();
     bool isItTimeToUpdate();
+    // Time until the next draw or update is due (0 if the widget has no timer)
+    uint32_t getMillisUntilDue() const;
 
     // New methods to get last trigger times
     unsigned long getLastDrawTime() const; // Time of last draw trigger
     unsigned long getLastUpdateTime() const; // Time of last update trigger
 
 protected:
+    // Ask for a forced redraw instead of calling draw(true), e.g. to show the next page
+    void requestRedraw();
+    // Widgets with snapshots call these after restoring one and when fresh data replaced it,
+    // so data restored before the time was synced can be checked for its age later
+    void snapshotRestored(const SnapshotReader &reader);
+    void dataRefreshed();
+
     ScreenManager &m_manager;
     ConfigManager &m_config;
     bool m_enabled = false;
+    bool m_redrawRequested = false;
+    time_t m_restoredAt = 0;
+    bool m_restoredAgeUnknown = false;
 
     WidgetTimer *m_drawTimer = nullptr;
     WidgetTimer *m_updateTimer = nullptr;
@@ -49,16 +86,31 @@ public:
     bool isDue() {
         unsigned long currentMillis = millis();
         if (currentMillis - m_previousMillis >= m_interval) {
-            m_previousMillis = currentMillis;
+            // Advance by the interval so the timer doesn't drift,
+            // but don't try to catch up if we missed more than one interval
+            m_previousMillis += m_interval;
+            if (currentMillis - m_previousMillis >= m_interval) {
+                m_previousMillis = currentMillis;
+            }
             return true;
         }
         return false;
     }
 
+    uint32_t getMillisUntilDue() const {
+        unsigned long elapsed = millis() - m_previousMillis;
+        return elapsed >= m_interval ? 0 : m_interval - elapsed;
+    }
+
     void reset() {
         m_previousMillis = millis();
     }
 
+    // Due on the next isDue()
+    void expire() {
+        m_previousMillis = millis() - m_interval;
+    }
+
     uint32_t getInterval() const { return m_interval; }
     void setInterval(uint32_t interval) { m_interval = interval; }
 
@@ -1,4 +1,5 @@
 #include "WidgetRegistry.h"
+#include <ArduinoLog.h>
 
 // Include widget headers, always wrap them in a check for WIDGET_DISABLED
 // to avoid including them in the build if they are disabled
@@ -32,45 +33,90 @@
 #if INCLUDE_BASEBALL != WIDGET_DISABLED
     #include "baseballwidget/BaseballWidget.h"
 #endif
-void registerWidgets(WidgetSet *widgetSet, ScreenManager *sm, ConfigManager *config) {
+
+template <typename T>
+static Widget *createWidget(ScreenManager &sm, ConfigManager &config) {
+    return new T(sm, config);
+}
+
+// Settings of a disabled widget, so they can be edited before it is enabled
+template <typename T>
+static void addSettings(ConfigManager &config) {
+    static T s_settings;
+    s_settings.addConfig(config);
+}
+
+// All compiled-in widgets in the order they are cycled
+static const WidgetFactory s_widgetFactories[] = {
     // Always add clock widget
-    // widgetSet->add(new ClockWidget(*sm, *config));
+    // {"ClockWidget", nullptr, true, createWidget<ClockWidget>, nullptr},
 
 // Add other widgets based on compile-time flags, and only if they are not disabled
 #if INCLUDE_WEATHER != WIDGET_DISABLED
-    widgetSet->add(new WeatherWidget(*sm, *config));
+    {"WeatherWidget", "weatherEnabled", INCLUDE_WEATHER == WIDGET_ON, createWidget<WeatherWidget>, addSettings<WeatherSettings>},
 #endif
 
 #if INCLUDE_STOCK != WIDGET_DISABLED
-    widgetSet->add(new StockWidget(*sm, *config));
+    {"StockWidget", "stocksEnabled", INCLUDE_STOCK == WIDGET_ON, createWidget<StockWidget>, addSettings<StockSettings>},
 #endif
 
 #if INCLUDE_PARQET != WIDGET_DISABLED
-    widgetSet->add(new ParqetWidget(*sm, *config));
+    {"ParqetWidget", "pqEnabled", INCLUDE_PARQET == WIDGET_ON, createWidget<ParqetWidget>, addSettings<ParqetSettings>},
 #endif
 
 #if INCLUDE_WEBDATA != WIDGET_DISABLED
     #ifdef WEB_DATA_WIDGET_URL
-    widgetSet->add(new WebDataWidget(*sm, *config, WEB_DATA_WIDGET_URL));
+    {"WebDataWidget", nullptr, true, [](ScreenManager &sm, ConfigManager &config) -> Widget * { return new WebDataWidget(sm, config, WEB_DATA_WIDGET_URL); }, nullptr},
     #endif
     #ifdef WEB_DATA_STOCK_WIDGET_URL
-    widgetSet->add(new WebDataWidget(*sm, *config, WEB_DATA_STOCK_WIDGET_URL));
+    {"WebDataWidget", nullptr, true, [](ScreenManager &sm, ConfigManager &config) -> Widget * { return new WebDataWidget(sm, config, WEB_DATA_STOCK_WIDGET_URL); }, nullptr},
     #endif
 #endif
 
 #if INCLUDE_MQTT != WIDGET_DISABLED
-    widgetSet->add(new MQTTWidget(*sm, *config));
+    {"MqttWidget", "mqttEnabled", INCLUDE_MQTT == WIDGET_ON, createWidget<MQTTWidget>, addSettings<MQTTSettings>},
 #endif
 
 #if INCLUDE_5ZONE != WIDGET_DISABLED
-    widgetSet->add(new FiveZoneWidget(*sm, *config));
+    {"FiveZoneWidget", "5zoEnabled", INCLUDE_5ZONE == WIDGET_ON, createWidget<FiveZoneWidget>, addSettings<FiveZoneSettings>},
 #endif
 
 #if INCLUDE_MATRIXSCREEN != WIDGET_DISABLED
-    widgetSet->add(new MatrixWidget(*sm, *config));
+    {"MatrixWidget", "mtxEnabled", INCLUDE_MATRIXSCREEN == WIDGET_ON, createWidget<MatrixWidget>, addSettings<MatrixSettings>},
 #endif
 
 #if INCLUDE_BASEBALL != WIDGET_DISABLED
-    widgetSet->add(new BaseballWidget(*sm, *config));
+    {"BaseballWidget", "baseballEnabled", INCLUDE_BASEBALL == WIDGET_ON, createWidget<BaseballWidget>, addSettings<BaseballSettings>},
 #endif
+
+    // End marker, keeps the array valid if all widgets are compiled out
+    {nullptr, nullptr, false, nullptr, nullptr}};
+
+static const size_t s_widgetFactoryCount = sizeof(s_widgetFactories) / sizeof(s_widgetFactories[0]) - 1;
+
+// Values of the enable toggles of widgets that are not constructed
+static bool s_disabledToggles[s_widgetFactoryCount + 1];
+
+void registerWidgets(WidgetSet *widgetSet, ScreenManager *sm, ConfigManager *config) {
+    for (size_t i = 0; i < s_widgetFactoryCount; i++) {
+        const WidgetFactory &factory = s_widgetFactories[i];
+        bool enabled = factory.enabledKey == nullptr || config->getConfigBool(factory.enabledKey, factory.enabledByDefault);
+        if (enabled && widgetSet->isFull()) {
+            Log.warningln("MAX WIDGETS UNABLE TO ADD %s", factory.section);
+            enabled = false;
+        }
+        if (!enabled) {
+            if (factory.enabledKey != nullptr) {
+                // Enabling the widget takes effect after the restart
+                s_disabledToggles[i] = factory.enabledByDefault;
+                config->addConfigBool(factory.section, factory.enabledKey, &s_disabledToggles[i], t_enableWidget);
+            }
+            if (factory.addConfig != nullptr) {
+                factory.addConfig(*config);
+            }
+            Log.infoln("Widget %s is disabled", factory.section);
+            continue;
+        }
+        widgetSet->add(factory.create(*sm, *config));
+    }
 }
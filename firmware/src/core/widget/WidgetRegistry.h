@@ -5,7 +5,18 @@
 #include "ScreenManager.h"
 #include "WidgetSet.h"
 
-// Registers all widgets with the widget set.
+// Describes a compiled-in widget without constructing it
+struct WidgetFactory {
+    const char *section; // Config section of the widget
+    const char *enabledKey; // Config key of the enable toggle, nullptr if the widget has none
+    bool enabledByDefault;
+    Widget *(*create)(ScreenManager &sm, ConfigManager &config);
+    // Adds the widget's settings to the portal while it is disabled, nullptr if it has none
+    void (*addConfig)(ConfigManager &config);
+};
+
+// Registers all widgets with the widget set. Only enabled widgets are constructed, disabled
+// ones add their enable toggle and settings to the portal, backed by their settings struct.
 void registerWidgets(WidgetSet *widgetSet, ScreenManager *sm, ConfigManager *config);
 
 #endif // WIDGET_REGISTRY_H
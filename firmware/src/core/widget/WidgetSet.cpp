@@ -1,4 +1,6 @@
 #include "WidgetSet.h"
+#include "DrawStats.h"
+#include "GlobalTime.h"
 #include <ArduinoLog.h>
 
 WidgetSet::WidgetSet(ScreenManager *sm) : m_screenManager(sm) {
@@ -14,41 +16,156 @@ void WidgetSet::add(Widget *widget) {
         return;
     }
     m_widgets[m_widgetCount] = widget;
+    m_names[m_widgetCount] = widget->getName();
     m_widgets[m_widgetCount]->setup();
     m_widgetCount++;
 }
 
 void WidgetSet::drawCurrent(bool force) {
     Widget *currentWidget = m_widgets[m_currentWidget];
-    if (force || currentWidget->isItTimeToDraw()) {
-        Log.traceln("Drawing widget: %s", currentWidget->getName().c_str());
+    if (currentWidget->takeRedrawRequest()) {
+        force = true;
+    }
+    // A forced draw restarts an unfinished one, otherwise finish the current draw first
+    if (force || (!m_drawPending && currentWidget->isItTimeToDraw())) {
+        Log.traceln("Drawing widget: %s", m_names[m_currentWidget].c_str());
+        DrawStats::beginFrame(m_names[m_currentWidget].c_str());
         if (currentWidget->isItTimeToUpdate()) {
             currentWidget->update();
         }
         if (m_clearScreensOnDrawCurrent) {
             m_screenManager->clearAllScreens();
             m_clearScreensOnDrawCurrent = false;
-            currentWidget->draw(true);
-        } else {
-            currentWidget->draw(force);
+            force = true;
         }
+        beginDraw(force);
+    }
+    continueDraw();
+}
+
+void WidgetSet::beginDraw(bool force) {
+    m_drawPending = true;
+    m_drawForce = force;
+    m_drawStep = 0;
+    m_drawStart = millis();
+    if (m_drawStartedCallback) {
+        m_drawStartedCallback();
+    }
+}
+
+bool WidgetSet::continueDraw() {
+    if (!m_drawPending) {
+        return false;
     }
+    uint32_t start = millis();
+    do {
+        if (getCurrent()->drawStep(m_drawForce, m_drawStep++)) {
+            m_drawPending = false;
+            DrawStats::endFrame();
+            if (m_drawForce) {
+                Log.noticeln("Drawing of %s took %d ms (%d steps)", m_names[m_currentWidget].c_str(), millis() - m_drawStart, m_drawStep);
+            }
+            return false;
+        }
+    } while (millis() - start < WIDGET_DRAW_BUDGET);
+    return true;
 }
 
 void WidgetSet::updateCurrent() {
     Widget *currentWidget = m_widgets[m_currentWidget];
+    wake(m_currentWidget);
+    hibernateInactive();
+    checkRestoredAges();
     if (currentWidget->isItTimeToUpdate()) {
-        Log.traceln("Updating widget: %s", currentWidget->getName().c_str());
+        Log.traceln("Updating widget: %s", m_names[m_currentWidget].c_str());
         currentWidget->update();
     }
 }
 
+uint32_t WidgetSet::getMillisUntilDue() {
+    if (m_widgetCount == 0 || isRedrawRequested()) {
+        return 0;
+    }
+    return m_widgets[m_currentWidget]->getMillisUntilDue();
+}
+
 Widget *WidgetSet::getCurrent() {
     return m_widgets[m_currentWidget];
 }
 
+Widget *WidgetSet::getNext() {
+    int8_t next = getNextIndex();
+    return next < 0 ? nullptr : m_widgets[next];
+}
+
+int8_t WidgetSet::getNextIndex() {
+    for (uint8_t i = 1; i < m_widgetCount; i++) {
+        uint8_t index = (m_currentWidget + i) % m_widgetCount;
+        if (m_widgets[index]->isEnabled()) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+void WidgetSet::prefetchNext() {
+    int8_t next = getNextIndex();
+    if (next >= 0) {
+        Log.traceln("Prefetching widget: %s", m_names[next].c_str());
+        // Restoring a hibernated widget reads its snapshot, better now than when it's cycled in
+        wake(next);
+        m_widgets[next]->prefetch();
+    }
+}
+
+void WidgetSet::wake(uint8_t index) {
+    m_lastActive[index] = millis();
+    if (m_hibernating[index]) {
+        Log.infoln("Resuming widget %s", m_names[index].c_str());
+        m_hibernating[index] = false;
+        m_widgets[index]->resume();
+    }
+}
+
+void WidgetSet::checkRestoredAges() {
+    // Snapshots are restored at boot while NTP is still syncing
+    if (m_restoredAgesChecked || GlobalTime::getUnixEpochIfAvailable() == 0) {
+        return;
+    }
+    m_restoredAgesChecked = true;
+    for (uint8_t i = 0; i < m_widgetCount; i++) {
+        if (m_widgets[i]->isEnabled()) {
+            m_widgets[i]->checkRestoredAge();
+        }
+    }
+}
+
+void WidgetSet::hibernateInactive() {
+    if (WIDGET_HIBERNATE_DELAY == 0 || !m_initialized) {
+        return;
+    }
+    uint32_t now = millis();
+    for (uint8_t i = 0; i < m_widgetCount; i++) {
+        if (i == m_currentWidget || m_hibernating[i] || now - m_lastActive[i] < WIDGET_HIBERNATE_DELAY) {
+            continue;
+        }
+        uint32_t freeHeap = ESP.getFreeHeap();
+        if (m_widgets[i]->hibernate()) {
+            Log.infoln("Widget %s hibernated, %d bytes freed", m_names[i].c_str(), (int) (ESP.getFreeHeap() - freeHeap));
+            m_hibernating[i] = true;
+        } else {
+            // Nothing to free (yet), check again after the next delay
+            m_lastActive[i] = now;
+        }
+    }
+}
+
 void WidgetSet::buttonPressed(uint8_t buttonId, ButtonState state) {
     m_widgets[m_currentWidget]->buttonPressed(buttonId, state);
+    if (getCurrent()->isRedrawRequested()) {
+        // Start the redraw now, the main loop continues it in steps
+        drawCurrent();
+    }
 }
 
 void WidgetSet::setClearScreensOnDrawCurrent() {
@@ -81,12 +198,16 @@ void WidgetSet::prev() {
 }
 
 void WidgetSet::switchWidget() {
+    wake(m_currentWidget);
+    // Clearing the screens is part of the new widget's first frame
+    DrawStats::beginFrame(m_names[m_currentWidget].c_str());
     m_screenManager->clearAllScreens();
     getCurrent()->setup();
-    uint32_t start = millis();
-    getCurrent()->draw(true);
-    uint32_t end = millis();
-    Log.noticeln("Drawing of %s took %d ms", getCurrent()->getName().c_str(), (end - start));
+    // The widget is drawn with force anyway
+    getCurrent()->takeRedrawRequest();
+    // Draw the first steps now, the rest is drawn by the main loop in between input and network handling
+    beginDraw(true);
+    continueDraw();
 }
 
 void WidgetSet::showCenteredLine(int screen, const String &text) {
@@ -100,11 +221,14 @@ void WidgetSet::showLoading() {
     showCenteredLine(3, I18n::get(t_loadingData));
 }
 
-void WidgetSet::updateAll() {
+void WidgetSet::updateAll(bool showProgress) {
     for (uint8_t i = 0; i < m_widgetCount; i++) {
         if (m_widgets[i]->isEnabled()) {
-            Log.infoln("updating widget %s", m_widgets[i]->getName().c_str());
-            showCenteredLine(4, m_widgets[i]->getName());
+            Log.infoln("updating widget %s", m_names[i].c_str());
+            if (showProgress) {
+                showCenteredLine(4, m_names[i].toString());
+            }
+            wake(i);
             m_widgets[i]->update();
         }
     }
@@ -115,7 +239,17 @@ bool WidgetSet::initialUpdateDone() {
 }
 
 void WidgetSet::initializeAllWidgetsData() {
-    showLoading();
-    updateAll();
+    bool currentRestored = false;
+    for (uint8_t i = 0; i < m_widgetCount; i++) {
+        if (m_widgets[i]->isEnabled() && m_widgets[i]->restoreSnapshot() && i == m_currentWidget) {
+            currentRestored = true;
+        }
+    }
+    // With restored data the first drawCurrent() shows the last known data,
+    // fresh data is drawn when it arrives
+    if (!currentRestored) {
+        showLoading();
+    }
+    updateAll(!currentRestored);
     m_initialized = true;
 }
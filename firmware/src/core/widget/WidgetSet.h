@@ -2,42 +2,86 @@
 #define WIDGET_SET_H
 
 #include "ScreenManager.h"
+#include "StringPool.h"
 #include "Utils.h"
 #include "Widget.h"
+#include <functional>
 
 #ifndef MAX_WIDGETS
     #define MAX_WIDGETS 5
 #endif
 
+#ifndef WIDGET_HIBERNATE_DELAY
+    #define WIDGET_HIBERNATE_DELAY 900000 // ms off screen before a widget frees its data, 0 to keep all widgets resident
+#endif
+
+#ifndef WIDGET_DRAW_BUDGET
+    #define WIDGET_DRAW_BUDGET 30 // Max ms of drawing before yielding back to the main loop
+#endif
+
 class WidgetSet {
 public:
     WidgetSet(ScreenManager *sm);
     void add(Widget *widget);
+    bool isFull() const { return m_widgetCount == MAX_WIDGETS; }
     void drawCurrent(bool force = false);
+    // Continue an unfinished draw for up to WIDGET_DRAW_BUDGET ms, returns true if more steps are left
+    bool continueDraw();
+    bool isDrawPending() const { return m_drawPending; }
+    // Called whenever a draw starts, so the caller can schedule continueDraw() right away
+    void setDrawStartedCallback(std::function<void()> callback) { m_drawStartedCallback = callback; }
+    // The current widget asked for a forced redraw, drawCurrent() starts it
+    bool isRedrawRequested() const { return m_widgetCount > 0 && m_widgets[m_currentWidget]->isRedrawRequested(); }
     void updateCurrent();
     Widget *getCurrent();
+    // Next enabled widget in the cycle, nullptr if there is no other one
+    Widget *getNext();
+    void prefetchNext();
+    // Lets widgets that have been off screen for WIDGET_HIBERNATE_DELAY free their data
+    void hibernateInactive();
+    // Once the time is synced, lets widgets refetch data they restored before that and that turned out to be outdated
+    void checkRestoredAges();
     void next();
     void prev();
     void buttonPressed(uint8_t buttonId, ButtonState state);
     void showLoading();
-    void updateAll();
+    void updateAll(bool showProgress = true);
     bool initialUpdateDone();
     void initializeAllWidgetsData();
     void setClearScreensOnDrawCurrent();
     bool isItTimeToDraw();
     bool isItTimeToUpdate();
+    uint32_t getMillisUntilDue();
 
 private:
     void showCenteredLine(int screen, const String &text);
     ScreenManager *m_screenManager;
     bool m_clearScreensOnDrawCurrent = true;
     Widget *m_widgets[MAX_WIDGETS];
+    // getName() builds a String, keep a copy for the logs
+    InternedString m_names[MAX_WIDGETS];
     uint8_t m_widgetCount = 0;
     uint8_t m_currentWidget = 0;
 
     bool m_initialized = false;
+    bool m_restoredAgesChecked = false;
+
+    // Hibernation state per widget
+    bool m_hibernating[MAX_WIDGETS] = {};
+    uint32_t m_lastActive[MAX_WIDGETS] = {};
+
+    // State of the current (resumable) draw
+    bool m_drawPending = false;
+    bool m_drawForce = false;
+    uint8_t m_drawStep = 0;
+    uint32_t m_drawStart = 0;
+    std::function<void()> m_drawStartedCallback;
 
+    int8_t getNextIndex();
+    // Marks the widget as in use and restores its data if it was hibernated
+    void wake(uint8_t index);
     void switchWidget();
+    void beginDraw(bool force);
 
 protected:
     WidgetTimer *m_drawTimer = nullptr;
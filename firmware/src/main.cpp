@@ -1,7 +1,10 @@
+#include "BootProfiler.h"
+#include "FrameString.h"
 #include "GlobalResources.h"
 #include "GlobalTime.h"
 #include "MainHelper.h"
 
+#include "Scheduler.h"
 #include "TaskFactory.h"
 #include "WidgetRegistry.h"
 #include "wifiwidget/WifiWidget.h"
@@ -19,6 +22,67 @@ WidgetSet *widgetSet{nullptr};
 const int potPin = 34; // Analog input for potentiometer
 const int pwmPin = 16; // PWM output to driver PWM pin
 
+// Main loop job intervals in ms, see setupScheduler()
+const uint32_t buttonsInterval = 100; // fallback, buttons are handled on interrupt
+const uint32_t tasksInterval = 100; // fallback, tasks are handled when queued/finished
+const uint32_t portalInterval = 20;
+const uint32_t potInterval = 50;
+const uint32_t minFrameInterval = 10; // for widgets that draw continuously
+
+int widgetsJob = -1;
+
+// Buttons, portal requests and network responses can start or request a redraw, draw it right away
+void wakeWidgetsForRedraw() {
+    if (widgetSet != nullptr && (widgetSet->isDrawPending() || widgetSet->isRedrawRequested())) {
+        Scheduler::getInstance()->wakeIn(widgetsJob, 0);
+    }
+}
+
+void setupScheduler() {
+    Scheduler *scheduler = Scheduler::getInstance();
+    scheduler->addJob("time", 1000, []() { globalTime->updateTime(); });
+    scheduler->addJob(
+        "buttons", buttonsInterval, []() {
+            MainHelper::checkButtons();
+            wakeWidgetsForRedraw();
+        },
+        true);
+    widgetsJob = scheduler->addJob("widgets", minFrameInterval, []() {
+        widgetSet->updateCurrent();
+        widgetSet->drawCurrent();
+        if (!widgetSet->isDrawPending() && !BootProfiler::isDone()) {
+            BootProfiler::firstFrame();
+        }
+        if (widgetSet->isDrawPending()) {
+            // Unfinished draw, continue after events and other due jobs were handled
+            Scheduler::getInstance()->wakeIn(widgetsJob, 0);
+        } else {
+            // Sleep until the current widget's next draw or update is due
+            Scheduler::getInstance()->wakeIn(widgetsJob, std::max(widgetSet->getMillisUntilDue(), minFrameInterval));
+        }
+    });
+    // Widget switches, brightness changes and config changes start draws outside the widgets job
+    widgetSet->setDrawStartedCallback([]() { Scheduler::getInstance()->wakeIn(widgetsJob, 0); });
+    scheduler->addJob("brightness", 1000, []() { MainHelper::updateBrightnessByTime(globalTime->getHour24()); });
+    scheduler->addJob("cycle", 1000, []() { MainHelper::checkCycleWidgets(); });
+    scheduler->addJob("portal", portalInterval, []() {
+        wifiManager->process();
+        wakeWidgetsForRedraw();
+    });
+    scheduler->addJob(
+        "tasks", tasksInterval, []() {
+            TaskManager::getInstance()->processAwaitingTasks();
+            TaskManager::getInstance()->processTaskResponses();
+            wakeWidgetsForRedraw();
+        },
+        true);
+    scheduler->addJob("pot", potInterval, []() {
+        int potValue = analogRead(potPin); // Read 0–4095
+        int dutyCycle = map(potValue, 0, 4095, 0, 255); // Map to 0–255
+        ledcWrite(0, dutyCycle); // Set PWM duty cycle
+    });
+}
+
 void setup() {
     ledcSetup(0, 5000, 8); // Channel 0, 5kHz, 8-bit resolution
     ledcAttachPin(pwmPin, 0); // Attach PWM pin
@@ -44,32 +108,51 @@ void setup() {
     Log.noticeln("🚀 Starting up...");
     Log.noticeln("PCB Version: %s", PCB_VERSION);
 
+    // WiFi associates in the background while the display, config and widgets are set up
+    Log.noticeln("Connecting to WiFi");
+    WifiWidget::beginConnect();
+
     wifiManager = new OrbsWiFiManager();
     config = new ConfigManager(*wifiManager);
+    BootProfiler::begin("display");
     sm = new ScreenManager(tft);
+    BootProfiler::end("display");
     widgetSet = new WidgetSet(sm);
 
     // Pass references to MainHelper
     MainHelper::init(wifiManager, config, sm, widgetSet);
+    BootProfiler::begin("littlefs");
     MainHelper::setupLittleFS();
+    BootProfiler::end("littlefs");
+    BootProfiler::begin("config");
     MainHelper::setupConfig();
     MainHelper::setupButtons();
+    BootProfiler::end("config");
     // MainHelper::showWelcome();
 
     pinMode(BUSY_PIN, OUTPUT);
-    Log.noticeln("Connecting to WiFi");
-    wifiWidget = new WifiWidget(*sm, *config, *wifiManager);
-    wifiWidget->setup();
 
+    // Widgets don't need the network to register
+    BootProfiler::begin("widgets");
     globalTime = GlobalTime::getInstance();
-
     registerWidgets(widgetSet, sm, config);
+    BootProfiler::end("widgets");
 
+    BootProfiler::begin("wifi setup");
+    wifiWidget = new WifiWidget(*sm, *config, *wifiManager);
+    wifiWidget->setup();
+    BootProfiler::end("wifi setup");
+
+    BootProfiler::begin("portal");
     config->setupWebPortal();
+    BootProfiler::end("portal");
     MainHelper::resetCycleTimer();
+    setupScheduler();
 }
 
 void loop() {
+    // Temporary strings of the previous pass are no longer referenced
+    FrameArena::reset();
     MainHelper::watchdogReset();
     if (wifiWidget->isConnected() == false) {
         wifiWidget->update();
@@ -78,24 +161,17 @@ void loop() {
         delay(100);
     } else {
         if (!widgetSet->initialUpdateDone()) {
+            // The first NTP exchange runs while the widgets load their data
+            globalTime->syncInBackground();
+            BootProfiler::begin("initial data");
             widgetSet->initializeAllWidgetsData();
+            BootProfiler::end("initial data");
             MainHelper::setupWebPortalEndpoints();
+            // Keep the IP address readable, data keeps loading meanwhile
+            Scheduler::getInstance()->wakeIn(widgetsJob, WIFI_IP_DISPLAY_TIME);
         }
-        globalTime->updateTime();
-
-        MainHelper::checkButtons();
-
-        widgetSet->updateCurrent();
-        MainHelper::updateBrightnessByTime(globalTime->getHour24());
-        widgetSet->drawCurrent();
-
-        MainHelper::checkCycleWidgets();
-        wifiManager->process();
-        TaskManager::getInstance()->processAwaitingTasks();
-        TaskManager::getInstance()->processTaskResponses();
-        int potValue = analogRead(potPin); // Read 0–4095
-        int dutyCycle = map(potValue, 0, 4095, 0, 255); // Map to 0–255
-        ledcWrite(0, dutyCycle); // Set PWM duty cycle
+        // Runs due jobs, then sleeps until the next deadline or event
+        Scheduler::getInstance()->run();
     }
 #ifdef MEMORY_DEBUG_INTERVAL
     ShowMemoryUsage::printSerial();
@@ -4,33 +4,40 @@
 #include <ArduinoJson.h>
 #include <ArduinoLog.h>
 
-FiveZoneWidget::FiveZoneWidget(ScreenManager &manager, ConfigManager &config) : Widget(manager, config),
-                                                                                m_drawTimer(addDrawRefreshFrequency(FIVEZONE_DRAW_DELAY)),
-                                                                                m_updateTimer(addUpdateRefreshFrequency(FIVEZONE_UPDATE_DELAY)) {
-    m_enabled = (INCLUDE_5ZONE == WIDGET_ON);
-    m_time = GlobalTime::getInstance();
-
-    m_config.addConfigBool("FiveZoneWidget", "5zoEnabled", &m_enabled, t_enableWidget);
-    m_config.addConfigBool("FiveZoneWidget", "showBizHours", &m_showBizHours, t_5zoneShowBizHours, false);
+void FiveZoneSettings::addConfig(ConfigManager &config) {
+    config.addConfigBool("FiveZoneWidget", "showBizHours", &m_showBizHours, t_5zoneShowBizHours, false);
 
     for (int i = 0; i < MAX_ZONES; i++) {
         const char *zoneName = strdup((String("5zoZoneName") + String(i + 1)).c_str());
         const char *zoneLabel = strdup((i18nStr(t_5zoneLabel) + " " + String(i + 1) + ": ").c_str());
-        m_config.addConfigString("FiveZoneWidget", zoneName, &m_timeZones[i].locName, 50, zoneLabel, false);
+        config.addConfigString("FiveZoneWidget", zoneName, &m_zones[i].locName, 50, zoneLabel, false);
 
         const char *zoneTZ = strdup((String("5zoZoneCode") + String(i + 1)).c_str());
         const char *zoneTZLabel = strdup((i18nStr(t_5zoneTZLabel) + " " + String(i + 1) + ": ").c_str());
-        m_config.addConfigString("FiveZoneWidget", zoneTZ, &m_timeZones[i].tzInfo, 50, zoneTZLabel, false);
+        config.addConfigString("FiveZoneWidget", zoneTZ, &m_zones[i].tzInfo, 50, zoneTZLabel, false);
     }
 
     for (int i = 0; i < MAX_ZONES; i++) {
         const char *zoneWorkStart = strdup((String("5zoZoneWstart") + String(i + 1)).c_str());
         const char *zoneWorkStartLabel = strdup((i18nStr(t_5zoneWorkStartLabel) + " " + String(i + 1) + ": ").c_str());
-        m_config.addConfigInt("FiveZoneWidget", zoneWorkStart, &m_timeZones[i].m_workStart, zoneWorkStartLabel, true);
+        config.addConfigInt("FiveZoneWidget", zoneWorkStart, &m_zones[i].m_workStart, zoneWorkStartLabel, true);
 
         const char *zoneWorkEnd = strdup((String("5zoZoneWend") + String(i + 1)).c_str());
         const char *zoneWorkEndLabel = strdup((i18nStr(t_5zoneWorkEndLabel) + " " + String(i + 1) + ": ").c_str());
-        m_config.addConfigInt("FiveZoneWidget", zoneWorkEnd, &m_timeZones[i].m_workEnd, zoneWorkEndLabel, true);
+        config.addConfigInt("FiveZoneWidget", zoneWorkEnd, &m_zones[i].m_workEnd, zoneWorkEndLabel, true);
+    }
+}
+
+FiveZoneWidget::FiveZoneWidget(ScreenManager &manager, ConfigManager &config) : Widget(manager, config),
+                                                                                m_drawTimer(addDrawRefreshFrequency(FIVEZONE_DRAW_DELAY)),
+                                                                                m_updateTimer(addUpdateRefreshFrequency(FIVEZONE_UPDATE_DELAY)) {
+    m_enabled = (INCLUDE_5ZONE == WIDGET_ON);
+    m_time = GlobalTime::getInstance();
+
+    m_config.addConfigBool("FiveZoneWidget", "5zoEnabled", &m_enabled, t_enableWidget);
+    addConfig(m_config);
+    for (int i = 0; i < MAX_ZONES; i++) {
+        m_timeZones[i].settings = &m_zones[i];
     }
     m_format = m_config.getConfigInt("clockFormat", 0);
 }
@@ -72,7 +79,7 @@ void FiveZoneWidget::processResponse(TimeZone &timeZone, int httpCode, const Str
 
                     int lv_idx = 0;
                     do {
-                        if (m_timeZones[lv_idx].tzInfo == timeZone.tzInfo) {
+                        if (m_timeZones[lv_idx].settings->tzInfo == timeZone.settings->tzInfo) {
                             m_timeZones[lv_idx].timeZoneOffset = timeZone.timeZoneOffset;
                             m_timeZones[lv_idx].nextTimeZoneUpdate = timeZone.nextTimeZoneUpdate;
                         }
@@ -97,14 +104,14 @@ void FiveZoneWidget::update(bool force) {
         bool lv_dup = false;
         int lv_idx = 0;
         do {
-            if ((i != lv_idx) && (m_timeZones[lv_idx].tzInfo == zone.tzInfo))
+            if ((i != lv_idx) && (m_timeZones[lv_idx].settings->tzInfo == zone.settings->tzInfo))
                 lv_dup = true;
             lv_idx++;
         } while ((lv_idx < i) && !(lv_dup));
 
         if ((zone.timeZoneOffset == -1 || (zone.nextTimeZoneUpdate > 0 && lv_localEpoch > zone.nextTimeZoneUpdate)) && !lv_dup) {
 
-            String url = String(TIMEZONE_API_URL) + "?timeZone=" + String(zone.tzInfo.c_str());
+            String url = String(TIMEZONE_API_URL) + "?timeZone=" + String(zone.settings->tzInfo.c_str());
 
             auto task = TaskFactory::createHttpGetTask(url, [this, &zone](int httpCode, const String &response) {
                 processResponse(zone, httpCode, response);
@@ -122,7 +129,7 @@ void FiveZoneWidget::changeFormat() {
         m_format = 0;
     m_manager.clearAllScreens();
     update(true);
-    draw(true);
+    requestRedraw();
 }
 
 int FiveZoneWidget::getClockStamp() {
@@ -134,6 +141,11 @@ void FiveZoneWidget::draw(bool force) {
 
     if (clockStamp != m_clockStampD || force) {
         m_clockStampD = clockStamp;
+        if (force) {
+            // Same background on every zone, cleared at once
+            m_manager.selectScreens((1 << MAX_ZONES) - 1);
+            m_manager.fillScreen(m_backgroundColor);
+        }
         for (int i = 0; i < MAX_ZONES; i++) {
             displayZone(i, force);
         }
@@ -164,15 +176,15 @@ void FiveZoneWidget::displayZone(int8_t displayIndex, bool force) {
     m_manager.setFont(DEFAULT_FONT);
     m_manager.selectScreen(displayIndex);
 
-    if (force)
-        m_manager.fillScreen(m_backgroundColor);
+    TimeZone &zone = m_timeZones[displayIndex];
+    if (force) {
+        zone.m_clockFace.invalidate();
+    }
     m_foregroundColor = m_workColour;
     m_manager.setFontColor(m_foregroundColor);
 
-    TimeZone &zone = m_timeZones[displayIndex];
-    if (zone.locName != "") {
+    if (zone.settings->locName != "") {
         // Get Orb (local) time information
-        m_localTimeZone.locName = "Local Time";
         m_localTimeZone.timeZoneOffset = m_time->getTimeZoneOffset();
         m_unixEpoch = m_time->getUnixEpoch();
 
@@ -218,7 +230,7 @@ void FiveZoneWidget::displayZone(int8_t displayIndex, bool force) {
             lv_displayAM = (isAM(lv_unixEpoch)) ? "AM" : "PM";
         }
 
-        m_manager.drawString(zone.locName.c_str(), ScreenCenterX, nameY, 18, Align::MiddleCenter);
+        m_manager.drawString(zone.settings->locName.c_str(), ScreenCenterX, nameY, 18, Align::MiddleCenter);
 
         if (lv_dateIndicator != zone.m_lastDateIndicator || force) {
             m_manager.fillRect(ScreenCenterX - 80, ampmY - 10, 45, 22, m_backgroundColor);
@@ -248,7 +260,7 @@ void FiveZoneWidget::displayZone(int8_t displayIndex, bool force) {
                 m_manager.setFontColor(m_foregroundColor);
             } else {
                 if (m_showBizHours) {
-                    if (lv_hour < zone.m_workStart || lv_hour >= zone.m_workEnd) {
+                    if (lv_hour < zone.settings->m_workStart || lv_hour >= zone.settings->m_workEnd) {
                         m_foregroundColor = m_afterWorkColour;
                         m_manager.setFontColor(m_foregroundColor);
                     }
@@ -257,9 +269,8 @@ void FiveZoneWidget::displayZone(int8_t displayIndex, bool force) {
         }
 
         String minuteStr = (lv_minute < 10) ? "0" + String(lv_minute) : String(lv_minute);
-        String lv_displayTime = lv_displayHour + ":" + minuteStr;
-        m_manager.fillRect(14, 82, 215, 69, m_backgroundColor);
-        m_manager.drawString(lv_displayTime, ScreenCenterX, clockY, 62, Align::MiddleCenter);
+        zone.m_clockFace.setClock(ScreenCenterX, clockY, 62, 8);
+        zone.m_clockFace.draw(m_manager, lv_displayHour.c_str(), minuteStr.c_str(), m_foregroundColor, m_backgroundColor);
     }
 }
 
@@ -1,6 +1,7 @@
 #ifndef FIVE_ZONE_WIDGET_H
 #define FIVE_ZONE_WIDGET_H
 
+#include "ClockFace.h"
 #include "GlobalTime.h"
 #include "Widget.h"
 #include "config_helper.h"
@@ -20,19 +21,32 @@
 #define SAME_LOCAL_TZ TFT_BLACK
 #define AFTER_LOCAL_TZ TFT_GREEN
 
-struct TimeZone {
+struct ZoneSettings {
     std::string locName = "";
     std::string tzInfo = "";
-    int timeZoneOffset = -1;
-    unsigned long nextTimeZoneUpdate = 0;
     int m_workStart = DEFAULT_WORK_HOUR_START; // Work start hour for this zone
     int m_workEnd = DEFAULT_WORK_HOUR_END; // Work end hour for this zone
+};
+
+struct TimeZone {
+    const ZoneSettings *settings = nullptr;
+    int timeZoneOffset = -1;
+    unsigned long nextTimeZoneUpdate = 0;
     String m_lastDateIndicator = "x";
     String m_lastDisplayAM = "x";
     int m_zoneDiff = -99;
+    ClockFace m_clockFace;
+};
+
+// Settings of the portal, registered by WidgetRegistry without the widget while it is disabled
+struct FiveZoneSettings {
+    bool m_showBizHours = false;
+    ZoneSettings m_zones[MAX_ZONES];
+
+    void addConfig(ConfigManager &config);
 };
 
-class FiveZoneWidget : public Widget {
+class FiveZoneWidget : public Widget, protected FiveZoneSettings {
 public:
     FiveZoneWidget(ScreenManager &manager, ConfigManager &config);
     void setup() override;
@@ -66,7 +80,6 @@ private:
 
     std::string m_timezoneLocation = TIMEZONE_API_LOCATION;
     int m_format = CLOCK_FORMAT;
-    bool m_showBizHours;
 
 #ifndef FIVEZONE_UPDATE_DELAY
     #define FIVEZONE_UPDATE_DELAY TimeFrequency::ThirtySeconds
@@ -6,7 +6,7 @@ BaseballDataModel::BaseballDataModel() {
 BaseballDataModel &BaseballDataModel::setTeamId(int teamId) {
     if (m_teamId != teamId) {
         m_teamId = teamId;
-        m_changed = true;
+        m_changedFields |= TEAM_ID;
     }
     return *this;
 }
@@ -16,300 +16,299 @@ int BaseballDataModel::getTeamId() {
 int BaseballDataModel::getTeamId() const {
     return m_teamId; // Same implementation as non-const version
 }
-BaseballDataModel &BaseballDataModel::setSeason(String season) {
-    if (m_season != season) {
-        m_season = season;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setSeason(const String &season) {
+    if (m_season.set(season)) {
+        m_changedFields |= SEASON;
     }
     return *this;
 }
-String BaseballDataModel::getSeason() {
+const FixedString<8> &BaseballDataModel::getSeason() const {
     return m_season;
 }
 
-BaseballDataModel &BaseballDataModel::setFullName(String fullName) {
-    if (m_fullName != fullName) {
-        m_fullName = fullName;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setFullName(const String &fullName) {
+    if (m_fullName.set(fullName)) {
+        m_changedFields |= FULL_NAME;
     }
     return *this;
 }
-String BaseballDataModel::getFullName() {
+const FixedString<32> &BaseballDataModel::getFullName() const {
     return m_fullName;
 }
 
-BaseballDataModel &BaseballDataModel::setShortName(String shortName) {
-    if (m_shortName != shortName) {
-        m_shortName = shortName;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setShortName(const String &shortName) {
+    if (m_shortName.set(shortName)) {
+        m_changedFields |= SHORT_NAME;
     }
     return *this;
 }
-String BaseballDataModel::getShortName() {
+const FixedString<16> &BaseballDataModel::getShortName() const {
     return m_shortName;
 }
 
 BaseballDataModel &BaseballDataModel::setColors(std::vector<TeamColor> colors) {
-    m_colors = colors;
-    m_changed = true;
+    bool changed = colors.size() != m_colors.size();
+    for (size_t i = 0; i < colors.size() && !changed; i++) {
+        changed = colors[i].name != m_colors[i].name || colors[i].code != m_colors[i].code;
+    }
+    if (changed) {
+        m_colors = colors;
+        m_changedFields |= COLORS;
+    }
     return *this;
 }
-std::vector<BaseballDataModel::TeamColor> BaseballDataModel::getColors() {
+const std::vector<BaseballDataModel::TeamColor> &BaseballDataModel::getColors() const {
     return m_colors;
 }
 
-BaseballDataModel &BaseballDataModel::setLogoUrl(String logoUrl) {
-    if (m_logoUrl != logoUrl) {
-        m_logoUrl = logoUrl;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setLogoUrl(const String &logoUrl) {
+    if (m_logoUrl.set(logoUrl)) {
+        m_changedFields |= LOGO_URL;
     }
     return *this;
 }
 
-String BaseballDataModel::getLogoUrl() {
+const FixedString<128> &BaseballDataModel::getLogoUrl() const {
     return m_logoUrl;
 }
 
-BaseballDataModel &BaseballDataModel::setLogoImageFileName(String logoImageFileName) {
-    if (m_logoImageFileName != logoImageFileName) {
-        m_logoImageFileName = logoImageFileName;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setLogoImageFileName(const String &logoImageFileName) {
+    if (m_logoImageFileName.set(logoImageFileName)) {
+        m_changedFields |= LOGO_IMAGE_FILE_NAME;
     }
     return *this;
 }
 
-String BaseballDataModel::getLogoImageFileName() {
+const FixedString<48> &BaseballDataModel::getLogoImageFileName() const {
     return m_logoImageFileName;
 }
 
-BaseballDataModel &BaseballDataModel::setLogoBackgroundColor(String logoBackgroundColor) {
+BaseballDataModel &BaseballDataModel::setLogoBackgroundColor(const String &logoBackgroundColor) {
     if (m_logoBackgroundColor != logoBackgroundColor) {
         m_logoBackgroundColor = logoBackgroundColor;
-        m_changed = true;
+        m_changedFields |= LOGO_BACKGROUND_COLOR;
     }
     return *this;
 }
 
-String BaseballDataModel::getLogoBackgroundColor() {
+const InternedString &BaseballDataModel::getLogoBackgroundColor() const {
     return m_logoBackgroundColor;
 }
 
-BaseballDataModel &BaseballDataModel::setRecord(String record) {
-    if (m_record != record) {
-        m_record = record;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setRecord(const String &record) {
+    if (m_record.set(record)) {
+        m_changedFields |= RECORD;
     }
     return *this;
 }
-String BaseballDataModel::getRecord() {
+const FixedString<16> &BaseballDataModel::getRecord() const {
     return m_record;
 }
 
-BaseballDataModel &BaseballDataModel::setDivision(String division) {
-    if (m_division != division) {
-        m_division = division;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setDivision(const String &division) {
+    if (m_division.set(division)) {
+        m_changedFields |= DIVISION;
     }
     return *this;
 }
-String BaseballDataModel::getDivision() {
+const FixedString<32> &BaseballDataModel::getDivision() const {
     return m_division;
 }
 
-BaseballDataModel &BaseballDataModel::setDivisionRank(String divisionRank) {
-    if (m_divisionRank != divisionRank) {
-        m_divisionRank = divisionRank;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setDivisionRank(const String &divisionRank) {
+    if (m_divisionRank.set(divisionRank)) {
+        m_changedFields |= DIVISION_RANK;
     }
     return *this;
 }
-String BaseballDataModel::getDivisionRank() {
+const FixedString<8> &BaseballDataModel::getDivisionRank() const {
     return m_divisionRank;
 }
 
-BaseballDataModel &BaseballDataModel::setWinningPercentage(String winningPercentage) {
-    if (m_winningPercentage != winningPercentage) {
-        m_winningPercentage = winningPercentage;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setWinningPercentage(const String &winningPercentage) {
+    if (m_winningPercentage.set(winningPercentage)) {
+        m_changedFields |= WINNING_PERCENTAGE;
     }
     return *this;
 }
-String BaseballDataModel::getWinningPercentage() {
+const FixedString<8> &BaseballDataModel::getWinningPercentage() const {
     return m_winningPercentage;
 }
 
-BaseballDataModel &BaseballDataModel::setGamesBack(String gamesBack) {
-    if (m_gamesBack != gamesBack) {
-        m_gamesBack = gamesBack;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setGamesBack(const String &gamesBack) {
+    if (m_gamesBack.set(gamesBack)) {
+        m_changedFields |= GAMES_BACK;
     }
     return *this;
 }
-String BaseballDataModel::getGamesBack() {
+const FixedString<8> &BaseballDataModel::getGamesBack() const {
     return m_gamesBack;
 }
 
 // Last game methods
-BaseballDataModel &BaseballDataModel::setLastGameDate(String date) {
-    if (m_lastGameDate != date) {
-        m_lastGameDate = date;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setLastGameDate(const String &date) {
+    if (m_lastGameDate.set(date)) {
+        m_changedFields |= LAST_GAME_DATE;
     }
     return *this;
 }
-String BaseballDataModel::getLastGameDate() {
+const FixedString<16> &BaseballDataModel::getLastGameDate() const {
     return m_lastGameDate;
 }
 
-BaseballDataModel &BaseballDataModel::setLastGameDay(String day) {
+BaseballDataModel &BaseballDataModel::setLastGameDay(const String &day) {
     if (m_lastGameDay != day) {
         m_lastGameDay = day;
-        m_changed = true;
+        m_changedFields |= LAST_GAME_DAY;
     }
     return *this;
 }
-String BaseballDataModel::getLastGameDay() {
+const InternedString &BaseballDataModel::getLastGameDay() const {
     return m_lastGameDay;
 }
 
-BaseballDataModel &BaseballDataModel::setLastGameOpponent(String opponent) {
-    if (m_lastGameOpponent != opponent) {
-        m_lastGameOpponent = opponent;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setLastGameOpponent(const String &opponent) {
+    if (m_lastGameOpponent.set(opponent)) {
+        m_changedFields |= LAST_GAME_OPPONENT;
     }
     return *this;
 }
-String BaseballDataModel::getLastGameOpponent() {
+const FixedString<32> &BaseballDataModel::getLastGameOpponent() const {
     return m_lastGameOpponent;
 }
 
-BaseballDataModel &BaseballDataModel::setLastGameScore(String score) {
-    if (m_lastGameScore != score) {
-        m_lastGameScore = score;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setLastGameScore(const String &score) {
+    if (m_lastGameScore.set(score)) {
+        m_changedFields |= LAST_GAME_SCORE;
     }
     return *this;
 }
-String BaseballDataModel::getLastGameScore() {
+const FixedString<16> &BaseballDataModel::getLastGameScore() const {
     return m_lastGameScore;
 }
 
-BaseballDataModel &BaseballDataModel::setLastGameResult(String result) {
+BaseballDataModel &BaseballDataModel::setLastGameResult(const String &result) {
     if (m_lastGameResult != result) {
         m_lastGameResult = result;
-        m_changed = true;
+        m_changedFields |= LAST_GAME_RESULT;
     }
     return *this;
 }
-String BaseballDataModel::getLastGameResult() {
+const InternedString &BaseballDataModel::getLastGameResult() const {
     return m_lastGameResult;
 }
 
-BaseballDataModel &BaseballDataModel::setLastGameTime(String gameTime) {
-    if (m_lastGameTime != gameTime) {
-        m_lastGameTime = gameTime;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setLastGameTime(const String &gameTime) {
+    if (m_lastGameTime.set(gameTime)) {
+        m_changedFields |= LAST_GAME_TIME;
     }
     return *this;
 }
-String BaseballDataModel::getLastGameTime() {
+const FixedString<16> &BaseballDataModel::getLastGameTime() const {
     return m_lastGameTime;
 }
 
-BaseballDataModel &BaseballDataModel::setLastTen(String lastTen) {
-    if (m_lastTen != lastTen) {
-        m_lastTen = lastTen;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setLastTen(const String &lastTen) {
+    if (m_lastTen.set(lastTen)) {
+        m_changedFields |= LAST_TEN;
     }
     return *this;
 }
-String BaseballDataModel::getLastTen() {
+const FixedString<16> &BaseballDataModel::getLastTen() const {
     return m_lastTen;
 }
 
 // Next game methods
-BaseballDataModel &BaseballDataModel::setNextGameDate(String date) {
-    if (m_nextGameDate != date) {
-        m_nextGameDate = date;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setNextGameDate(const String &date) {
+    if (m_nextGameDate.set(date)) {
+        m_changedFields |= NEXT_GAME_DATE;
     }
     return *this;
 }
-String BaseballDataModel::getNextGameDate() {
+const FixedString<16> &BaseballDataModel::getNextGameDate() const {
     return m_nextGameDate;
 }
 
-BaseballDataModel &BaseballDataModel::setNextGameDay(String day) {
+BaseballDataModel &BaseballDataModel::setNextGameDay(const String &day) {
     if (m_nextGameDay != day) {
         m_nextGameDay = day;
-        m_changed = true;
+        m_changedFields |= NEXT_GAME_DAY;
     }
     return *this;
 }
-String BaseballDataModel::getNextGameDay() {
+const InternedString &BaseballDataModel::getNextGameDay() const {
     return m_nextGameDay;
 }
 
-BaseballDataModel &BaseballDataModel::setNextGameOpponent(String opponent) {
-    if (m_nextGameOpponent != opponent) {
-        m_nextGameOpponent = opponent;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setNextGameOpponent(const String &opponent) {
+    if (m_nextGameOpponent.set(opponent)) {
+        m_changedFields |= NEXT_GAME_OPPONENT;
     }
     return *this;
 }
-String BaseballDataModel::getNextGameOpponent() {
+const FixedString<32> &BaseballDataModel::getNextGameOpponent() const {
     return m_nextGameOpponent;
 }
 
-BaseballDataModel &BaseballDataModel::setNextGameLocation(String location) {
-    if (m_nextGameLocation != location) {
-        m_nextGameLocation = location;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setNextGameLocation(const String &location) {
+    if (m_nextGameLocation.set(location)) {
+        m_changedFields |= NEXT_GAME_LOCATION;
     }
     return *this;
 }
-String BaseballDataModel::getNextGameLocation() {
+const FixedString<48> &BaseballDataModel::getNextGameLocation() const {
     return m_nextGameLocation;
 }
 
-BaseballDataModel &BaseballDataModel::setNextGameProbablePitcher(String pitcher) {
-    if (m_nextGameProbablePitcher != pitcher) {
-        m_nextGameProbablePitcher = pitcher;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setNextGameProbablePitcher(const String &pitcher) {
+    if (m_nextGameProbablePitcher.set(pitcher)) {
+        m_changedFields |= NEXT_GAME_PROBABLE_PITCHER;
     }
     return *this;
 }
-String BaseballDataModel::getNextGameProbablePitcher() {
+const FixedString<32> &BaseballDataModel::getNextGameProbablePitcher() const {
     return m_nextGameProbablePitcher;
 }
 
-BaseballDataModel &BaseballDataModel::setNextGameTime(String gameTime) {
-    if (m_nextGameTime != gameTime) {
-        m_nextGameTime = gameTime;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setNextGameTime(const String &gameTime) {
+    if (m_nextGameTime.set(gameTime)) {
+        m_changedFields |= NEXT_GAME_TIME;
     }
     return *this;
 }
-String BaseballDataModel::getNextGameTime() {
+const FixedString<16> &BaseballDataModel::getNextGameTime() const {
     return m_nextGameTime;
 }
 
-BaseballDataModel &BaseballDataModel::setNextGameTvBroadcast(String tvBroadcast) {
-    if (m_nextGameTvBroadcast != tvBroadcast) {
-        m_nextGameTvBroadcast = tvBroadcast;
-        m_changed = true;
+BaseballDataModel &BaseballDataModel::setNextGameTvBroadcast(const String &tvBroadcast) {
+    if (m_nextGameTvBroadcast.set(tvBroadcast)) {
+        m_changedFields |= NEXT_GAME_TV_BROADCAST;
     }
     return *this;
 }
-String BaseballDataModel::getNextGameTvBroadcast() {
+const FixedString<32> &BaseballDataModel::getNextGameTvBroadcast() const {
     return m_nextGameTvBroadcast;
 }
 
 bool BaseballDataModel::isChanged() {
-    return m_changed;
+    return m_changedFields != 0;
 }
 BaseballDataModel &BaseballDataModel::setChangedStatus(bool changed) {
-    m_changed = changed;
+    m_changedFields = changed ? ALL_FIELDS : 0;
+    return *this;
+}
+
+uint32_t BaseballDataModel::getChangedFields() const {
+    return m_changedFields;
+}
+
+BaseballDataModel &BaseballDataModel::markChangedFields(uint32_t fields) {
+    m_changedFields |= fields;
+    return *this;
+}
+
+BaseballDataModel &BaseballDataModel::clearChangedFields(uint32_t fields) {
+    m_changedFields &= ~fields;
     return *this;
 }
 
@@ -321,3 +320,76 @@ BaseballDataModel &BaseballDataModel::setInitializationStatus(bool initialized)
     m_initialized = initialized;
     return *this;
 }
+
+void BaseballDataModel::saveSnapshot(SnapshotWriter &writer) {
+    writer.write(m_teamId);
+    writer.write(m_season);
+    writer.write(m_fullName);
+    writer.write(m_shortName);
+    writer.write((uint8_t) m_colors.size());
+    for (const auto &color : m_colors) {
+        writer.write(color.name);
+        writer.write(color.code);
+    }
+    writer.write(m_logoUrl);
+    writer.write(m_logoImageFileName);
+    writer.write(m_logoBackgroundColor);
+    writer.write(m_record);
+    writer.write(m_division);
+    writer.write(m_divisionRank);
+    writer.write(m_winningPercentage);
+    writer.write(m_gamesBack);
+    writer.write(m_lastGameDate);
+    writer.write(m_lastGameDay);
+    writer.write(m_lastGameOpponent);
+    writer.write(m_lastGameScore);
+    writer.write(m_lastGameResult);
+    writer.write(m_lastGameTime);
+    writer.write(m_lastTen);
+    writer.write(m_nextGameDate);
+    writer.write(m_nextGameDay);
+    writer.write(m_nextGameOpponent);
+    writer.write(m_nextGameLocation);
+    writer.write(m_nextGameProbablePitcher);
+    writer.write(m_nextGameTime);
+    writer.write(m_nextGameTvBroadcast);
+}
+
+bool BaseballDataModel::restoreSnapshot(SnapshotReader &reader) {
+    reader.read(m_teamId);
+    reader.read(m_season);
+    reader.read(m_fullName);
+    reader.read(m_shortName);
+    uint8_t colorCount = 0;
+    reader.read(colorCount);
+    m_colors.resize(colorCount);
+    for (auto &color : m_colors) {
+        reader.read(color.name);
+        reader.read(color.code);
+    }
+    reader.read(m_logoUrl);
+    reader.read(m_logoImageFileName);
+    reader.read(m_logoBackgroundColor);
+    reader.read(m_record);
+    reader.read(m_division);
+    reader.read(m_divisionRank);
+    reader.read(m_winningPercentage);
+    reader.read(m_gamesBack);
+    reader.read(m_lastGameDate);
+    reader.read(m_lastGameDay);
+    reader.read(m_lastGameOpponent);
+    reader.read(m_lastGameScore);
+    reader.read(m_lastGameResult);
+    reader.read(m_lastGameTime);
+    reader.read(m_lastTen);
+    reader.read(m_nextGameDate);
+    reader.read(m_nextGameDay);
+    reader.read(m_nextGameOpponent);
+    reader.read(m_nextGameLocation);
+    reader.read(m_nextGameProbablePitcher);
+    reader.read(m_nextGameTime);
+    reader.read(m_nextGameTvBroadcast);
+    m_initialized = true;
+    m_changedFields = ALL_FIELDS;
+    return reader.ok();
+}
@@ -1,106 +1,148 @@
 #ifndef BASEBALL_DATA_MODEL_H
 #define BASEBALL_DATA_MODEL_H
 
+#include "DataSnapshot.h"
 #include <Arduino.h>
 #include <vector>
 
 class BaseballDataModel {
 public:
     struct TeamColor {
-        String name;
-        String code;
+        InternedString name;
+        InternedString code;
+    };
+
+    // Fields for getChangedFields(), widgets map them to the orbs that show them
+    enum Field : uint32_t {
+        TEAM_ID = 1UL << 0,
+        SEASON = 1UL << 1,
+        FULL_NAME = 1UL << 2,
+        SHORT_NAME = 1UL << 3,
+        COLORS = 1UL << 4,
+        LOGO_URL = 1UL << 5,
+        LOGO_IMAGE_FILE_NAME = 1UL << 6,
+        LOGO_BACKGROUND_COLOR = 1UL << 7,
+        RECORD = 1UL << 8,
+        DIVISION = 1UL << 9,
+        DIVISION_RANK = 1UL << 10,
+        WINNING_PERCENTAGE = 1UL << 11,
+        GAMES_BACK = 1UL << 12,
+        LAST_GAME_DATE = 1UL << 13,
+        LAST_GAME_DAY = 1UL << 14,
+        LAST_GAME_OPPONENT = 1UL << 15,
+        LAST_GAME_SCORE = 1UL << 16,
+        LAST_GAME_RESULT = 1UL << 17,
+        LAST_GAME_TIME = 1UL << 18,
+        LAST_TEN = 1UL << 19,
+        NEXT_GAME_DATE = 1UL << 20,
+        NEXT_GAME_DAY = 1UL << 21,
+        NEXT_GAME_OPPONENT = 1UL << 22,
+        NEXT_GAME_LOCATION = 1UL << 23,
+        NEXT_GAME_PROBABLE_PITCHER = 1UL << 24,
+        NEXT_GAME_TIME = 1UL << 25,
+        NEXT_GAME_TV_BROADCAST = 1UL << 26,
+        LOGO_IMAGE = 1UL << 27, // Not stored in the model, marked by the widget when the logo arrives
+        ALL_FIELDS = (1UL << 28) - 1
     };
 
     BaseballDataModel();
     BaseballDataModel &setTeamId(int teamId);
     int getTeamId();
     int getTeamId() const;
-    BaseballDataModel &setSeason(String season);
-    String getSeason();
-    BaseballDataModel &setFullName(String fullName);
-    String getFullName();
-    BaseballDataModel &setShortName(String shortName);
-    String getShortName();
+    BaseballDataModel &setSeason(const String &season);
+    const FixedString<8> &getSeason() const;
+    BaseballDataModel &setFullName(const String &fullName);
+    const FixedString<32> &getFullName() const;
+    BaseballDataModel &setShortName(const String &shortName);
+    const FixedString<16> &getShortName() const;
     BaseballDataModel &setColors(std::vector<TeamColor> colors);
-    std::vector<TeamColor> getColors();
-    BaseballDataModel &setLogoUrl(String logoUrl);
-    String getLogoUrl();
-    BaseballDataModel &setLogoImageFileName(String logoImageFileName);
-    String getLogoImageFileName();
-    BaseballDataModel &setLogoBackgroundColor(String logoBackgroundColor);
-    String getLogoBackgroundColor();
-    BaseballDataModel &setRecord(String record);
-    String getRecord();
-    BaseballDataModel &setDivision(String division);
-    String getDivision();
-    BaseballDataModel &setDivisionRank(String divisionRank);
-    String getDivisionRank();
-    BaseballDataModel &setWinningPercentage(String winningPercentage);
-    String getWinningPercentage();
-    BaseballDataModel &setGamesBack(String gamesBack);
-    String getGamesBack();
-    BaseballDataModel &setLastGameDate(String date);
-    String getLastGameDate();
-    BaseballDataModel &setLastGameDay(String day);
-    String getLastGameDay();
-    BaseballDataModel &setLastGameOpponent(String opponent);
-    String getLastGameOpponent();
-    BaseballDataModel &setLastGameScore(String score);
-    String getLastGameScore();
-    BaseballDataModel &setLastGameResult(String result);
-    String getLastGameResult();
-    BaseballDataModel &setLastGameTime(String gameTime);
-    String getLastGameTime();
-    BaseballDataModel &setLastTen(String lastTen);
-    String getLastTen();
-    BaseballDataModel &setNextGameDate(String date);
-    String getNextGameDate();
-    BaseballDataModel &setNextGameDay(String day);
-    String getNextGameDay();
-    BaseballDataModel &setNextGameOpponent(String opponent);
-    String getNextGameOpponent();
-    BaseballDataModel &setNextGameLocation(String location);
-    String getNextGameLocation();
-    BaseballDataModel &setNextGameProbablePitcher(String pitcher);
-    String getNextGameProbablePitcher();
-    BaseballDataModel &setNextGameTime(String gameTime);
-    String getNextGameTime();
-    BaseballDataModel &setNextGameTvBroadcast(String tvBroadcast);
-    String getNextGameTvBroadcast();
+    const std::vector<TeamColor> &getColors() const;
+    BaseballDataModel &setLogoUrl(const String &logoUrl);
+    const FixedString<128> &getLogoUrl() const;
+    BaseballDataModel &setLogoImageFileName(const String &logoImageFileName);
+    const FixedString<48> &getLogoImageFileName() const;
+    BaseballDataModel &setLogoBackgroundColor(const String &logoBackgroundColor);
+    const InternedString &getLogoBackgroundColor() const;
+    BaseballDataModel &setRecord(const String &record);
+    const FixedString<16> &getRecord() const;
+    BaseballDataModel &setDivision(const String &division);
+    const FixedString<32> &getDivision() const;
+    BaseballDataModel &setDivisionRank(const String &divisionRank);
+    const FixedString<8> &getDivisionRank() const;
+    BaseballDataModel &setWinningPercentage(const String &winningPercentage);
+    const FixedString<8> &getWinningPercentage() const;
+    BaseballDataModel &setGamesBack(const String &gamesBack);
+    const FixedString<8> &getGamesBack() const;
+    BaseballDataModel &setLastGameDate(const String &date);
+    const FixedString<16> &getLastGameDate() const;
+    BaseballDataModel &setLastGameDay(const String &day);
+    const InternedString &getLastGameDay() const;
+    BaseballDataModel &setLastGameOpponent(const String &opponent);
+    const FixedString<32> &getLastGameOpponent() const;
+    BaseballDataModel &setLastGameScore(const String &score);
+    const FixedString<16> &getLastGameScore() const;
+    BaseballDataModel &setLastGameResult(const String &result);
+    const InternedString &getLastGameResult() const;
+    BaseballDataModel &setLastGameTime(const String &gameTime);
+    const FixedString<16> &getLastGameTime() const;
+    BaseballDataModel &setLastTen(const String &lastTen);
+    const FixedString<16> &getLastTen() const;
+    BaseballDataModel &setNextGameDate(const String &date);
+    const FixedString<16> &getNextGameDate() const;
+    BaseballDataModel &setNextGameDay(const String &day);
+    const InternedString &getNextGameDay() const;
+    BaseballDataModel &setNextGameOpponent(const String &opponent);
+    const FixedString<32> &getNextGameOpponent() const;
+    BaseballDataModel &setNextGameLocation(const String &location);
+    const FixedString<48> &getNextGameLocation() const;
+    BaseballDataModel &setNextGameProbablePitcher(const String &pitcher);
+    const FixedString<32> &getNextGameProbablePitcher() const;
+    BaseballDataModel &setNextGameTime(const String &gameTime);
+    const FixedString<16> &getNextGameTime() const;
+    BaseballDataModel &setNextGameTvBroadcast(const String &tvBroadcast);
+    const FixedString<32> &getNextGameTvBroadcast() const;
+    // Any field changed, setChangedStatus() marks all or no fields
     bool isChanged();
     BaseballDataModel &setChangedStatus(bool changed);
+    uint32_t getChangedFields() const;
+    BaseballDataModel &markChangedFields(uint32_t fields);
+    // Call with the fields that have been drawn
+    BaseballDataModel &clearChangedFields(uint32_t fields);
     bool isInitialized();
     BaseballDataModel &setInitializationStatus(bool initialized);
 
+    void saveSnapshot(SnapshotWriter &writer);
+    bool restoreSnapshot(SnapshotReader &reader);
+
 private:
     int m_teamId = 0;
-    String m_season = "";
-    String m_fullName = "";
-    String m_shortName = "";
+    FixedString<8> m_season;
+    FixedString<32> m_fullName;
+    FixedString<16> m_shortName;
     std::vector<TeamColor> m_colors;
-    String m_logoUrl = "";
-    String m_logoImageFileName = "";
-    String m_logoBackgroundColor = "";
-    String m_record = "";
-    String m_division = "";
-    String m_divisionRank = "";
-    String m_winningPercentage = "";
-    String m_gamesBack = "";
-    String m_lastGameDate = "";
-    String m_lastGameDay = "";
-    String m_lastGameOpponent = "";
-    String m_lastGameScore = "";
-    String m_lastGameResult = "";
-    String m_lastGameTime = "";
-    String m_lastTen = "";
-    String m_nextGameDate = "";
-    String m_nextGameDay = "";
-    String m_nextGameOpponent = "";
-    String m_nextGameLocation = "";
-    String m_nextGameProbablePitcher = "";
-    String m_nextGameTime = "";
-    String m_nextGameTvBroadcast = "";
-    bool m_changed = false;
+    FixedString<128> m_logoUrl;
+    FixedString<48> m_logoImageFileName;
+    InternedString m_logoBackgroundColor;
+    FixedString<16> m_record;
+    FixedString<32> m_division;
+    FixedString<8> m_divisionRank;
+    FixedString<8> m_winningPercentage;
+    FixedString<8> m_gamesBack;
+    FixedString<16> m_lastGameDate;
+    InternedString m_lastGameDay;
+    FixedString<32> m_lastGameOpponent;
+    FixedString<16> m_lastGameScore;
+    InternedString m_lastGameResult;
+    FixedString<16> m_lastGameTime;
+    FixedString<16> m_lastTen;
+    FixedString<16> m_nextGameDate;
+    InternedString m_nextGameDay;
+    FixedString<32> m_nextGameOpponent;
+    FixedString<48> m_nextGameLocation;
+    FixedString<32> m_nextGameProbablePitcher;
+    FixedString<16> m_nextGameTime;
+    FixedString<32> m_nextGameTvBroadcast;
+    uint32_t m_changedFields = 0;
     bool m_initialized = false;
 };
 
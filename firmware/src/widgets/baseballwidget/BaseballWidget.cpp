@@ -5,6 +5,10 @@
 #include <HTTPClient.h>
 #include <WiFiClientSecure.h>
 
+void BaseballSettings::addConfig(ConfigManager &config) {
+    config.addConfigString("BaseballWidget", "teamName", &m_teamName, 20, t_baseballShortName);
+}
+
 BaseballWidget::BaseballWidget(ScreenManager &manager, ConfigManager &config)
     : Widget(manager, config),
       m_drawTimer(addDrawRefreshFrequency(BASEBALL_DRAW_DELAY)),
@@ -12,7 +16,7 @@ BaseballWidget::BaseballWidget(ScreenManager &manager, ConfigManager &config)
     m_enabled = (INCLUDE_BASEBALL == WIDGET_ON);
 
     m_config.addConfigBool("BaseballWidget", "baseballEnabled", &m_enabled, t_enableWidget);
-    m_config.addConfigString("BaseballWidget", "teamName", &m_teamName, 20, t_baseballShortName);
+    addConfig(m_config);
 
     Log.infoln("BaseballWidget initialized for team: %s", m_teamName.c_str());
 }
@@ -22,36 +26,66 @@ void BaseballWidget::setup() {
 }
 
 void BaseballWidget::draw(bool force) {
+    uint8_t step = 0;
+    while (!drawStep(force, step++)) {
+    }
+}
+
+bool BaseballWidget::drawStep(bool force, uint8_t step) {
     m_manager.setFont(DEFAULT_FONT);
 
-    if (!m_teamData.isInitialized() && force) {
-        m_manager.fillAllScreens(TFT_BLACK);
-        m_manager.setFontColor(TFT_WHITE, TFT_BLACK);
-        for (int8_t i = m_page * NUM_SCREENS; i < (m_page + 1) * NUM_SCREENS; i++) {
-            int8_t displayIndex = i % NUM_SCREENS;
-            m_manager.selectScreen(displayIndex);
+    if (step == 0) {
+        if (!m_teamData.isInitialized() && force) {
+            m_manager.selectAllScreens();
+            m_manager.fillScreen(TFT_BLACK);
+            m_manager.setFontColor(TFT_WHITE, TFT_BLACK);
             m_manager.drawCentreString(I18n::get(t_loadingData), ScreenCenterX, ScreenCenterY, 20);
+            m_manager.reset();
+            return true;
+        }
+        if (!(m_teamData.isChanged() || force) || !m_teamData.isInitialized()) {
+            return true;
         }
-        return;
+        // Get team colors once per draw
+        m_primaryColor = !m_teamData.getColors().empty()
+                             ? m_manager.color565FromHex(m_teamData.getColors()[0].code.toString())
+                             : TFT_WHITE;
+        m_secondaryColor = m_teamData.getColors().size() > 1
+                               ? m_manager.color565FromHex(m_teamData.getColors()[1].code.toString())
+                               : TFT_BLACK;
+        // Data arriving during the next steps is drawn in the next frame
+        m_drawFields = force ? BaseballDataModel::ALL_FIELDS : m_teamData.getChangedFields();
+        m_teamData.clearChangedFields(m_drawFields);
     }
 
-    if ((m_teamData.isChanged() || force) && m_teamData.isInitialized()) {
-        // Get team colors once
-        uint16_t primaryColor = !m_teamData.getColors().empty()
-                                    ? m_manager.color565FromHex(m_teamData.getColors()[0].code)
-                                    : TFT_WHITE;
-        uint16_t secondaryColor = m_teamData.getColors().size() > 1
-                                      ? m_manager.color565FromHex(m_teamData.getColors()[1].code)
-                                      : TFT_BLACK;
-
-        // Draw ALL screens
-        drawTeamInfoScreen(primaryColor, secondaryColor);
-        drawLastGameScreen(primaryColor, secondaryColor);
-        drawTeamLogoScreen(primaryColor);
-        drawNextGameScreen(primaryColor, secondaryColor);
-        drawStandingsScreen(primaryColor, secondaryColor);
-
-        m_teamData.setChangedStatus(false);
+    // One screen per step, only if one of its fields changed
+    bool changed = m_drawFields & ORB_FIELDS[min(step, (uint8_t) (NUM_SCREENS - 1))];
+    switch (step) {
+    case 0:
+        if (changed) {
+            drawTeamInfoScreen(m_primaryColor, m_secondaryColor);
+        }
+        return false;
+    case 1:
+        if (changed) {
+            drawLastGameScreen(m_primaryColor, m_secondaryColor);
+        }
+        return false;
+    case 2:
+        if (changed) {
+            drawTeamLogoScreen(m_primaryColor);
+        }
+        return false;
+    case 3:
+        if (changed) {
+            drawNextGameScreen(m_primaryColor, m_secondaryColor);
+        }
+        return false;
+    default:
+        if (changed) {
+            drawStandingsScreen(m_primaryColor, m_secondaryColor);
+        }
+        return true;
     }
 }
 
@@ -62,30 +96,34 @@ void BaseballWidget::update(bool force) {
         processResponse(m_teamData, httpCode, response);
 
         if (httpCode == HTTP_CODE_OK) {
-            String logoUrl = getLogoUrl();
-
-            auto logoTask = TaskFactory::createHttpGetTask(logoUrl, [this](int httpCode, const String &response) {
-                if (httpCode == HTTP_CODE_OK && response.length() > 0) {
-                    m_logoSize = response.length();
-                    m_logoData.reset(new uint8_t[m_logoSize]);
-                    if (m_logoData) {
-                        memcpy(m_logoData.get(), response.c_str(), m_logoSize);
-                        m_hasLogo = true;
-                        m_teamData.setChangedStatus(true);
-                    } else {
-                        Log.errorln("Failed to allocate memory for logo");
-                        m_logoSize = 0;
-                    }
-                }
-            });
-
-            TaskManager::getInstance()->addTask(std::move(logoTask));
+            fetchLogo();
         }
     });
 
     TaskManager::getInstance()->addTask(std::move(task));
 }
 
+void BaseballWidget::fetchLogo() {
+    String logoUrl = getLogoUrl();
+
+    auto logoTask = TaskFactory::createHttpGetTask(logoUrl, [this](int httpCode, const String &response) {
+        if (httpCode == HTTP_CODE_OK && response.length() > 0) {
+            m_logoSize = response.length();
+            m_logoData.reset(new uint8_t[m_logoSize]);
+            if (m_logoData) {
+                memcpy(m_logoData.get(), response.c_str(), m_logoSize);
+                m_hasLogo = true;
+                m_teamData.markChangedFields(BaseballDataModel::LOGO_IMAGE);
+            } else {
+                Log.errorln("Failed to allocate memory for logo");
+                m_logoSize = 0;
+            }
+        }
+    });
+
+    TaskManager::getInstance()->addTask(std::move(logoTask));
+}
+
 void BaseballWidget::processResponse(BaseballDataModel &team, int httpCode, const String &response) {
     if (httpCode > 0) {
         JsonDocument doc;
@@ -139,8 +177,12 @@ void BaseballWidget::processResponse(BaseballDataModel &team, int httpCode, cons
             team.setNextGameTime(nextGame["gameTime"].as<String>());
             team.setNextGameTvBroadcast(nextGame["tvBroadcast"].as<String>());
 
+            // The setters mark the fields that changed, the first data replaces the loading screens
+            if (!team.isInitialized()) {
+                team.setChangedStatus(true);
+            }
             team.setInitializationStatus(true);
-            team.setChangedStatus(true);
+            saveSnapshot();
         } else {
             Log.errorln("deserializeJson() failed");
         }
@@ -149,6 +191,44 @@ void BaseballWidget::processResponse(BaseballDataModel &team, int httpCode, cons
     }
 }
 
+bool BaseballWidget::restoreSnapshot() {
+    SnapshotReader reader("baseball", SNAPSHOT_VERSION, String(m_teamName.c_str()));
+    BaseballDataModel restored;
+    if (!reader.ok() || !restored.restoreSnapshot(reader)) {
+        return false;
+    }
+    m_teamData = restored;
+    snapshotRestored(reader);
+    Log.noticeln("Restored baseball data for %s (%d s old)", m_teamData.getFullName().c_str(), reader.getAge());
+    return true;
+}
+
+void BaseballWidget::saveSnapshot() {
+    dataRefreshed();
+    SnapshotWriter writer("baseball", SNAPSHOT_VERSION, String(m_teamName.c_str()));
+    m_teamData.saveSnapshot(writer);
+    m_snapshotDirty = !writer.commit();
+}
+
+bool BaseballWidget::hibernate() {
+    // Only drop data that is in the snapshot
+    if (m_snapshotDirty || !DataSnapshot::exists("baseball")) {
+        return false;
+    }
+    m_teamData = BaseballDataModel();
+    m_logoData.reset();
+    m_logoSize = 0;
+    m_hasLogo = false;
+    return true;
+}
+
+void BaseballWidget::resume() {
+    // The logo isn't part of the snapshot, it's downloaded again
+    if (restoreSnapshot()) {
+        fetchLogo();
+    }
+}
+
 void BaseballWidget::buttonPressed(uint8_t buttonId, ButtonState state) {
     if (buttonId == BUTTON_OK && state == BTN_SHORT) {
         nextPage();
@@ -162,7 +242,7 @@ void BaseballWidget::nextPage() {
     // m_currentScreenSet = (m_currentScreenSet + 1) % TOTAL_SCREEN_SETS;
     // For now, just force redraw all screens:
     m_teamData.setChangedStatus(true);
-    draw(true);
+    requestRedraw();
 }
 
 String BaseballWidget::getName() {
@@ -186,8 +266,8 @@ void BaseballWidget::drawTeamInfoScreen(uint16_t primaryColor, uint16_t secondar
     m_manager.fillRect(0, contentTop, SCREEN_SIZE, contentHeight, TFT_BLACK);
     m_manager.setFontColor(TFT_WHITE, TFT_BLACK);
     m_manager.drawCentreString(m_teamData.getShortName(), ScreenCenterX, contentCenterY - 30, 24);
-    m_manager.drawCentreString("Record: " + m_teamData.getRecord(), ScreenCenterX, contentCenterY + 10, 24);
-    m_manager.drawCentreString("Last 10: " + m_teamData.getLastTen(), ScreenCenterX, contentCenterY + 65, 13);
+    m_manager.drawCentreString(String("Record: ") + m_teamData.getRecord().c_str(), ScreenCenterX, contentCenterY + 10, 24);
+    m_manager.drawCentreString(String("Last 10: ") + m_teamData.getLastTen().c_str(), ScreenCenterX, contentCenterY + 65, 13);
 }
 
 void BaseballWidget::drawLastGameScreen(uint16_t primaryColor, uint16_t secondaryColor) {
@@ -199,16 +279,16 @@ void BaseballWidget::drawLastGameScreen(uint16_t primaryColor, uint16_t secondar
     const int contentCenterY = contentTop + (contentHeight / 2);
 
     m_manager.drawTitleBars(primaryColor, secondaryColor,
-                            "Last Game", m_teamData.getLastGameTime(),
+                            "Last Game", m_teamData.getLastGameTime().toString(),
                             TFT_WHITE, TFT_BLACK,
                             TOP_BAR_HEIGHT, BOTTOM_BAR_HEIGHT,
                             HEADER_TEXT_SIZE, FOOTER_TEXT_SIZE);
 
     m_manager.fillRect(0, contentTop, SCREEN_SIZE, contentHeight, TFT_BLACK);
     m_manager.setFontColor(TFT_WHITE, TFT_BLACK);
-    m_manager.drawCentreString(m_teamData.getLastGameDay() + ", " + m_teamData.getLastGameDate(),
+    m_manager.drawCentreString(m_teamData.getLastGameDay().toString() + ", " + m_teamData.getLastGameDate().c_str(),
                                ScreenCenterX, contentCenterY - 40, 20);
-    m_manager.drawCentreString("vs " + m_teamData.getLastGameOpponent(),
+    m_manager.drawCentreString(String("vs ") + m_teamData.getLastGameOpponent().c_str(),
                                ScreenCenterX, contentCenterY - 10, 22);
     m_manager.drawCentreString(m_teamData.getLastGameScore(),
                                ScreenCenterX, contentCenterY + 25, 28);
@@ -224,7 +304,7 @@ void BaseballWidget::drawTeamLogoScreen(uint16_t primaryColor) {
     const int contentHeight = SCREEN_SIZE - TOP_BAR_HEIGHT - BOTTOM_BAR_HEIGHT;
     const int center = 120;
 
-    if (String(m_teamData.getLogoBackgroundColor()) == "white") {
+    if (m_teamData.getLogoBackgroundColor() == "white") {
         m_manager.fillScreen(TFT_WHITE);
     } else
         m_manager.fillScreen(TFT_BLACK);
@@ -249,20 +329,20 @@ void BaseballWidget::drawNextGameScreen(uint16_t primaryColor, uint16_t secondar
     const int contentCenterY = contentTop + (contentHeight / 2);
 
     m_manager.drawTitleBars(primaryColor, secondaryColor,
-                            "Next Game", m_teamData.getNextGameTime(),
+                            "Next Game", m_teamData.getNextGameTime().toString(),
                             TFT_WHITE, TFT_BLACK,
                             TOP_BAR_HEIGHT, BOTTOM_BAR_HEIGHT,
                             HEADER_TEXT_SIZE, FOOTER_TEXT_SIZE);
 
     m_manager.fillRect(0, contentTop, SCREEN_SIZE, contentHeight, TFT_BLACK);
     m_manager.setFontColor(TFT_WHITE, TFT_BLACK);
-    m_manager.drawCentreString(m_teamData.getNextGameDay() + ", " + m_teamData.getNextGameDate(),
+    m_manager.drawCentreString(m_teamData.getNextGameDay().toString() + ", " + m_teamData.getNextGameDate().c_str(),
                                ScreenCenterX, contentCenterY - 40, 20);
-    m_manager.drawCentreString("vs " + m_teamData.getNextGameOpponent(),
+    m_manager.drawCentreString(String("vs ") + m_teamData.getNextGameOpponent().c_str(),
                                ScreenCenterX, contentCenterY - 10, 24);
     m_manager.drawCentreString(m_teamData.getNextGameLocation(),
                                ScreenCenterX, contentCenterY + 20, 20);
-    m_manager.drawCentreString("Pitcher: " + m_teamData.getNextGameProbablePitcher(),
+    m_manager.drawCentreString(String("Pitcher: ") + m_teamData.getNextGameProbablePitcher().c_str(),
                                ScreenCenterX, contentCenterY + 50, 19);
 }
 
@@ -283,7 +363,7 @@ void BaseballWidget::drawStandingsScreen(uint16_t primaryColor, uint16_t seconda
     m_manager.fillRect(0, contentTop, SCREEN_SIZE, contentHeight, TFT_BLACK);
     m_manager.setFontColor(TFT_WHITE, TFT_BLACK);
     m_manager.drawCentreString(m_teamData.getDivision(), ScreenCenterX, contentCenterY - 40, 20);
-    m_manager.drawCentreString("Rank: " + m_teamData.getDivisionRank(), ScreenCenterX, contentCenterY - 10, 24);
-    m_manager.drawCentreString("Win %: " + m_teamData.getWinningPercentage(), ScreenCenterX, contentCenterY + 20, 24);
-    m_manager.drawCentreString("GB: " + m_teamData.getGamesBack(), ScreenCenterX, contentCenterY + 50, 24);
+    m_manager.drawCentreString(String("Rank: ") + m_teamData.getDivisionRank().c_str(), ScreenCenterX, contentCenterY - 10, 24);
+    m_manager.drawCentreString(String("Win %: ") + m_teamData.getWinningPercentage().c_str(), ScreenCenterX, contentCenterY + 20, 24);
+    m_manager.drawCentreString(String("GB: ") + m_teamData.getGamesBack().c_str(), ScreenCenterX, contentCenterY + 50, 24);
 }
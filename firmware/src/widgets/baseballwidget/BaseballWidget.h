@@ -20,16 +20,29 @@
     #define BASEBALL_TEAM_NAME "Mets"
 #endif
 
-class BaseballWidget : public Widget {
+// Settings of the portal, registered by WidgetRegistry without the widget while it is disabled
+struct BaseballSettings {
+    std::string m_teamName = BASEBALL_TEAM_NAME;
+
+    void addConfig(ConfigManager &config);
+};
+
+class BaseballWidget : public Widget, protected BaseballSettings {
 public:
     BaseballWidget(ScreenManager &manager, ConfigManager &config);
     void setup() override;
     void update(bool force = false) override;
     void draw(bool force = false) override;
+    bool drawStep(bool force, uint8_t step) override;
     void buttonPressed(uint8_t buttonId, ButtonState state) override;
     String getName() override;
+    bool restoreSnapshot() override;
+    bool hibernate() override;
+    void resume() override;
 
 private:
+    void saveSnapshot();
+    void fetchLogo();
     void processResponse(BaseballDataModel &team, int httpCode, const String &response);
     void nextPage();
 
@@ -50,6 +63,21 @@ private:
     int8_t m_page = 0;
     int8_t m_pageCount = 5;
 
+    // Team colors of the current draw
+    uint16_t m_primaryColor = TFT_WHITE;
+    uint16_t m_secondaryColor = TFT_BLACK;
+    uint32_t m_drawFields = 0; // model fields redrawn in the current draw
+    // Model fields shown on each orb, the team colors are on all of them
+    static constexpr uint32_t ORB_FIELDS[NUM_SCREENS] = {
+        BaseballDataModel::COLORS | BaseballDataModel::SHORT_NAME | BaseballDataModel::RECORD | BaseballDataModel::LAST_TEN,
+        BaseballDataModel::COLORS | BaseballDataModel::LAST_GAME_TIME | BaseballDataModel::LAST_GAME_DAY | BaseballDataModel::LAST_GAME_DATE |
+            BaseballDataModel::LAST_GAME_OPPONENT | BaseballDataModel::LAST_GAME_SCORE | BaseballDataModel::LAST_GAME_RESULT,
+        BaseballDataModel::COLORS | BaseballDataModel::LOGO_BACKGROUND_COLOR | BaseballDataModel::LOGO_IMAGE,
+        BaseballDataModel::COLORS | BaseballDataModel::NEXT_GAME_TIME | BaseballDataModel::NEXT_GAME_DAY | BaseballDataModel::NEXT_GAME_DATE |
+            BaseballDataModel::NEXT_GAME_OPPONENT | BaseballDataModel::NEXT_GAME_LOCATION | BaseballDataModel::NEXT_GAME_PROBABLE_PITCHER,
+        BaseballDataModel::COLORS | BaseballDataModel::DIVISION | BaseballDataModel::DIVISION_RANK | BaseballDataModel::WINNING_PERCENTAGE |
+            BaseballDataModel::GAMES_BACK};
+
     std::unique_ptr<uint8_t[]> m_logoData;
     size_t m_logoSize = 0;
     bool m_hasLogo = false;
@@ -61,12 +89,12 @@ private:
         if (baseUrl.endsWith("/proxy")) {
             baseUrl = baseUrl.substring(0, baseUrl.length() - 6); // Remove last 6 chars ("/proxy")
         }
-        return baseUrl + "/logo/" + const_cast<BaseballDataModel &>(m_teamData).getLogoImageFileName();
+        return baseUrl + "/logo/" + m_teamData.getLogoImageFileName().c_str();
     }
 
-    std::string m_teamName = BASEBALL_TEAM_NAME;
-
     BaseballDataModel m_teamData;
+    static constexpr uint8_t SNAPSHOT_VERSION = 1;
+    bool m_snapshotDirty = false;
 
     int m_switchinterval = 10;
     unsigned long m_prevMillisSwitch = 0;
@@ -42,6 +42,15 @@ void ClockWidget::addConfigToManager() {
     m_config.addConfigColor("ClockWidget", "clkShColor", &m_shadowColor, t_clockShadowColor, true);
 #if USE_CLOCK_NIXIE > 0
     m_config.addConfigColor("ClockWidget", "clkNixieColor", &m_overrideNixieColor, t_clockOverrideNixieColor, true);
+#endif
+    // Colors are read on every draw, the forced redraw after saving applies them without a restart
+    auto redrawOnly = [](const char *section, const char *varName) {};
+    m_config.addOnChangeCallback("ClockWidget", "showSecondTicks", redrawOnly);
+    m_config.addOnChangeCallback("ClockWidget", "clkColor", redrawOnly);
+    m_config.addOnChangeCallback("ClockWidget", "clkShadowing", redrawOnly);
+    m_config.addOnChangeCallback("ClockWidget", "clkShColor", redrawOnly);
+#if USE_CLOCK_NIXIE > 0
+    m_config.addOnChangeCallback("ClockWidget", "clkNixieColor", redrawOnly);
 #endif
 #if USE_CLOCK_CUSTOM > 0
     for (int i = 0; i < USE_CLOCK_CUSTOM; i++) {
@@ -61,6 +70,14 @@ void ClockWidget::addConfigToManager() {
 }
 
 void ClockWidget::setup() {
+    if (CLOCK_FONT != DSEG7 || !CLOCK_SEGMENT_REDRAW) {
+        // DSEG7 digits are drawn by segment with full coverage, 4-bit atlas glyphs would not match them
+        m_manager.addToGlyphAtlas(CLOCK_FONT, CLOCK_FONT_SIZE);
+    }
+    if (!m_secondTicks.isBuilt()) {
+        // Setup runs on every switch to the clock, the ticks don't change
+        m_secondTicks.build(120, 110, 6);
+    }
     m_lastDisplay1Digit = "";
     m_lastDisplay2Digit = "";
     m_lastDisplay4Digit = "";
@@ -70,6 +87,11 @@ void ClockWidget::setup() {
 void ClockWidget::draw(bool force) {
     m_manager.setFont(CLOCK_FONT);
     GlobalTime *time = GlobalTime::getInstance();
+    if (force) {
+        // The screens may have been cleared
+        m_digitFace.invalidate();
+        m_colonFace.invalidate();
+    }
 
     if (m_lastDisplay1Digit != m_display1Digit || force) {
         displayDigit(0, m_lastDisplay1Digit, m_display1Digit, m_fgColor);
@@ -116,21 +138,26 @@ void ClockWidget::draw(bool force) {
 }
 
 void ClockWidget::displayAmPm(String &amPm, uint32_t color) {
+    if (!m_amPmCaptured) {
+        captureAmPm();
+    }
     m_manager.selectScreen(2);
-    m_manager.setFontColor(color, TFT_BLACK);
-    // Workaround for 12h AM/PM problem
-    // The colon is slightly offset and that's a problem because to remove them, we paint over them
-    // I think this is related to the TTF cache
-    // The problem disappears if we reload the font here
-    if (CLOCK_FONT == TTF_Font::DSEG7) {
-        // We set a new font anyway
-        m_manager.setFont(TTF_Font::DSEG14);
-    } else {
-        // Force reloading the font
-        m_manager.setFont(TTF_Font::NONE);
-        m_manager.setFont(CLOCK_FONT);
+    if (amPm == "AM") {
+        m_amStamp.draw(m_manager, color, TFT_BLACK);
+    } else if (amPm == "PM") {
+        m_pmStamp.draw(m_manager, color, TFT_BLACK);
     }
-    m_manager.drawString(amPm, SCREEN_SIZE / 5 * 4, SCREEN_SIZE / 2, 25, Align::MiddleCenter);
+}
+
+void ClockWidget::captureAmPm() {
+    // Rasterized once, so the clock font doesn't have to be swapped every second. Clearing
+    // repaints exactly the captured pixels, which also avoids the leftovers that came from
+    // drawing over the old text with a freshly loaded font.
+    m_manager.setFont(CLOCK_FONT == TTF_Font::DSEG7 ? TTF_Font::DSEG14 : CLOCK_FONT);
+    m_amStamp.capture(m_manager, "AM", SCREEN_SIZE / 5 * 4, SCREEN_SIZE / 2, 25, Align::MiddleCenter);
+    m_pmStamp.capture(m_manager, "PM", SCREEN_SIZE / 5 * 4, SCREEN_SIZE / 2, 25, Align::MiddleCenter);
+    m_manager.setFont(CLOCK_FONT);
+    m_amPmCaptured = true;
 }
 
 void ClockWidget::update(bool force) {
@@ -181,7 +208,7 @@ void ClockWidget::changeFormat() {
     time->setFormat24Hour(m_format == CLOCK_FORMAT_24_HOUR);
     m_manager.clearAllScreens();
     update(true);
-    draw(true);
+    requestRedraw();
 }
 
 bool ClockWidget::isCustomClock(int clockType) {
@@ -210,7 +237,7 @@ void ClockWidget::changeClockType() {
         changeClockType();
     } else {
         m_manager.clearAllScreens();
-        draw(true);
+        requestRedraw();
     }
 }
 
@@ -243,6 +270,8 @@ void ClockWidget::displayDigit(int displayIndex, const String &lastDigit, const
         } else {
             displayDigitImage(displayIndex, digit);
         }
+    } else if (displaySegments(displayIndex, lastDigit, digit, color, shadowing)) {
+        // Only the segments that toggled were repainted
     } else {
         // Normal clock
         int fontSize = CLOCK_FONT_SIZE;
@@ -279,6 +308,35 @@ void ClockWidget::displayDigit(int displayIndex, const String &lastDigit, const
 #endif
 }
 
+bool ClockWidget::displaySegments(int displayIndex, const String &lastDigit, const String &digit, uint32_t color, bool shadowing) {
+    if (CLOCK_FONT != DSEG7 || !CLOCK_SEGMENT_REDRAW) {
+        return false;
+    }
+    if (digit.length() != 1 || lastDigit.length() > 1) {
+        m_digitFace.invalidate(displayIndex);
+        m_colonFace.invalidate(displayIndex);
+        return false;
+    }
+    // Same positions as the text drawing below
+    int defaultY = SCREEN_SIZE / 2;
+    if (!m_digitFace.isBuilt()) {
+        int defaultX = SCREEN_SIZE / 2 + CLOCK_OFFSET_X_DIGITS;
+        SegmentSymbol symbols[11] = {{' ', (int16_t) defaultX, (int16_t) defaultY}};
+        for (int i = 0; i < 10; i++) {
+            symbols[i + 1] = {(char) ('0' + i), (int16_t) (defaultX + m_digitOffsets[i].x), (int16_t) (defaultY + m_digitOffsets[i].y)};
+        }
+        m_digitFace.build(m_manager, "8", defaultX, defaultY, CLOCK_FONT_SIZE, Align::MiddleCenter, symbols, 11);
+    }
+    if (!m_colonFace.isBuilt()) {
+        int defaultX = SCREEN_SIZE / 2 + CLOCK_OFFSET_X_COLON;
+        SegmentSymbol colon = {':', (int16_t) defaultX, (int16_t) defaultY};
+        m_colonFace.build(m_manager, ":", defaultX, defaultY, CLOCK_FONT_SIZE, Align::MiddleCenter, &colon, 1);
+    }
+    m_manager.selectScreen(displayIndex);
+    SegmentFace &face = digit == ":" ? m_colonFace : m_digitFace;
+    return face.draw(m_manager, displayIndex, lastDigit.length() ? lastDigit.charAt(0) : '\0', digit.charAt(0), color, m_shadowColor, shadowing);
+}
+
 void ClockWidget::displayDigit(int displayIndex, const String &lastDigit, const String &digit, uint32_t color) {
     displayDigit(displayIndex, lastDigit, digit, color, m_shadowing);
 }
@@ -301,9 +359,7 @@ void ClockWidget::displaySeconds(int displayIndex, int seconds, int color) {
         color = m_config.getConfigInt(tickColorKey.c_str(), TFT_WHITE);
     }
     m_manager.selectScreen(displayIndex);
-    int startA = ((seconds * 6) + 180 - 3) % 360;
-    int endA = ((seconds * 6) + 180 + 3) % 360;
-    m_manager.drawSmoothArc(SCREEN_SIZE / 2, SCREEN_SIZE / 2, 120, 110, startA, endA, color, TFT_BLACK);
+    m_secondTicks.draw(m_manager, SCREEN_SIZE / 2, SCREEN_SIZE / 2, seconds, color);
 }
 
 void ClockWidget::displayDigitImage(int displayIndex, const String &digit) {
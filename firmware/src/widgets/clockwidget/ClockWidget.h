@@ -2,6 +2,9 @@
 #define CLOCKWIDGET_H
 
 #include "GlobalTime.h"
+#include "SecondTicks.h"
+#include "SegmentFace.h"
+#include "TextStamp.h"
 #include "Widget.h"
 #include "config_helper.h"
 #include "nixie.h"
@@ -40,6 +43,10 @@
 // #define CLOCK_DIGITS_OFFSET { {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0} }
 #endif
 
+#ifndef CLOCK_SEGMENT_REDRAW
+    #define CLOCK_SEGMENT_REDRAW 1 // DSEG7 only: repaint the segments that toggle instead of the whole digit
+#endif
+
 #ifndef CLOCK_COLOR
     #define CLOCK_COLOR FOREGROUND_COLOR
 #endif
@@ -95,7 +102,9 @@ private:
     void displayDigit(int displayIndex, const String &lastDigit, const String &digit, uint32_t color);
     void displaySeconds(int displayIndex, int seconds, int color);
     void displayAmPm(String &amPm, uint32_t color);
+    void captureAmPm();
     DigitOffset getOffsetForDigit(const String &digit);
+    bool displaySegments(int displayIndex, const String &lastDigit, const String &digit, uint32_t color, bool shadowing);
     void displayDigitImage(int displayIndex, const String &digit);
     void displayNixie(int displayIndex, uint8_t index);
     void displayCustom(int displayIndex, uint8_t clockNumber, uint8_t index);
@@ -155,5 +164,12 @@ private:
     String m_lastAmPm{""};
 
     DigitOffset m_digitOffsets[10] = CLOCK_DIGITS_OFFSET;
+
+    SegmentFace m_digitFace;
+    SegmentFace m_colonFace;
+    SecondTicks m_secondTicks;
+    TextStamp m_amStamp;
+    TextStamp m_pmStamp;
+    bool m_amPmCaptured = false;
 };
 #endif // CLOCKWIDGET_H
@@ -0,0 +1,99 @@
+#include "SecondTicks.h"
+#include <ArduinoLog.h>
+#include <vector>
+
+// Coverage is sampled on a 4x4 grid per pixel
+#define SECOND_TICKS_SAMPLES 4
+
+SecondTicks::~SecondTicks() {
+    free(m_runs);
+}
+
+bool SecondTicks::build(int32_t outerRadius, int32_t innerRadius, float widthDegrees) {
+    free(m_runs);
+    m_runs = nullptr;
+    float outer2 = outerRadius * outerRadius;
+    float inner2 = innerRadius * innerRadius;
+    std::vector<AlphaRun> runs;
+    for (int i = 0; i < SECOND_TICKS_PER_QUARTER; i++) {
+        // Unit vectors of both edges, 0° points up and angles grow clockwise
+        float center = i * 6 * DEG_TO_RAD;
+        float half = widthDegrees / 2 * DEG_TO_RAD;
+        float startX = sinf(center - half);
+        float startY = -cosf(center - half);
+        float endX = sinf(center + half);
+        float endY = -cosf(center + half);
+
+        // Bounds of the corners and the outer arc's middle
+        float cornersX[5] = {startX * innerRadius, startX * outerRadius, endX * innerRadius, endX * outerRadius, sinf(center) * outerRadius};
+        float cornersY[5] = {startY * innerRadius, startY * outerRadius, endY * innerRadius, endY * outerRadius, -cosf(center) * outerRadius};
+        float minX = cornersX[0], maxX = cornersX[0], minY = cornersY[0], maxY = cornersY[0];
+        for (int c = 1; c < 5; c++) {
+            minX = min(minX, cornersX[c]);
+            maxX = max(maxX, cornersX[c]);
+            minY = min(minY, cornersY[c]);
+            maxY = max(maxY, cornersY[c]);
+        }
+        Tick &tick = m_ticks[i];
+        tick.x = floorf(minX) - 1;
+        tick.y = floorf(minY) - 1;
+        tick.first = runs.size();
+        int32_t width = (int32_t) ceilf(maxX) + 2 - tick.x;
+        int32_t height = (int32_t) ceilf(maxY) + 2 - tick.y;
+
+        for (int32_t row = 0; row < height; row++) {
+            size_t rowStart = runs.size();
+            for (int32_t col = 0; col < width; col++) {
+                uint8_t hits = 0;
+                for (int sy = 0; sy < SECOND_TICKS_SAMPLES; sy++) {
+                    float py = tick.y + row + (sy + 0.5f) / SECOND_TICKS_SAMPLES - 0.5f;
+                    for (int sx = 0; sx < SECOND_TICKS_SAMPLES; sx++) {
+                        float px = tick.x + col + (sx + 0.5f) / SECOND_TICKS_SAMPLES - 0.5f;
+                        float distance2 = px * px + py * py;
+                        // Inside the ring and between both edges
+                        if (distance2 >= inner2 && distance2 <= outer2 && startX * py - startY * px >= 0 && px * endY - py * endX >= 0) {
+                            hits++;
+                        }
+                    }
+                }
+                if (hits == 0) {
+                    continue;
+                }
+                uint8_t alpha = hits * 255 / (SECOND_TICKS_SAMPLES * SECOND_TICKS_SAMPLES);
+                if (runs.size() > rowStart && runs.back().x + runs.back().length == col && runs.back().alpha == alpha) {
+                    runs.back().length++;
+                } else {
+                    runs.push_back({(uint8_t) col, (uint8_t) row, 1, alpha});
+                }
+            }
+        }
+        tick.count = runs.size() - tick.first;
+    }
+
+    m_runs = (AlphaRun *) malloc(runs.size() * sizeof(AlphaRun));
+    if (m_runs == nullptr) {
+        Log.warningln("Not enough memory for the second ticks");
+        return false;
+    }
+    memcpy(m_runs, runs.data(), runs.size() * sizeof(AlphaRun));
+    Log.traceln("Second ticks: %d runs, %d bytes", (int) runs.size(), (int) (runs.size() * sizeof(AlphaRun)));
+    return true;
+}
+
+void SecondTicks::draw(ScreenManager &manager, int32_t x, int32_t y, int second, uint32_t color) const {
+    if (m_runs == nullptr || second < 0) {
+        return;
+    }
+    second %= 60;
+    const Tick &tick = m_ticks[second % SECOND_TICKS_PER_QUARTER];
+    uint8_t quarterTurns = second / SECOND_TICKS_PER_QUARTER;
+    // The top left corner of the stored runs turns with them
+    int32_t originX = tick.x;
+    int32_t originY = tick.y;
+    for (uint8_t i = 0; i < quarterTurns; i++) {
+        int32_t turnedX = -originY;
+        originY = originX;
+        originX = turnedX;
+    }
+    manager.drawAlphaRuns(m_runs + tick.first, tick.count, x + originX, y + originY, color, TFT_BLACK, quarterTurns);
+}
@@ -0,0 +1,35 @@
+#ifndef SECONDTICKS_H
+#define SECONDTICKS_H
+
+#include "ScreenManager.h"
+
+// Ticks from 12 to 3 o'clock, the other quarters are the same turned around the center
+#define SECOND_TICKS_PER_QUARTER 15
+
+/**
+ * The 60 anti-aliased second ticks of a ring as precomputed coverage runs, so moving the
+ * tick is two run blits instead of two smooth arcs. Only the first quarter is stored.
+ */
+class SecondTicks {
+public:
+    ~SecondTicks();
+
+    // Tick i covers the ring between innerRadius and outerRadius, widthDegrees wide and centered on i * 6°
+    bool build(int32_t outerRadius, int32_t innerRadius, float widthDegrees);
+    bool isBuilt() const { return m_runs != nullptr; }
+    // Draw the tick of second (0 = top, clockwise) around x/y on the selected screen
+    void draw(ScreenManager &manager, int32_t x, int32_t y, int second, uint32_t color) const;
+
+private:
+    struct Tick {
+        int16_t x; // Top left of the runs, relative to the center
+        int16_t y;
+        uint16_t first;
+        uint16_t count;
+    };
+
+    Tick m_ticks[SECOND_TICKS_PER_QUARTER];
+    AlphaRun *m_runs = nullptr;
+};
+
+#endif // SECONDTICKS_H
@@ -1,24 +1,28 @@
 #include "MatrixWidget.h"
 #include "MatrixTranslations.h"
 
+void MatrixSettings::addConfig(ConfigManager &config) {
+    config.addConfigBool("MatrixWidget", "mtxBigFont", &m_bigFont, t_matrixBigFont, false);
+    config.addConfigColor("MatrixWidget", "mtxTextColor", &m_textColor, t_matrixTextColor, false);
+    config.addConfigColor("MatrixWidget", "mtxHeadTxColor", &m_headTextColor, t_matrixHeadTextColor, false);
+    config.addConfigInt("MatrixWidget", "mtxLineMin", &m_lineMin, t_matrixLineMin, true);
+    config.addConfigInt("MatrixWidget", "mtxLineMax", &m_lineMax, t_matrixLineMax, true);
+    config.addConfigInt("MatrixWidget", "mtxSpeedMin", &m_speedMin, t_matrixSpeedMin, true);
+    config.addConfigInt("MatrixWidget", "mtxSpeedMax", &m_speedMax, t_matrixSpeedMax, true);
+    config.addConfigInt("MatrixWidget", "mtxUpdateInt", &m_updateInterval, t_matrixUpdateInterval, true);
+}
+
 MatrixWidget::MatrixWidget(ScreenManager &manager, ConfigManager &config) : Widget(manager, config) {
     m_enabled = (INCLUDE_MATRIXSCREEN == WIDGET_ON);
     m_config.addConfigBool("MatrixWidget", "mtxEnabled", &m_enabled, t_enableWidget);
-    m_config.addConfigBool("MatrixWidget", "mtxBigFont", &m_bigFont, t_matrixBigFont, false);
-    m_config.addConfigColor("MatrixWidget", "mtxTextColor", &m_textColor, t_matrixTextColor, false);
-    m_config.addConfigColor("MatrixWidget", "mtxHeadTxColor", &m_headTextColor, t_matrixHeadTextColor, false);
-    m_config.addConfigInt("MatrixWidget", "mtxLineMin", &m_lineMin, t_matrixLineMin, true);
-    m_config.addConfigInt("MatrixWidget", "mtxLineMax", &m_lineMax, t_matrixLineMax, true);
-    m_config.addConfigInt("MatrixWidget", "mtxSpeedMin", &m_speedMin, t_matrixSpeedMin, true);
-    m_config.addConfigInt("MatrixWidget", "mtxSpeedMax", &m_speedMax, t_matrixSpeedMax, true);
-    m_config.addConfigInt("MatrixWidget", "mtxUpdateInt", &m_updateInterval, t_matrixUpdateInterval, true);
+    addConfig(m_config);
+
+    // Colors can be applied without a restart
+    m_config.addOnChangeCallback("MatrixWidget", "mtxTextColor", [this](const char *section, const char *varName) { applyColors(); });
+    m_config.addOnChangeCallback("MatrixWidget", "mtxHeadTxColor", [this](const char *section, const char *varName) { applyColors(); });
 }
 
 void MatrixWidget::setup() {
-    int R;
-    int G;
-    int B;
-
     ConfigManager *cm = ConfigManager::getInstance();
     bool l_bigFont = cm->getConfigBool("mtxBigFont", false);
     if (l_bigFont)
@@ -27,6 +31,13 @@ void MatrixWidget::setup() {
         matrix_effect.init(&m_manager);
 
     matrix_effect.setup(m_lineMin, m_lineMax, m_speedMin, m_speedMax, m_updateInterval);
+    applyColors();
+}
+
+void MatrixWidget::applyColors() {
+    int R;
+    int G;
+    int B;
 
     R = ((m_textColor >> 11) & 0x1F) * 255 / 31;
     G = ((m_textColor >> 5) & 0x3F) * 255 / 63;
@@ -6,7 +6,21 @@
 #include "config_helper.h"
 #include <TFT_eSPI.h>
 
-class MatrixWidget : public Widget {
+// Settings of the portal, registered by WidgetRegistry without the widget while it is disabled
+struct MatrixSettings {
+    bool m_bigFont = false;
+    int m_textColor = 0x001F;
+    int m_headTextColor = 0x07FF;
+    int m_lineMin = 3;
+    int m_lineMax = 15;
+    int m_speedMin = 3;
+    int m_speedMax = 15;
+    int m_updateInterval = 100;
+
+    void addConfig(ConfigManager &config);
+};
+
+class MatrixWidget : public Widget, protected MatrixSettings {
 public:
     MatrixWidget(ScreenManager &manager, ConfigManager &config);
     void setup() override;
@@ -16,16 +30,9 @@ public:
     String getName() override;
 
 private:
-    DigitalRainAnimation matrix_effect;
+    void applyColors();
 
-    bool m_bigFont = false;
-    int m_textColor = 0x001F;
-    int m_headTextColor = 0x07FF;
-    int m_lineMin = 3;
-    int m_lineMax = 15;
-    int m_speedMin = 3;
-    int m_speedMax = 15;
-    int m_updateInterval = 100;
+    DigitalRainAnimation matrix_effect;
 };
 
 #endif
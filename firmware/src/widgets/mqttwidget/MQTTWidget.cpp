@@ -12,16 +12,7 @@ void MQTTWidget::staticCallback(char *topic, byte *payload, unsigned int length)
     }
 }
 
-// Constructor
-MQTTWidget::MQTTWidget(ScreenManager &manager, ConfigManager &config)
-    : Widget(manager, config),
-      m_drawTimer(addDrawRefreshFrequency(MQTT_DRAW_DELAY)),
-      m_updateTimer(addUpdateRefreshFrequency(MQTT_UPDATE_DELAY)),
-      mqttClient(wifiClient) {
-
-    // Assign the current instance to the static pointer
-    instance = this;
-
+MQTTSettings::MQTTSettings() {
 // Set defaults from config.h
 #ifdef MQTT_WIDGET_HOST
     mqttHost = MQTT_WIDGET_HOST;
@@ -38,13 +29,29 @@ MQTTWidget::MQTTWidget(ScreenManager &manager, ConfigManager &config)
 #ifdef MQTT_WIDGET_PASS
     mqttPass = MQTT_WIDGET_PASS;
 #endif
+}
+
+void MQTTSettings::addConfig(ConfigManager &config) {
+    config.addConfigString("MqttWidget", "mqttHost", &mqttHost, 30, t_mqttHost, true);
+    config.addConfigInt("MqttWidget", "mqttPort", &mqttPort, t_mqttPort, true);
+    config.addConfigString("MqttWidget", "mqttSetupTopic", &mqttSetupTopic, 100, t_mqttSetupTopic, true);
+    config.addConfigString("MqttWidget", "mqttUser", &mqttUser, 20, t_mqttUser, true);
+    config.addConfigString("MqttWidget", "mqttPass", &mqttPass, 50, t_mqttPass, true);
+}
+
+// Constructor
+MQTTWidget::MQTTWidget(ScreenManager &manager, ConfigManager &config)
+    : Widget(manager, config),
+      m_drawTimer(addDrawRefreshFrequency(MQTT_DRAW_DELAY)),
+      m_updateTimer(addUpdateRefreshFrequency(MQTT_UPDATE_DELAY)),
+      mqttClient(wifiClient) {
+
+    // Assign the current instance to the static pointer
+    instance = this;
+
     m_enabled = (INCLUDE_MQTT == WIDGET_ON);
     m_config.addConfigBool("MqttWidget", "mqttEnabled", &m_enabled, t_enableWidget);
-    m_config.addConfigString("MqttWidget", "mqttHost", &mqttHost, 30, t_mqttHost, true);
-    m_config.addConfigInt("MqttWidget", "mqttPort", &mqttPort, t_mqttPort, true);
-    m_config.addConfigString("MqttWidget", "mqttSetupTopic", &mqttSetupTopic, 100, t_mqttSetupTopic, true);
-    m_config.addConfigString("MqttWidget", "mqttUser", &mqttUser, 20, t_mqttUser, true);
-    m_config.addConfigString("MqttWidget", "mqttPass", &mqttPass, 50, t_mqttPass, true);
+    addConfig(m_config);
 
     // Set MQTT broker server and port
     mqttClient.setServer(mqttHost.c_str(), mqttPort);
@@ -142,7 +149,7 @@ void MQTTWidget::draw(bool force) {
 
     if (force) {
         for (const auto &orb : orbConfigs) {
-            drawOrb(orb.orbid);
+            drawOrb(orb.orbid, true);
         }
     }
 }
@@ -150,7 +157,7 @@ void MQTTWidget::draw(bool force) {
 // ChangeMode method
 void MQTTWidget::changeMode() {
     // Implement mode changes if applicable
-    draw(true);
+    requestRedraw();
 }
 
 // Callback function for MQTT messages
@@ -241,7 +248,7 @@ void MQTTWidget::callback(char *topic, byte *payload, unsigned int length) {
                             Log.traceln("Parsed %s : %s", orb->jsonField.c_str(), extractedValue.c_str());
 
                             // Redraw the orb with updated data
-                            drawOrb(orb->orbid);
+                            drawOrb(orb->orbid, false);
                         } else {
                             Log.traceln("No change detected for field: %s", orb->jsonField.c_str());
                         }
@@ -254,7 +261,7 @@ void MQTTWidget::callback(char *topic, byte *payload, unsigned int length) {
                     if (it->second != message) {
                         it->second = message;
                         Log.traceln("Updated data for %s : %s", receivedTopic.c_str(), message.c_str());
-                        drawOrb(orb->orbid);
+                        drawOrb(orb->orbid, false);
                     } else {
                         Log.traceln("No change detected for topic: %s", receivedTopic.c_str());
                     }
@@ -325,7 +332,7 @@ void MQTTWidget::handleSetupMessage(const String &message) {
     subscribeToOrbs();
 
     // Trigger a redraw to display the configured orbs
-    draw(true);
+    requestRedraw();
 }
 
 // Subscribe to all orb topics
@@ -392,7 +399,7 @@ void MQTTWidget::reconnect() {
 }
 
 // New method to draw a single orb based on orbid
-void MQTTWidget::drawOrb(int orbid) {
+void MQTTWidget::drawOrb(int orbid, bool force) {
     //    Log.traceln("Inside drawOrb method");
 
     // Select the screen corresponding to the orbid
@@ -412,8 +419,6 @@ void MQTTWidget::drawOrb(int orbid) {
         return;
     }
 
-    m_manager.fillScreen(orb->orbBgColor);
-
     // Define the position and size of the orb (adjust as needed)
     int x = 0; // Starting X position
     int y = 0; // Starting Y position
@@ -430,15 +435,18 @@ void MQTTWidget::drawOrb(int orbid) {
     m_manager.setFontColor(orb->orbTextColor, orb->orbBgColor);
     // m_manager.setTextSize(orb->orbsize);
 
-    // Display orb description/title
-    // display.drawString(orb->orbdesc, centre, orb->xpostxt, orb->ypostxt);
-    m_manager.drawString(orb->orbdesc, orb->xpostxt, orb->ypostxt, orb->orbsize, Align::MiddleCenter);
-    // m_manager.drawString(orb->orbdesc, centre, orb->ypostxt, orb->orbsize, Align::MiddleCenter);
+    // Display orb description/title, it only changes with the setup
+    if (force) {
+        m_manager.fillScreen(orb->orbBgColor);
+        // display.drawString(orb->orbdesc, centre, orb->xpostxt, orb->ypostxt);
+        m_manager.drawString(orb->orbdesc, orb->xpostxt, orb->ypostxt, orb->orbsize, Align::MiddleCenter);
+        // m_manager.drawString(orb->orbdesc, centre, orb->ypostxt, orb->orbsize, Align::MiddleCenter);
+    }
 
-    // Display orb data
+    // Display orb data, repainting only the digits that changed
     String data = orbDataMap[orb->topicSrc];
     // display.drawString(data + orb->orbvalunit, centre, orb->xposval, orb->yposval);
-    m_manager.drawString(data + orb->orbvalunit, orb->xposval, orb->yposval, orb->orbsize, Align::MiddleCenter);
+    m_manager.drawNumber(0, (data + orb->orbvalunit).c_str(), orb->xposval, orb->yposval, orb->orbsize, Align::MiddleCenter, orb->orbTextColor, orb->orbBgColor);
 }
 
 String MQTTWidget::getName() {
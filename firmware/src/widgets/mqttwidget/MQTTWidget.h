@@ -26,7 +26,19 @@ struct OrbConfig {
     std::map<String, String> lastValuesMap; // Store last values for fields
 };
 
-class MQTTWidget : public Widget {
+// Settings of the portal, registered by WidgetRegistry without the widget while it is disabled
+struct MQTTSettings {
+    MQTTSettings();
+    void addConfig(ConfigManager &config);
+
+    std::string mqttHost{""}; // MQTT broker host
+    int mqttPort{1883}; // MQTT broker port
+    std::string mqttSetupTopic{""}; // MQTT setup topic
+    std::string mqttUser{""}; // MQTT user (empty if authentication is not required)
+    std::string mqttPass{""}; // MQTT pass (empty if authentication is not required)
+};
+
+class MQTTWidget : public Widget, protected MQTTSettings {
 public:
     /**
      * @brief Constructor for MQTTWidget.
@@ -64,14 +76,9 @@ public:
 
 private:
     // MQTT-related members
-    std::string mqttHost{""}; // MQTT broker host
-    int mqttPort{1883}; // MQTT broker port
     unsigned long lastReconnectAttempt{0}; // Last reconnection attempt time
     WiFiClient wifiClient; // Wi-Fi client for MQTT
     PubSubClient mqttClient; // MQTT client
-    std::string mqttSetupTopic{""}; // MQTT setup topic
-    std::string mqttUser{""}; // MQTT user (empty if authentication is not required)
-    std::string mqttPass{""}; // MQTT pass (empty if authentication is not required)
 
     // Configuration from setup topic
     std::vector<OrbConfig> orbConfigs; // Vector of orb configurations
@@ -94,7 +101,7 @@ private:
     void handleSetupMessage(const String &message); // Process setup JSON
     void subscribeToOrbs(); // Subscribe to all configured orb topics
     uint16_t getColorFromString(const String &colorStr); // Convert color string to uint16_t
-    void drawOrb(int orbid); // Draw a single orb based on orbid
+    void drawOrb(int orbid, bool force); // Draw a single orb based on orbid, force also redraws the title
 
     WidgetTimer &m_drawTimer;
     WidgetTimer &m_updateTimer;
@@ -45,6 +45,15 @@ void ParqetDataModel::clearChartData() {
     setChartData(new float[0], 0);
 }
 
+void ParqetDataModel::clear() {
+    delete[] m_holdings;
+    delete[] m_chartdata;
+    m_holdings = nullptr;
+    m_chartdata = nullptr;
+    m_holdingsCount = 0;
+    m_chartdataCount = 0;
+}
+
 float *ParqetDataModel::getChartData() {
     return m_chartdata;
 }
@@ -78,4 +87,44 @@ void ParqetDataModel::getChartDataScale(uint8_t maxY, float &scale, float &minVa
     minVal = _minVal;
     maxVal = _maxVal;
     chartMinVal = min(_minVal, zero);
-}
\ No newline at end of file
+}
+
+void ParqetDataModel::saveSnapshot(SnapshotWriter &writer) {
+    writer.write((int16_t) m_holdingsCount);
+    for (int i = 0; i < m_holdingsCount; i++) {
+        m_holdings[i].saveSnapshot(writer);
+    }
+    writer.write((int16_t) m_chartdataCount);
+    for (int i = 0; i < m_chartdataCount; i++) {
+        writer.write(m_chartdata[i]);
+    }
+}
+
+bool ParqetDataModel::restoreSnapshot(SnapshotReader &reader) {
+    int16_t holdingsCount = 0;
+    // Counts come from flash, don't let a corrupt snapshot exhaust the heap
+    if (!reader.read(holdingsCount) || holdingsCount < 0 || holdingsCount > PARQET_MAX_HOLDINGS + 1) {
+        return false;
+    }
+    auto *holdings = new ParqetHoldingDataModel[holdingsCount];
+    for (int i = 0; i < holdingsCount; i++) {
+        holdings[i].restoreSnapshot(reader);
+    }
+    int16_t chartCount = 0;
+    if (!reader.read(chartCount) || chartCount < 0 || chartCount > PARQET_MAX_CHART_POINTS) {
+        delete[] holdings;
+        return false;
+    }
+    float *chart = new float[chartCount];
+    for (int i = 0; i < chartCount; i++) {
+        reader.read(chart[i]);
+    }
+    if (!reader.ok()) {
+        delete[] holdings;
+        delete[] chart;
+        return false;
+    }
+    setHoldings(holdings, holdingsCount);
+    setChartData(chart, chartCount);
+    return true;
+}
@@ -6,6 +6,14 @@
 
 #include "ParqetHoldingDataModel.h"
 
+#ifndef PARQET_MAX_HOLDINGS
+    #define PARQET_MAX_HOLDINGS 100 // Holdings kept of a portfolio (plus the total), more are dropped
+#endif
+
+#ifndef PARQET_MAX_CHART_POINTS
+    #define PARQET_MAX_CHART_POINTS 200 // Points of the performance chart, as many as fit its width
+#endif
+
 class ParqetDataModel {
 public:
     ParqetDataModel();
@@ -13,11 +21,16 @@ public:
     ParqetHoldingDataModel &getHolding(int index);
     void setChartData(float *chartData, int count);
     void clearChartData();
+    // Frees the holdings and the chart data
+    void clear();
     float *getChartData();
     int getHoldingsCount();
     int getChartDataCount();
     void getChartDataScale(uint8_t maxY, float &scale, float &minVal, float &maxVal, float &chartMinVal);
 
+    void saveSnapshot(SnapshotWriter &writer);
+    bool restoreSnapshot(SnapshotReader &reader);
+
 private:
     ParqetHoldingDataModel *m_holdings = nullptr;
     float *m_chartdata = nullptr;
@@ -33,7 +33,7 @@ void ParqetHoldingDataModel::setShares(const float shares) {
     m_shares = shares;
 }
 
-void ParqetHoldingDataModel::setCurrency(const String &currency) {
+void ParqetHoldingDataModel::setCurrency(const InternedString &currency) {
     m_currency = currency;
 }
 
@@ -41,19 +41,19 @@ void ParqetHoldingDataModel::setPerformance(const float perf) {
     m_performance = perf;
 }
 
-String ParqetHoldingDataModel::getId() const {
+const FixedString<32> &ParqetHoldingDataModel::getId() const {
     return m_id;
 }
 
-String ParqetHoldingDataModel::getName() const {
+const FixedString<64> &ParqetHoldingDataModel::getName() const {
     return m_name;
 }
 
-String ParqetHoldingDataModel::getPurchasePrice(const int8_t digits) const {
+FrameString ParqetHoldingDataModel::getPurchasePrice(const int8_t digits) const {
     return Utils::formatFloat(m_purchasePrice, digits);
 }
 
-String ParqetHoldingDataModel::getPurchaseValue(const int8_t digits) const {
+FrameString ParqetHoldingDataModel::getPurchaseValue(const int8_t digits) const {
     return Utils::formatFloat(m_purchaseValue, digits);
 }
 
@@ -61,7 +61,7 @@ float ParqetHoldingDataModel::getCurrentPrice() const {
     return m_currentPrice;
 }
 
-String ParqetHoldingDataModel::getCurrentPrice(const int8_t digits) const {
+FrameString ParqetHoldingDataModel::getCurrentPrice(const int8_t digits) const {
     return Utils::formatFloat(m_currentPrice, digits);
 }
 
@@ -69,11 +69,11 @@ float ParqetHoldingDataModel::getCurrentValue() const {
     return m_currentValue;
 }
 
-String ParqetHoldingDataModel::getCurrentValue(const int8_t digits) const {
+FrameString ParqetHoldingDataModel::getCurrentValue(const int8_t digits) const {
     return Utils::formatFloat(m_currentValue, digits);
 }
 
-String ParqetHoldingDataModel::getShares(const int8_t digits) const {
+FrameString ParqetHoldingDataModel::getShares(const int8_t digits) const {
     return Utils::formatFloat(m_shares, digits);
 }
 
@@ -81,10 +81,35 @@ float ParqetHoldingDataModel::getPerformance() const {
     return m_performance;
 }
 
-String ParqetHoldingDataModel::getPerformance(const int8_t digits) const {
+FrameString ParqetHoldingDataModel::getPerformance(const int8_t digits) const {
     return Utils::formatFloat(m_performance, digits);
 }
 
-String ParqetHoldingDataModel::getCurrency() const {
+const InternedString &ParqetHoldingDataModel::getCurrency() const {
     return m_currency;
-}
\ No newline at end of file
+}
+
+void ParqetHoldingDataModel::saveSnapshot(SnapshotWriter &writer) const {
+    writer.write(m_id);
+    writer.write(m_name);
+    writer.write(m_purchasePrice);
+    writer.write(m_purchaseValue);
+    writer.write(m_currentPrice);
+    writer.write(m_currentValue);
+    writer.write(m_shares);
+    writer.write(m_currency);
+    writer.write(m_performance);
+}
+
+bool ParqetHoldingDataModel::restoreSnapshot(SnapshotReader &reader) {
+    reader.read(m_id);
+    reader.read(m_name);
+    reader.read(m_purchasePrice);
+    reader.read(m_purchaseValue);
+    reader.read(m_currentPrice);
+    reader.read(m_currentValue);
+    reader.read(m_shares);
+    reader.read(m_currency);
+    reader.read(m_performance);
+    return reader.ok();
+}
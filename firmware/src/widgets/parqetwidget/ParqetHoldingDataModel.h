@@ -1,6 +1,8 @@
 #ifndef PARQET_HOLDING_DATA_MODEL_H
 #define PARQET_HOLDING_DATA_MODEL_H
 
+#include "DataSnapshot.h"
+#include "FrameString.h"
 #include <Arduino.h>
 
 #include <iomanip>
@@ -16,31 +18,34 @@ public:
     void setCurrentPrice(float currentPrice);
     void setCurrentValue(float currentValue);
     void setShares(float shares);
-    void setCurrency(const String &currency);
+    void setCurrency(const InternedString &currency);
     void setPerformance(float perf);
 
-    String getId() const;
-    String getName() const;
-    String getPurchasePrice(int8_t digits) const;
-    String getPurchaseValue(int8_t digits) const;
+    const FixedString<32> &getId() const;
+    const FixedString<64> &getName() const;
+    FrameString getPurchasePrice(int8_t digits) const;
+    FrameString getPurchaseValue(int8_t digits) const;
     float getCurrentPrice() const;
-    String getCurrentPrice(int8_t digits) const;
+    FrameString getCurrentPrice(int8_t digits) const;
     float getCurrentValue() const;
-    String getCurrentValue(int8_t digits) const;
-    String getShares(int8_t digits) const;
-    String getCurrency() const;
+    FrameString getCurrentValue(int8_t digits) const;
+    FrameString getShares(int8_t digits) const;
+    const InternedString &getCurrency() const;
     float getPerformance() const;
-    String getPerformance(int8_t digits) const;
+    FrameString getPerformance(int8_t digits) const;
+
+    void saveSnapshot(SnapshotWriter &writer) const;
+    bool restoreSnapshot(SnapshotReader &reader);
 
 private:
-    String m_id = "";
-    String m_name = "";
+    FixedString<32> m_id;
+    FixedString<64> m_name;
     float m_purchasePrice = 0;
     float m_purchaseValue = 0;
     float m_currentPrice = 0;
     float m_currentValue = 0;
     float m_shares = 0;
-    String m_currency = "";
+    InternedString m_currency;
     float m_performance = 0;
 };
 
@@ -2,11 +2,24 @@
 
 #include "ParqetTranslations.h"
 #include <ArduinoJson.h>
+#include <ArduinoLog.h>
 #include <HTTPClient.h>
 #include <StreamUtils.h>
 #include <TaskFactory.h>
 #include <iomanip>
 
+void ParqetSettings::addConfig(ConfigManager &config) {
+    config.addConfigString("ParqetWidget", "pqportfoId", &m_portfolioId, 50, t_pqPortfolioId);
+    config.addConfigComboBox("ParqetWidget", "pqDefMode", &m_defaultMode, t_pqTimeframes, t_pqTimeframe, true);
+    config.addConfigComboBox("ParqetWidget", "pqDefPerf", &m_defaultPerfMeasure, t_pqPerfMeasures, t_pqPerfMeasure, true);
+    config.addConfigComboBox("ParqetWidget", "pqDefPerfCh", &m_defaultPerfChartMeasure, t_pqPerfChartMeasures, t_pqChartMeasure, true);
+    config.addConfigBool("ParqetWidget", "pqShowClock", &m_showClock, t_pqClock, true);
+    config.addConfigBool("ParqetWidget", "pqShowTotalScr", &m_showTotalScreen, t_pqTotals, true);
+    config.addConfigBool("ParqetWidget", "pqShowTotalVal", &m_showTotalValue, t_pqTotalVal, true);
+    config.addConfigComboBox("ParqetWidget", "pqShowValues", &m_showValues, t_pqShowPriceOrValuesOptions, t_pqShowPriceOrValues, true);
+    config.addConfigString("ParqetWidget", "pqProxyUrl", &m_proxyUrl, 75, t_pqProxyUrl, true);
+}
+
 ParqetWidget::ParqetWidget(ScreenManager &manager, ConfigManager &config)
     : Widget(manager, config),
       m_drawTimer(addDrawRefreshFrequency(PARQET_DRAW_DELAY)),
@@ -14,15 +27,7 @@ ParqetWidget::ParqetWidget(ScreenManager &manager, ConfigManager &config)
     Serial.printf("Constructing ParqetWidget, portfolioId=%s\n", m_portfolioId.c_str());
     m_enabled = (INCLUDE_PARQET == WIDGET_ON);
     m_config.addConfigBool("ParqetWidget", "pqEnabled", &m_enabled, t_enableWidget);
-    m_config.addConfigString("ParqetWidget", "pqportfoId", &m_portfolioId, 50, t_pqPortfolioId);
-    m_config.addConfigComboBox("ParqetWidget", "pqDefMode", &m_defaultMode, t_pqTimeframes, t_pqTimeframe, true);
-    m_config.addConfigComboBox("ParqetWidget", "pqDefPerf", &m_defaultPerfMeasure, t_pqPerfMeasures, t_pqPerfMeasure, true);
-    m_config.addConfigComboBox("ParqetWidget", "pqDefPerfCh", &m_defaultPerfChartMeasure, t_pqPerfChartMeasures, t_pqChartMeasure, true);
-    m_config.addConfigBool("ParqetWidget", "pqShowClock", &m_showClock, t_pqClock, true);
-    m_config.addConfigBool("ParqetWidget", "pqShowTotalScr", &m_showTotalScreen, t_pqTotals, true);
-    m_config.addConfigBool("ParqetWidget", "pqShowTotalVal", &m_showTotalValue, t_pqTotalVal, true);
-    m_config.addConfigComboBox("ParqetWidget", "pqShowValues", &m_showValues, t_pqShowPriceOrValuesOptions, t_pqShowPriceOrValues, true);
-    m_config.addConfigString("ParqetWidget", "pqProxyUrl", &m_proxyUrl, 75, t_pqProxyUrl, true);
+    addConfig(m_config);
     m_curMode = m_defaultMode;
     m_curPerfMeasure = m_defaultPerfMeasure;
     m_curPerfChartMeasure = m_defaultPerfChartMeasure;
@@ -31,68 +36,96 @@ ParqetWidget::ParqetWidget(ScreenManager &manager, ConfigManager &config)
 void ParqetWidget::setup() {
     m_time = GlobalTime::getInstance();
     m_holdingsDisplayFrom = 0;
+    // Clock digits, values and performance
+    m_manager.addToGlyphAtlas(DEFAULT_FONT, 66);
+    m_manager.addToGlyphAtlas(DEFAULT_FONT, 26);
+    m_manager.addToGlyphAtlas(DEFAULT_FONT, 22);
+    m_clockFace.setClock(ScreenCenterX, 105, 66, 10);
+    m_clockFace.setLine(0, 165, 16); // Date
 }
 
 void ParqetWidget::draw(bool force) {
+    uint8_t step = 0;
+    while (!drawStep(force, step++)) {
+    }
+}
+
+bool ParqetWidget::drawStep(bool force, uint8_t step) {
     m_manager.setFont(DEFAULT_FONT);
-    // Check if we need more than one page
-    bool isMultiPage = m_portfolio.getHoldingsCount() > (m_showClock ? 4 : 5);
-    // Do we need to update the screens because cycle time is expired
-    bool updateByCycle = isMultiPage && (millis() - m_cycleDelayPrev) >= m_cycleDelay;
-    // Do we need to update the clock screen?
-    bool updateByClock = m_showClock && (millis() - m_clockDelayPrev) >= m_clockDelay;
-    // Do we need to update the stock screens?
-    bool updateStocks = force || m_changed || updateByCycle;
-    if (updateStocks || updateByClock) {
-        int8_t stockDisplays = 5;
-        int8_t startDisplay = 0;
-        if (m_showClock) {
+    if (step == 0) {
+        // Check if we need more than one page
+        bool isMultiPage = m_portfolio.getHoldingsCount() > (m_showClock ? 4 : 5);
+        // Do we need to update the screens because cycle time is expired
+        bool updateByCycle = isMultiPage && (millis() - m_cycleDelayPrev) >= m_cycleDelay;
+        // Do we need to update the clock screen?
+        bool updateByClock = m_showClock && (millis() - m_clockDelayPrev) >= m_clockDelay;
+        // Do we need to update the stock screens?
+        bool updateStocks = force || m_changed || updateByCycle;
+        m_stockDisplays = 5;
+        m_startDisplay = 0;
+        if ((updateStocks || updateByClock) && m_showClock) {
             // Update the clock in every update
-            stockDisplays--;
-            startDisplay++;
-            int8_t curPage = m_holdingsDisplayFrom / stockDisplays + 1;
-            int8_t totalPages = (m_portfolio.getHoldingsCount() - 1) / stockDisplays + 1;
+            m_stockDisplays--;
+            m_startDisplay++;
+            int8_t curPage = m_holdingsDisplayFrom / m_stockDisplays + 1;
+            int8_t totalPages = (m_portfolio.getHoldingsCount() - 1) / m_stockDisplays + 1;
             String extra = String(curPage) + "/" + String(totalPages);
-            displayClock(0, TFT_BLACK, TFT_WHITE, extra, TFT_DARKGREY);
+            displayClock(0, TFT_BLACK, TFT_WHITE, extra, TFT_DARKGREY, force);
             m_clockDelayPrev = millis();
         }
-        if (updateStocks) {
-            // Update the stocks only if necessary
-            for (int8_t i = 0; i < stockDisplays; i++) {
-                int8_t displayIdx = startDisplay + i;
-                int8_t holdingIdx = m_holdingsDisplayFrom + i;
-                if (holdingIdx < m_portfolio.getHoldingsCount()) {
-                    ParqetHoldingDataModel holding = m_portfolio.getHolding(holdingIdx);
-                    displayStock(displayIdx, holding, TFT_BLACK, TFT_WHITE);
-                } else {
-                    clearScreen(displayIdx, TFT_BLACK);
-                }
-            }
-            // In the next cycle, show the next set of stocks
-            m_holdingsDisplayFrom += stockDisplays;
-            if (m_holdingsDisplayFrom >= m_portfolio.getHoldingsCount()) {
-                m_holdingsDisplayFrom = 0;
-            }
-            m_changed = false;
-            m_cycleDelayPrev = millis();
+        if (!updateStocks) {
+            m_everDrawn = true;
+            return true;
         }
+        // Changes arriving during the next steps are drawn in the next frame
+        m_changed = false;
+        return false;
+    }
+
+    // Update the stocks, one screen per step
+    int8_t i = step - 1;
+    int8_t displayIdx = m_startDisplay + i;
+    int8_t holdingIdx = m_holdingsDisplayFrom + i;
+    if (holdingIdx < m_portfolio.getHoldingsCount()) {
+        ParqetHoldingDataModel holding = m_portfolio.getHolding(holdingIdx);
+        displayStock(displayIdx, holding, TFT_BLACK, TFT_WHITE);
+    } else {
+        clearScreen(displayIdx, TFT_BLACK);
+    }
+    if (i < m_stockDisplays - 1) {
+        return false;
     }
+
+    // In the next cycle, show the next set of stocks
+    m_holdingsDisplayFrom += m_stockDisplays;
+    if (m_holdingsDisplayFrom >= m_portfolio.getHoldingsCount()) {
+        m_holdingsDisplayFrom = 0;
+    }
+    m_cycleDelayPrev = millis();
     m_everDrawn = true;
+    return true;
 }
 
 void ParqetWidget::update(bool force) {
 
     Serial.println("Update ParqetPortfolio");
     if (m_everDrawn && m_showClock) {
-        displayClock(0, TFT_BLACK, TFT_WHITE, "Updating", TFT_RED);
+        displayClock(0, TFT_BLACK, TFT_WHITE, "Updating", TFT_RED, false);
     }
     updatePortfolio();
 }
 
+void ParqetWidget::prefetch() {
+    // Same as update() but without the "Updating" hint, we are not on screen yet
+    if (isItTimeToUpdate()) {
+        updatePortfolio();
+    }
+}
+
 void ParqetWidget::buttonPressed(uint8_t buttonId, ButtonState state) {
     if (buttonId == BUTTON_OK && state == BTN_SHORT) {
         // Force drawing to show the next set of stocks
-        draw(true);
+        requestRedraw();
     } else if (buttonId == BUTTON_OK && state == BTN_MEDIUM) {
         // Change timeframe and force update
         m_curMode++;
@@ -145,9 +178,7 @@ void ParqetWidget::updatePortfolio() {
     httpRequestAddress += "?id=" + String(m_portfolioId.c_str()) + "&timeframe=" + getTimeframe() + "&perf=" + getPerfMeasure() + "&perfChart=" + getPerfChartMeasure();
 
     auto task = TaskFactory::createHttpGetTask(
-        httpRequestAddress, [this](int httpCode, const String &response) {
-            processResponse(httpCode, response);
-        });
+        httpRequestAddress, [this](int httpCode, const String &response) { processResponse(httpCode, response); }, [this](int httpCode, String &response) { preProcessResponse(httpCode, response); });
 
     if (!task) {
         Serial.println("Failed to create parqet task");
@@ -161,6 +192,39 @@ void ParqetWidget::updatePortfolio() {
     }
 }
 
+// Runs in the network task (core 0): strip the response down to the fields we use,
+// so the parse in processResponse() doesn't stall rendering on the main loop
+void ParqetWidget::preProcessResponse(int httpCode, String &response) {
+    if (httpCode == 200) {
+        JsonDocument filter;
+        JsonObject holding = filter["holdings"].add<JsonObject>();
+        holding["assetType"] = true;
+        holding["id"] = true;
+        holding["name"] = true;
+        holding["priceStart"] = true;
+        holding["valueStart"] = true;
+        holding["priceNow"] = true;
+        holding["valueNow"] = true;
+        holding["shares"] = true;
+        holding["perf"] = true;
+        holding["currency"] = true;
+        filter["performance"]["valueStart"] = true;
+        filter["performance"]["valueNow"] = true;
+        filter["performance"]["perf"] = true;
+        filter["chart"] = true;
+
+        JsonDocument doc;
+        DeserializationError error = deserializeJson(doc, response, DeserializationOption::Filter(filter));
+        PARQET_DEBUG_PRINT_MEM("after filtered deserializeJson()");
+
+        if (!error) {
+            response = doc.as<String>();
+        } else {
+            Log.errorln("Deserialization failed: %s", error.c_str());
+        }
+    }
+}
+
 void ParqetWidget::processResponse(int httpCode, const String &response) {
     PARQET_DEBUG_PRINT_MEM("start processResponse()");
     PARQET_DEBUG_PRINT("HTTP %d, Size %d", httpCode, response.length());
@@ -177,10 +241,14 @@ void ParqetWidget::processResponse(int httpCode, const String &response) {
         if (!error) {
             JsonArray holdings = doc["holdings"];
             // Initialize a new array (reserver one extra element for totals)
-            auto *holdingArray = new ParqetHoldingDataModel[holdings.size() + 1];
+            auto *holdingArray = new ParqetHoldingDataModel[min(holdings.size(), (size_t) PARQET_MAX_HOLDINGS) + 1];
             PARQET_DEBUG_PRINT_MEM("after new holdingArray");
             int count = 0;
             for (JsonVariant holding : holdings) {
+                if (count == PARQET_MAX_HOLDINGS) {
+                    Log.warningln("Portfolio has more than %d holdings, the rest is dropped", PARQET_MAX_HOLDINGS);
+                    break;
+                }
                 String type = holding["assetType"].as<String>();
                 String id = holding["id"].as<String>();
                 String name = holding["name"].as<String>();
@@ -228,12 +296,16 @@ void ParqetWidget::processResponse(int httpCode, const String &response) {
             m_portfolio.setHoldings(holdingArray, count);
             PARQET_DEBUG_PRINT_MEM("after setHoldings()");
             JsonArray chart = doc["chart"];
-            float *chartsArray = new float[chart.size()];
+            float *chartsArray = new float[min(chart.size(), (size_t) PARQET_MAX_CHART_POINTS)];
             count = 0;
             for (JsonVariant val : chart) {
+                if (count == PARQET_MAX_CHART_POINTS) {
+                    break;
+                }
                 chartsArray[count++] = val.as<float>();
             }
             m_portfolio.setChartData(chartsArray, count);
+            saveSnapshot();
 
         } else {
             // Handle JSON deserialization error
@@ -250,32 +322,70 @@ void ParqetWidget::processResponse(int httpCode, const String &response) {
     m_changed = true;
 }
 
+bool ParqetWidget::restoreSnapshot() {
+    SnapshotReader reader("parqet", SNAPSHOT_VERSION, getSnapshotKey());
+    if (!reader.ok() || !m_portfolio.restoreSnapshot(reader)) {
+        return false;
+    }
+    snapshotRestored(reader);
+    Log.noticeln("Restored %d Parqet holdings (%d s old)", m_portfolio.getHoldingsCount(), reader.getAge());
+    m_changed = true;
+    return true;
+}
+
+void ParqetWidget::saveSnapshot() {
+    dataRefreshed();
+    SnapshotWriter writer("parqet", SNAPSHOT_VERSION, getSnapshotKey());
+    m_portfolio.saveSnapshot(writer);
+    m_snapshotDirty = !writer.commit();
+}
+
+bool ParqetWidget::hibernate() {
+    // Only drop data that is in the snapshot
+    if (m_snapshotDirty || !DataSnapshot::exists("parqet")) {
+        return false;
+    }
+    m_portfolio.clear();
+    return true;
+}
+
+String ParqetWidget::getSnapshotKey() {
+    // Only the data for the current selection is valid, e.g. a snapshot of another timeframe is ignored
+    return String(m_portfolioId.c_str()) + "|" + getTimeframe() + "|" + getPerfMeasure() + "|" + getPerfChartMeasure() + "|" + String(m_showTotalScreen);
+}
+
 void ParqetWidget::clearScreen(int8_t displayIndex, int32_t background) {
     m_manager.selectScreen(displayIndex);
     m_manager.fillScreen(background);
 }
 
-void ParqetWidget::displayClock(int8_t displayIndex, uint32_t background, uint32_t color, String extra, uint32_t extraColor) {
+void ParqetWidget::displayClock(int8_t displayIndex, uint32_t background, uint32_t color, String extra, uint32_t extraColor, bool force) {
     // Serial.printf("displayClock at screen %d\n", displayIndex);
     m_manager.selectScreen(displayIndex);
 
-    int clky = 105;
+    if (force || background != m_clockBackground) {
+        m_manager.fillScreen(background);
+        m_clockFace.invalidate();
+        m_clockBackground = background;
+        m_clockBarsMode = -1;
+    }
+    m_clockFace.drawLine(m_manager, 0, m_time->getDayAndMonth(), color, background);
+    m_clockFace.draw(m_manager, m_time->getHourPadded(), m_time->getMinutePadded(), color, background);
 
-    m_manager.fillScreen(background);
+    // The bars only change with the page, the "Updating" hint or the timeframe
+    if (m_clockBarsMode == m_curMode && extra == m_clockBarsExtra && extraColor == m_clockBarsColor) {
+        return;
+    }
+    m_clockBarsMode = m_curMode;
+    m_clockBarsExtra = extra;
+    m_clockBarsColor = extraColor;
     m_manager.setFontColor(color);
-    m_manager.drawString(m_time->getDayAndMonth(), ScreenCenterX, clky + 60, 16, Align::MiddleCenter);
-
-    m_manager.drawString(m_time->getHourPadded(), ScreenCenterX - 10, clky, 66, Align::MiddleRight);
-    m_manager.drawString(m_time->getMinutePadded(), ScreenCenterX + 10, clky, 66, Align::MiddleLeft);
-    m_manager.drawString(":", ScreenCenterX, clky, 66, Align::MiddleCenter);
-
     m_manager.fillRect(0, 0, 240, 50, extraColor);
     m_manager.setBackgroundColor(extraColor);
     m_manager.drawString(extra, ScreenCenterX, 27, 18, Align::MiddleCenter);
 
     m_manager.fillRect(0, 190, 240, 50, extraColor);
-    const String timeframe = i18nStr(t_pqTimeframes, m_curMode);
-    m_manager.drawString(timeframe, ScreenCenterX, 210, 16, Align::MiddleCenter);
+    m_manager.drawString(i18n(t_pqTimeframes, m_curMode), ScreenCenterX, 210, 16, Align::MiddleCenter);
 }
 
 void ParqetWidget::displayStock(int8_t displayIndex, ParqetHoldingDataModel &stock, uint32_t backgroundColor, uint32_t textColor) {
@@ -343,29 +453,34 @@ void ParqetWidget::displayStock(int8_t displayIndex, ParqetHoldingDataModel &sto
         if (zeroAtY < minAtY - 15 || zeroAtY > minAtY) {
             // Show minVal if the zero line is not interfering
             m_manager.drawLine(0, minAtY, 240, minAtY, TFT_DARKGREY);
-            m_manager.drawString(String(minVal) + "%", 25, minAtY, 11, Align::BottomLeft);
+            m_manager.drawString(FrameString::format("%.2f%%", minVal), 25, minAtY, 11, Align::BottomLeft);
         }
         if (zeroAtY > maxAtY + 15 || zeroAtY < maxAtY) {
             // Show maxVal if the zero line is not interfering
             m_manager.drawLine(0, maxAtY, 240, maxAtY, TFT_DARKGREY);
-            m_manager.drawString(String(maxVal) + "%", 25, maxAtY, 11, Align::TopLeft);
+            m_manager.drawString(FrameString::format("%.2f%%", maxVal), 25, maxAtY, 11, Align::TopLeft);
         }
     } else {
-        // Draw stock data (multiline)
-        String wrappedLines[MAX_WRAPPED_LINES];
-        String dataValues = stock.getName();
-        int yOffset = 100;
-        int lineCount = Utils::getWrappedLines(wrappedLines, dataValues, 14);
+        // Draw stock data (multiline), with the largest font that needs the fewest lines
+        const char *name = stock.getName().c_str();
+        const int height = 30;
+        TextLine lines[PARQET_MAX_STOCKNAME_LINES + 1];
+        int lineCount = 0;
+        int fontSize = 0;
+        int yOffset = 0;
+        for (int maxLines = 1; maxLines <= PARQET_MAX_STOCKNAME_LINES; maxLines++) {
+            fontSize = 17 + 6 / maxLines;
+            yOffset = 100 + (PARQET_MAX_STOCKNAME_LINES - maxLines) * height / 2;
+            // One spare line tells if the name would need more
+            lineCount = m_manager.wrapText(name, fontSize, yOffset, height, lines, maxLines + 1);
+            if (lineCount <= maxLines) {
+                break;
+            }
+        }
         if (lineCount > PARQET_MAX_STOCKNAME_LINES) {
             lineCount = PARQET_MAX_STOCKNAME_LINES;
         }
-        int height = 30;
-        yOffset += (PARQET_MAX_STOCKNAME_LINES - lineCount) * height / 2;
-        for (int i = 0; i < lineCount; i++) {
-            // Lager font if we need less lines
-            int fontSize = 17 + 6 / lineCount;
-            m_manager.drawString(wrappedLines[i], 120, yOffset + (height * i), fontSize, Align::MiddleCenter);
-        }
+        m_manager.drawWrappedText(name, lines, lineCount, ScreenCenterX, yOffset, height, fontSize);
     }
 
     uint32_t stockColor = TFT_DARKGREY;
@@ -1,6 +1,7 @@
 #ifndef PARQET_WIDGET_H
 #define PARQET_WIDGET_H
 
+#include "ClockFace.h"
 #include "GlobalTime.h"
 #include "ParqetDataModel.h"
 #include "ShowMemoryUsage.h"
@@ -43,25 +44,47 @@
     #define PARQET_PROXY_URL "https://parqet-proxy.ce-data.net/proxy"
 #endif
 
-class ParqetWidget : public Widget {
+// Settings of the portal, registered by WidgetRegistry without the widget while it is disabled
+struct ParqetSettings {
+    std::string m_portfolioId = PARQET_PORTFOLIO_ID;
+    int m_defaultMode = 0;
+    int m_defaultPerfMeasure = 0;
+    int m_defaultPerfChartMeasure = 0;
+    boolean m_showClock = true; // Show clock on first screen
+    boolean m_showTotalScreen = true; // Show a total portfolio screen
+    boolean m_showTotalValue = false; // Show your total portfolio value
+    int m_showValues = 0; // Show current price (0) or value in portfolio (1)
+    std::string m_proxyUrl = PARQET_PROXY_URL;
+
+    void addConfig(ConfigManager &config);
+};
+
+class ParqetWidget : public Widget, protected ParqetSettings {
 public:
     ParqetWidget(ScreenManager &manager, ConfigManager &config);
     void setup() override;
     void update(bool force = false) override;
     void draw(bool force = false) override;
+    bool drawStep(bool force, uint8_t step) override;
+    void prefetch() override;
     void buttonPressed(uint8_t buttonId, ButtonState state) override;
     String getName() override;
+    bool restoreSnapshot() override;
+    bool hibernate() override;
 
 private:
+    void saveSnapshot();
+    String getSnapshotKey();
     String getTimeframe();
     String getPerfMeasure();
     String getPerfChartMeasure();
     void updatePortfolio();
+    void preProcessResponse(int httpCode, String &response);
     void processResponse(int httpCode, const String &response);
     void displayStock(int8_t displayIndex, ParqetHoldingDataModel &stock, uint32_t backgroundColor, uint32_t textColor);
     ParqetDataModel getPortfolio();
     void clearScreen(int8_t displayIndex, int32_t background);
-    void displayClock(int8_t displayIndex, uint32_t background, uint32_t color, String extra, uint32_t extraColor);
+    void displayClock(int8_t displayIndex, uint32_t background, uint32_t color, String extra, uint32_t extraColor, bool force);
 
     GlobalTime *m_time;
 
@@ -70,30 +93,31 @@ private:
 
     unsigned long m_clockDelay = 60 * 1000; // update the clock every minute
     unsigned long m_clockDelayPrev = 0;
+    ClockFace m_clockFace;
+    // What the clock screen shows besides the face
+    uint32_t m_clockBackground = 0;
+    String m_clockBarsExtra;
+    uint32_t m_clockBarsColor = 0;
+    int m_clockBarsMode = -1;
 
     String m_modes[PARQET_MODE_COUNT] = {"today", "1w", "1m", "3m", "6m", "1y", "3y", "mtd", "ytd", "max"}; // Possible timeframes: today, 1w, 1m, 3m, 6m, 1y, 3y, mtd, ytd, max
-    int m_defaultMode = 0;
     int m_curMode = 0;
 
     String m_perfMeasures[PARQET_PERF_COUNT] = {"totalReturnGross", "totalReturnNet", "returnGross", "returnNet", "ttwror", "izf"};
-    int m_defaultPerfMeasure = 0;
     int m_curPerfMeasure = 0;
 
     String m_perfChartMeasures[PARQET_PERF_CHART_COUNT] = {"perfHistory", "perfHistoryUnrealized", "ttwror", "drawdown"};
-    int m_defaultPerfChartMeasure = 0;
     int m_curPerfChartMeasure = 0;
 
-    boolean m_showClock = true; // Show clock on first screen
-    boolean m_showTotalScreen = true; // Show a total portfolio screen
-    boolean m_showTotalValue = false; // Show your total portfolio value
     boolean m_showTotalChart = true; // Show performance chart for total (if we have more than 7 datapoints, ie. not for "today")
     String m_overrideTotalChartToday = "1w"; // Show this chart for "today" to have a chart there as well, set to empty string to disable
-    int m_showValues = 0; // Show current price (0) or value in portfolio (1)
 
-    std::string m_portfolioId = PARQET_PORTFOLIO_ID;
-    std::string m_proxyUrl = PARQET_PROXY_URL;
     ParqetDataModel m_portfolio;
+    static constexpr uint8_t SNAPSHOT_VERSION = 1;
+    bool m_snapshotDirty = false;
     int m_holdingsDisplayFrom = 0;
+    int8_t m_stockDisplays = 5; // screens used for stocks in the current draw
+    int8_t m_startDisplay = 0; // first screen used for stocks in the current draw
     boolean m_changed = false;
     boolean m_everDrawn = false; // Track if our widget was ever drawn (to distinguish between an onboot and an onwidget update)
 
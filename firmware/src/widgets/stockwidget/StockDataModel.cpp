@@ -7,74 +7,72 @@ StockDataModel::StockDataModel() {
 
 StockDataModel &StockDataModel::setCurrencySymbol(String currencySymbol) {
     currencySymbol.toUpperCase();
+    const char *symbol = "$";
     if (currencySymbol == "EUR") {
-        m_currencySymbol = m_currencySymbolEUR;
+        symbol = "€";
     } else if (currencySymbol == "GBP") {
-        m_currencySymbol = m_currencySymbolGBP;
+        symbol = "£";
     } else if (getSymbol().indexOf("/EUR") != -1) {
-        m_currencySymbol = m_currencySymbolEUR;
+        symbol = "€";
     } else if (getSymbol().indexOf("/GBP") != -1) {
-        m_currencySymbol = m_currencySymbolGBP;
-    } else {
-        m_currencySymbol = "$";
+        symbol = "£";
+    }
+    if (m_currencySymbol != symbol) {
+        m_currencySymbol = symbol;
+        m_changedFields |= CURRENCY;
     }
     return *this;
 }
 
-String StockDataModel::getCurrencySymbol() {
+const InternedString &StockDataModel::getCurrencySymbol() const {
     return m_currencySymbol;
 }
 
-StockDataModel &StockDataModel::setSymbol(String symbol) {
-    if (m_symbol != symbol) {
-        m_symbol = String(symbol);
-        // This is not a regular data field so do not mark changed when set
-    }
+StockDataModel &StockDataModel::setSymbol(const String &symbol) {
+    // This is not a regular data field so do not mark changed when set
+    m_symbol = symbol;
     return *this;
 }
-String StockDataModel::getSymbol() {
+const FixedString<24> &StockDataModel::getSymbol() const {
     return m_symbol;
 }
 
-StockDataModel &StockDataModel::setTicker(String ticker) {
-    if (m_ticker != ticker) {
-        m_ticker = String(ticker);
-        // This is not a regular data field so do not mark changed when set
-    }
+StockDataModel &StockDataModel::setTicker(const String &ticker) {
+    // This is not a regular data field so do not mark changed when set
+    m_ticker = ticker;
     return *this;
 }
-String StockDataModel::getTicker() {
+const FixedString<16> &StockDataModel::getTicker() const {
     return m_ticker;
 }
 
-StockDataModel &StockDataModel::setCompany(String company) {
-    if (m_company != company) {
-        m_company = company;
-        m_changed = true;
+StockDataModel &StockDataModel::setCompany(const String &company) {
+    if (m_company.set(company)) {
+        m_changedFields |= COMPANY;
     }
     return *this;
 }
-String StockDataModel::getCompany() {
+const FixedString<48> &StockDataModel::getCompany() const {
     return m_company;
 }
 StockDataModel &StockDataModel::setCurrentPrice(float currentPrice) {
     if (m_currentPrice != currentPrice) {
         m_currentPrice = currentPrice;
-        m_changed = true;
+        m_changedFields |= CURRENT_PRICE;
     }
     return *this;
 }
 float StockDataModel::getCurrentPrice() {
     return m_currentPrice;
 }
-String StockDataModel::getCurrentPrice(int8_t digits) {
+FrameString StockDataModel::getCurrentPrice(int8_t digits) {
     return Utils::formatFloat(m_currentPrice, digits);
 }
 
 StockDataModel &StockDataModel::setHighPrice(float highPrice) {
     if (m_highPrice != highPrice) {
         m_highPrice = highPrice;
-        m_changed = true;
+        m_changedFields |= HIGH_PRICE;
     }
     return *this;
 }
@@ -83,14 +81,14 @@ float StockDataModel::getHighPrice() {
     return m_highPrice;
 }
 
-String StockDataModel::getHighPrice(int8_t digits) {
+FrameString StockDataModel::getHighPrice(int8_t digits) {
     return Utils::formatFloat(m_highPrice, digits);
 }
 
 StockDataModel &StockDataModel::setLowPrice(float lowPrice) {
     if (m_lowPrice != lowPrice) {
         m_lowPrice = lowPrice;
-        m_changed = true;
+        m_changedFields |= LOW_PRICE;
     }
     return *this;
 }
@@ -99,28 +97,28 @@ float StockDataModel::getLowPrice() {
     return m_lowPrice;
 }
 
-String StockDataModel::getLowPrice(int8_t digits) {
+FrameString StockDataModel::getLowPrice(int8_t digits) {
     return Utils::formatFloat(m_lowPrice, digits);
 }
 
 StockDataModel &StockDataModel::setPriceChange(float priceChange) {
     if (m_priceChange != priceChange) {
         m_priceChange = priceChange;
-        m_changed = true;
+        m_changedFields |= PRICE_CHANGE;
     }
     return *this;
 }
 float StockDataModel::getPriceChange() {
     return m_priceChange;
 }
-String StockDataModel::getPriceChange(int8_t digits) {
+FrameString StockDataModel::getPriceChange(int8_t digits) {
     return Utils::formatFloat(m_priceChange, digits);
 }
 
 StockDataModel &StockDataModel::setPercentChange(float percentChange) {
     if (m_percentChange != percentChange) {
         m_percentChange = percentChange;
-        m_changed = true;
+        m_changedFields |= PERCENT_CHANGE;
     }
     return *this;
 }
@@ -128,15 +126,24 @@ float StockDataModel::getPercentChange() {
     return m_percentChange;
 }
 
-String StockDataModel::getPercentChange(int8_t digits) {
+FrameString StockDataModel::getPercentChange(int8_t digits) {
     return Utils::formatFloat(m_percentChange * 100, digits);
 }
 
 bool StockDataModel::isChanged() {
-    return m_changed;
+    return m_changedFields != 0;
 }
 StockDataModel &StockDataModel::setChangedStatus(bool changed) {
-    m_changed = changed;
+    m_changedFields = changed ? ALL_FIELDS : 0;
+    return *this;
+}
+
+uint16_t StockDataModel::getChangedFields() const {
+    return m_changedFields;
+}
+
+StockDataModel &StockDataModel::clearChangedFields(uint16_t fields) {
+    m_changedFields &= ~fields;
     return *this;
 }
 
@@ -148,3 +155,29 @@ StockDataModel &StockDataModel::setInitializationStatus(bool initialized) {
     m_initialized = initialized;
     return *this;
 }
+
+void StockDataModel::saveSnapshot(SnapshotWriter &writer) {
+    writer.write(m_symbol);
+    writer.write(m_ticker);
+    writer.write(m_company);
+    writer.write(m_currencySymbol);
+    writer.write(m_currentPrice);
+    writer.write(m_highPrice);
+    writer.write(m_lowPrice);
+    writer.write(m_priceChange);
+    writer.write(m_percentChange);
+}
+
+bool StockDataModel::restoreSnapshot(SnapshotReader &reader) {
+    reader.read(m_symbol);
+    reader.read(m_ticker);
+    reader.read(m_company);
+    reader.read(m_currencySymbol);
+    reader.read(m_currentPrice);
+    reader.read(m_highPrice);
+    reader.read(m_lowPrice);
+    reader.read(m_priceChange);
+    reader.read(m_percentChange);
+    m_changedFields = ALL_FIELDS;
+    return reader.ok();
+}
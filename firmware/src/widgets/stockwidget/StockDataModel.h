@@ -1,55 +1,74 @@
 #ifndef STOCK_DATA_MODEL_H
 #define STOCK_DATA_MODEL_H
 
+#include "DataSnapshot.h"
+#include "FrameString.h"
 #include <Arduino.h>
 
 #include <iomanip>
 
 class StockDataModel {
 public:
+    // Fields for getChangedFields(), symbol and ticker identify the stock and aren't tracked
+    enum Field : uint16_t {
+        CURRENCY = 1 << 0,
+        COMPANY = 1 << 1,
+        CURRENT_PRICE = 1 << 2,
+        HIGH_PRICE = 1 << 3,
+        LOW_PRICE = 1 << 4,
+        PRICE_CHANGE = 1 << 5,
+        PERCENT_CHANGE = 1 << 6,
+        ALL_FIELDS = (1 << 7) - 1
+    };
+
     StockDataModel();
     StockDataModel &setCurrencySymbol(String currencySymbol);
-    String getCurrencySymbol();
-    StockDataModel &setSymbol(String symbol);
-    String getSymbol();
-    StockDataModel &setTicker(String ticker);
-    String getTicker();
-    StockDataModel &setCompany(String company);
-    String getCompany();
+    const InternedString &getCurrencySymbol() const;
+    StockDataModel &setSymbol(const String &symbol);
+    const FixedString<24> &getSymbol() const;
+    StockDataModel &setTicker(const String &ticker);
+    const FixedString<16> &getTicker() const;
+    StockDataModel &setCompany(const String &company);
+    const FixedString<48> &getCompany() const;
     StockDataModel &setCurrentPrice(float currentPrice);
     float getCurrentPrice();
-    String getCurrentPrice(int8_t digits);
+    FrameString getCurrentPrice(int8_t digits);
     StockDataModel &setHighPrice(float volume);
     float getHighPrice();
-    String getHighPrice(int8_t digits);
+    FrameString getHighPrice(int8_t digits);
     StockDataModel &setLowPrice(float volume);
     float getLowPrice();
-    String getLowPrice(int8_t digits);
+    FrameString getLowPrice(int8_t digits);
     StockDataModel &setPriceChange(float change);
     float getPriceChange();
-    String getPriceChange(int8_t digits);
+    FrameString getPriceChange(int8_t digits);
     StockDataModel &setPercentChange(float percentChange);
     float getPercentChange();
-    String getPercentChange(int8_t digits);
+    FrameString getPercentChange(int8_t digits);
+    // Any field changed, setChangedStatus() marks all or no fields
     bool isChanged();
     StockDataModel &setChangedStatus(bool changed);
+    uint16_t getChangedFields() const;
+    // Call with the fields that have been drawn
+    StockDataModel &clearChangedFields(uint16_t fields);
     bool isInitialized();
     StockDataModel &setInitializationStatus(bool initialized);
 
+    void saveSnapshot(SnapshotWriter &writer);
+    bool restoreSnapshot(SnapshotReader &reader);
+
 private:
-    String m_symbol = "";
-    String m_ticker = "";
-    String m_company = "";
-    String m_currencySymbolGBP = "£";
-    String m_currencySymbolEUR = "€";
-    String m_currencySymbol = "";
+    FixedString<24> m_symbol;
+    FixedString<16> m_ticker;
+    FixedString<48> m_company;
+    InternedString m_currencySymbol;
     float m_currentPrice = 0.0;
     float m_volume = 0.0;
     float m_highPrice = 0.0;
     float m_lowPrice = 0.0;
     float m_priceChange = 0.0;
     float m_percentChange = 0.0;
-    bool m_changed = false;
+    uint16_t m_changedFields = 0;
     bool m_initialized = false;
 };
 
@@ -5,6 +5,12 @@
 #include <ArduinoLog.h>
 #include <iomanip>
 
+void StockSettings::addConfig(ConfigManager &config) {
+    config.addConfigString("StockWidget", "stockList", &m_stockList, 200, t_stockList);
+    config.addConfigComboBox("StockWidget", "stockchgFmt", &m_stockchangeformat, t_stockChangeFormats, t_stockChangeFormat, true);
+    config.addConfigInt("StockWidget", "stockPaginate", &m_switchinterval, t_stockSwitchInterval, true);
+}
+
 StockWidget::StockWidget(ScreenManager &manager, ConfigManager &config)
     : Widget(manager, config),
       m_drawTimer(addDrawRefreshFrequency(STOCK_DRAW_DELAY)),
@@ -12,28 +18,42 @@ StockWidget::StockWidget(ScreenManager &manager, ConfigManager &config)
     m_enabled = (INCLUDE_STOCK == WIDGET_ON);
 
     m_config.addConfigBool("StockWidget", "stocksEnabled", &m_enabled, t_enableWidget);
-    m_config.addConfigString("StockWidget", "stockList", &m_stockList, 200, t_stockList);
-    char stockList[m_stockList.size()];
-    strcpy(stockList, m_stockList.c_str());
+    addConfig(m_config);
 
-    m_config.addConfigComboBox("StockWidget", "stockchgFmt", &m_stockchangeformat, t_stockChangeFormats, t_stockChangeFormat, true);
-    m_config.addConfigInt("StockWidget", "stockPaginate", &m_switchinterval, t_stockSwitchInterval, true);
+    // Settings that can be applied without a restart
+    m_config.addOnChangeCallback("StockWidget", "stockList", [this](const char *section, const char *varName) {
+        parseStockList();
+        update(true);
+    });
+    auto redrawOnly = [](const char *section, const char *varName) {}; // read on every draw
+    m_config.addOnChangeCallback("StockWidget", "stockchgFmt", redrawOnly);
+    m_config.addOnChangeCallback("StockWidget", "stockPaginate", redrawOnly);
 
-    char *symbol = strtok(stockList, ",");
+    parseStockList();
+    Log.infoln("StockWidget initialized");
+    Log.traceln("StockWidget Pages: %d across %d symbools.", m_pageCount, m_stockCount);
+}
+
+void StockWidget::parseStockList() {
+    char stockList[m_stockList.size() + 1];
+    strcpy(stockList, m_stockList.c_str());
+
+    for (int8_t i = 0; i < MAX_STOCKS; i++) {
+        m_stocks[i] = StockDataModel();
+    }
+    m_generation++;
+    m_pendingResponses = 0;
     m_stockCount = 0;
-    do {
+    for (char *symbol = strtok(stockList, ","); symbol != nullptr; symbol = strtok(nullptr, ",")) {
         if (m_stockCount >= MAX_STOCKS) {
             Log.warningln("MAX STOCKS UNABLE TO ADD MORE");
             break;
         }
-        StockDataModel stockModel = StockDataModel();
-        stockModel.setSymbol(String(symbol));
-        m_stocks[m_stockCount] = stockModel;
+        m_stocks[m_stockCount].setSymbol(String(symbol));
         m_stockCount++;
-    } while (symbol = strtok(nullptr, ","));
+    }
+    m_page = 0;
     m_pageCount = 1 + ((m_stockCount - 1) / NUM_SCREENS); // int division round up
-    Log.infoln("StockWidget initialized");
-    Log.traceln("StockWidget Pages: %d across %d symbools.", m_pageCount, m_stockCount);
 }
 
 void StockWidget::setup() {
@@ -42,27 +62,40 @@ void StockWidget::setup() {
         return;
     }
     m_prevMillisSwitch = millis();
+    // Percent change
+    m_manager.addToGlyphAtlas(DEFAULT_FONT, 29);
 }
 
 void StockWidget::draw(bool force) {
     m_manager.setFont(DEFAULT_FONT);
+    // Screens that are loading or empty look the same, each group is drawn at once
+    uint8_t loadingScreens = 0;
+    uint8_t emptyScreens = 0;
     for (int8_t i = m_page * NUM_SCREENS; i < (m_page + 1) * NUM_SCREENS; i++) {
         int8_t displayIndex = i % NUM_SCREENS;
         if (!m_stocks[i].isInitialized() && !m_stocks[i].getSymbol().isEmpty() && m_stocks[i].getTicker().isEmpty()) {
-            m_manager.selectScreen(displayIndex);
-            m_manager.clearScreen(displayIndex);
-            m_manager.setFontColor(TFT_WHITE, TFT_BLACK);
-            m_manager.drawCentreString(I18n::get(t_loadingData), ScreenCenterX, ScreenCenterY, 16);
+            loadingScreens |= SCREEN_MASK(displayIndex);
+            m_screenLayout[displayIndex] = "";
         } else if ((m_stocks[i].isChanged() || force) && !m_stocks[i].getSymbol().isEmpty()) {
             Log.traceln("StockWidget::draw - %s", m_stocks[i].getSymbol().c_str());
-            displayStock(displayIndex, m_stocks[i], TFT_WHITE, TFT_BLACK);
+            displayStock(displayIndex, m_stocks[i], TFT_WHITE, TFT_BLACK, force);
             m_stocks[i].setChangedStatus(false);
             m_stocks[i].setInitializationStatus(true);
         } else if (force) {
-            m_manager.selectScreen(displayIndex);
-            m_manager.clearScreen(displayIndex);
+            emptyScreens |= SCREEN_MASK(displayIndex);
+            m_screenLayout[displayIndex] = "";
         }
     }
+    if (loadingScreens != 0) {
+        m_manager.selectScreens(loadingScreens);
+        m_manager.fillScreen(TFT_BLACK);
+        m_manager.setFontColor(TFT_WHITE, TFT_BLACK);
+        m_manager.drawCentreString(I18n::get(t_loadingData), ScreenCenterX, ScreenCenterY, 16);
+    }
+    if (emptyScreens != 0) {
+        m_manager.selectScreens(emptyScreens);
+        m_manager.fillScreen(TFT_BLACK);
+    }
 
     if ((millis() - m_prevMillisSwitch >= (m_switchinterval * 1000)) && m_switchinterval > 0) {
         nextPage();
@@ -71,22 +104,28 @@ void StockWidget::draw(bool force) {
 
 void StockWidget::update(bool force) {
 
+    m_pendingResponses = m_stockCount;
     // Queue requests for each stock
     for (int8_t i = 0; i < m_stockCount; i++) {
         Log.traceln("StockWidget::update - %s", m_stocks[i].getSymbol().c_str());
         String url = String(STOCK_API_URL) + "?apikey=" + String(STOCK_API_KEY) + "&symbol=" + m_stocks[i].getSymbol();
 
-        StockDataModel &stock = m_stocks[i];
-
-        auto task = TaskFactory::createHttpGetTask(url, [this, &stock](int httpCode, const String &response) {
-            processResponse(stock, httpCode, response);
+        // The slot may hold another symbol by the time the response arrives
+        uint16_t generation = m_generation;
+        auto task = TaskFactory::createHttpGetTask(url, [this, i, generation](int httpCode, const String &response) {
+            processResponse(i, generation, httpCode, response);
         });
 
         TaskManager::getInstance()->addTask(std::move(task));
     }
 }
 
-void StockWidget::processResponse(StockDataModel &stock, int httpCode, const String &response) {
+void StockWidget::processResponse(int8_t index, uint16_t generation, int httpCode, const String &response) {
+    if (generation != m_generation) {
+        Log.traceln("Dropping response for a stock list that changed");
+        return;
+    }
+    StockDataModel &stock = m_stocks[index];
     if (httpCode > 0) {
         JsonDocument doc;
         DeserializationError error = deserializeJson(doc, response);
@@ -102,6 +141,7 @@ void StockWidget::processResponse(StockDataModel &stock, int httpCode, const Str
                 stock.setCompany(doc["name"].as<String>());
                 stock.setTicker(doc["symbol"].as<String>());
                 stock.setCurrencySymbol(doc["currency"].as<String>());
+                m_snapshotDirty = true;
             } else {
                 Log.warningln("skipping invalid data for: %s", stock.getSymbol().c_str());
             }
@@ -111,6 +151,41 @@ void StockWidget::processResponse(StockDataModel &stock, int httpCode, const Str
     } else {
         Log.errorln("HTTP request failed, error: %d\n", httpCode);
     }
+    if (--m_pendingResponses <= 0 && m_snapshotDirty) {
+        saveSnapshot();
+    }
+}
+
+bool StockWidget::restoreSnapshot() {
+    SnapshotReader reader("stock", SNAPSHOT_VERSION, String(m_stockList.c_str()));
+    int8_t count = 0;
+    if (!reader.ok() || !reader.read(count) || count != m_stockCount) {
+        return false;
+    }
+    StockDataModel restored[MAX_STOCKS];
+    for (int8_t i = 0; i < count; i++) {
+        if (!restored[i].restoreSnapshot(reader) || restored[i].getSymbol() != m_stocks[i].getSymbol()) {
+            return false;
+        }
+    }
+    for (int8_t i = 0; i < count; i++) {
+        m_stocks[i] = restored[i];
+    }
+    snapshotRestored(reader);
+    Log.noticeln("Restored %d stocks (%d s old)", count, reader.getAge());
+    return true;
+}
+
+void StockWidget::saveSnapshot() {
+    dataRefreshed();
+    SnapshotWriter writer("stock", SNAPSHOT_VERSION, String(m_stockList.c_str()));
+    writer.write(m_stockCount);
+    for (int8_t i = 0; i < m_stockCount; i++) {
+        m_stocks[i].saveSnapshot(writer);
+    }
+    if (writer.commit()) {
+        m_snapshotDirty = false;
+    }
 }
 
 void StockWidget::changeMode() {
@@ -124,53 +199,64 @@ void StockWidget::buttonPressed(uint8_t buttonId, ButtonState state) {
         changeMode();
 }
 
-void StockWidget::displayStock(int8_t displayIndex, StockDataModel &stock, uint32_t backgroundColor, uint32_t textColor) {
+void StockWidget::displayStock(int8_t displayIndex, StockDataModel &stock, uint32_t backgroundColor, uint32_t textColor, bool force) {
     Log.infoln("displayStock - %s ~ %s", stock.getSymbol().c_str(), stock.getCurrentPrice(2).c_str());
     if (stock.getCurrentPrice() == 0.0) {
         // There isn't any data to display yet
         return;
     }
     m_manager.selectScreen(displayIndex);
-    m_manager.clearScreen(displayIndex);
 
     // Calculate center positions
     int screenWidth = SCREEN_SIZE;
     int centre = 120;
     int arrowOffsetX = 0;
     int arrowOffsetY = -109;
-
-    // Outputs
-    m_manager.fillRect(0, 70, screenWidth, 49, TFT_WHITE);
-    m_manager.fillRect(0, 111, screenWidth, 20, TFT_LIGHTGREY);
     int smallFontSize = 11;
     int bigFontSize = 29;
-    m_manager.setFontColor(TFT_WHITE, TFT_BLACK);
-    m_manager.drawCentreString(i18n(t_stock52week), centre, 185, smallFontSize);
-    m_manager.drawCentreString(i18nStr(t_highShort) + ": " + stock.getCurrencySymbol() + stock.getHighPrice(), centre, 200, smallFontSize);
-    m_manager.drawCentreString(i18nStr(t_lowShort) + ": " + stock.getCurrencySymbol() + stock.getLowPrice(), centre, 215, smallFontSize);
-    m_manager.setFontColor(TFT_BLACK, TFT_LIGHTGREY);
-    m_manager.drawString(stock.getCompany(), centre, 121, smallFontSize, Align::MiddleCenter);
-    if (stock.getPercentChange() < 0.0) {
-        m_manager.setFontColor(TFT_RED, TFT_BLACK);
-        m_manager.fillTriangle(110 + arrowOffsetX, 120 + arrowOffsetY, 130 + arrowOffsetX, 120 + arrowOffsetY, 120 + arrowOffsetX, 132 + arrowOffsetY, TFT_RED);
-        m_manager.drawArc(centre, centre, 120, 118, 0, 360, TFT_RED, TFT_RED);
-    } else {
-        m_manager.setFontColor(TFT_GREEN, TFT_BLACK);
-        m_manager.fillTriangle(110 + arrowOffsetX, 132 + arrowOffsetY, 130 + arrowOffsetX, 132 + arrowOffsetY, 120 + arrowOffsetX, 120 + arrowOffsetY, TFT_GREEN);
-        m_manager.drawArc(centre, centre, 120, 118, 0, 360, TFT_GREEN, TFT_GREEN);
-    }
-    if (!m_stockchangeformat) {
-        m_manager.drawString(stock.getPercentChange(2) + "%", centre, 48, bigFontSize, Align::MiddleCenter);
-    } else {
-        m_manager.drawString(stock.getCurrencySymbol() + stock.getPriceChange(2), centre, 48, bigFontSize, Align::MiddleCenter);
+    bool falling = stock.getPercentChange() < 0.0;
+    uint32_t changeColor = falling ? TFT_RED : TFT_GREEN;
+
+    // Everything but the numbers only changes with the stock or the direction
+    String layout = stock.getTicker().toString() + "\n" + stock.getCompany().c_str() + (falling ? "-" : "+");
+    uint16_t fields = stock.getChangedFields();
+    if (force || layout != m_screenLayout[displayIndex]) {
+        fields = StockDataModel::ALL_FIELDS;
+        m_manager.clearScreen(displayIndex);
+        m_screenLayout[displayIndex] = layout;
+
+        m_manager.fillRect(0, 70, screenWidth, 49, TFT_WHITE);
+        m_manager.fillRect(0, 111, screenWidth, 20, TFT_LIGHTGREY);
+        m_manager.setFontColor(TFT_WHITE, TFT_BLACK);
+        m_manager.drawCentreString(i18n(t_stock52week), centre, 185, smallFontSize);
+        m_manager.setFontColor(TFT_BLACK, TFT_LIGHTGREY);
+        m_manager.drawString(stock.getCompany(), centre, 121, smallFontSize, Align::MiddleCenter);
+        if (falling) {
+            m_manager.fillTriangle(110 + arrowOffsetX, 120 + arrowOffsetY, 130 + arrowOffsetX, 120 + arrowOffsetY, 120 + arrowOffsetX, 132 + arrowOffsetY, TFT_RED);
+        } else {
+            m_manager.fillTriangle(110 + arrowOffsetX, 132 + arrowOffsetY, 130 + arrowOffsetX, 132 + arrowOffsetY, 120 + arrowOffsetX, 120 + arrowOffsetY, TFT_GREEN);
+        }
+        m_manager.drawArc(centre, centre, 120, 118, 0, 360, changeColor, changeColor);
+        m_manager.setFontColor(TFT_BLACK, TFT_WHITE);
+        m_manager.drawString(stock.getTicker(), centre, 92, bigFontSize, Align::MiddleCenter);
     }
-    // Draw stock data
-    m_manager.setFontColor(TFT_BLACK, TFT_WHITE);
 
-    m_manager.drawString(stock.getTicker(), centre, 92, bigFontSize, Align::MiddleCenter);
+    // Numbers are only drawn if their fields changed and repaint only the digits that did
+    if (fields & (StockDataModel::HIGH_PRICE | StockDataModel::CURRENCY)) {
+        m_manager.drawNumber(0, FrameString::format("%s: %s%s", i18n(t_highShort), stock.getCurrencySymbol().c_str(), stock.getHighPrice(2).c_str()), centre, 200, smallFontSize, Align::MiddleCenter, TFT_WHITE, TFT_BLACK);
+    }
+    if (fields & (StockDataModel::LOW_PRICE | StockDataModel::CURRENCY)) {
+        m_manager.drawNumber(1, FrameString::format("%s: %s%s", i18n(t_lowShort), stock.getCurrencySymbol().c_str(), stock.getLowPrice(2).c_str()), centre, 215, smallFontSize, Align::MiddleCenter, TFT_WHITE, TFT_BLACK);
+    }
+    if (!m_stockchangeformat && (fields & StockDataModel::PERCENT_CHANGE)) {
+        m_manager.drawNumber(2, stock.getPercentChange(2) + "%", centre, 48, bigFontSize, Align::MiddleCenter, changeColor, TFT_BLACK);
+    } else if (m_stockchangeformat && (fields & (StockDataModel::PRICE_CHANGE | StockDataModel::CURRENCY))) {
+        m_manager.drawNumber(2, FrameString(stock.getCurrencySymbol()) + stock.getPriceChange(2), centre, 48, bigFontSize, Align::MiddleCenter, changeColor, TFT_BLACK);
+    }
+    if (fields & (StockDataModel::CURRENT_PRICE | StockDataModel::CURRENCY)) {
+        m_manager.drawNumber(3, FrameString(stock.getCurrencySymbol()) + stock.getCurrentPrice(2), centre, 155, bigFontSize, Align::MiddleCenter, TFT_WHITE, TFT_BLACK);
+    }
     m_manager.setFontColor(TFT_WHITE, TFT_BLACK);
-
-    m_manager.drawString(stock.getCurrencySymbol() + stock.getCurrentPrice(2), centre, 155, bigFontSize, Align::MiddleCenter);
 }
 
 void StockWidget::nextPage() {
@@ -180,7 +266,7 @@ void StockWidget::nextPage() {
     m_prevMillisSwitch = millis();
     m_page = (m_page + 1) % m_pageCount;
     Log.traceln("StockWidget Page: %d", m_page + 1);
-    draw(true);
+    requestRedraw();
 }
 
 String StockWidget::getName() {
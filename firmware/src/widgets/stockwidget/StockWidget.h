@@ -14,7 +14,24 @@
 
 #define MAX_STOCKS 15
 
-class StockWidget : public Widget {
+#ifndef STOCK_CHANGE_FORMAT
+    #define STOCK_CHANGE_FORMAT 0
+#endif
+
+// Settings of the portal, registered by WidgetRegistry without the widget while it is disabled
+struct StockSettings {
+#ifdef STOCK_TICKER_LIST
+    std::string m_stockList = STOCK_TICKER_LIST;
+#else
+    std::string m_stockList = "";
+#endif
+    int m_stockchangeformat = STOCK_CHANGE_FORMAT; // Show percent change (0) or price change (1) for stocks
+    int m_switchinterval = 10;
+
+    void addConfig(ConfigManager &config);
+};
+
+class StockWidget : public Widget, protected StockSettings {
 public:
     StockWidget(ScreenManager &manager, ConfigManager &config);
     void setup() override;
@@ -22,37 +39,36 @@ public:
     void draw(bool force = false) override;
     void buttonPressed(uint8_t buttonId, ButtonState state) override;
     String getName() override;
+    bool restoreSnapshot() override;
 
     void changeMode();
 
 private:
-    void processResponse(StockDataModel &stock, int httpCode, const String &response);
-    void displayStock(int8_t displayIndex, StockDataModel &stock, uint32_t backgroundColor, uint32_t textColor);
+    void saveSnapshot();
+    void parseStockList();
+    void processResponse(int8_t index, uint16_t generation, int httpCode, const String &response);
+    void displayStock(int8_t displayIndex, StockDataModel &stock, uint32_t backgroundColor, uint32_t textColor, bool force);
     void nextPage();
 
     int8_t m_page = 0;
     int8_t m_pageCount = 0;
-
-#ifdef STOCK_TICKER_LIST
-    std::string m_stockList = STOCK_TICKER_LIST;
-#else
-    std::string m_stockList = "";
-#endif
+    // Ticker, name and direction each screen shows, the numbers are drawn with drawNumber()
+    String m_screenLayout[NUM_SCREENS];
 
     StockDataModel m_stocks[MAX_STOCKS];
     int8_t m_stockCount;
 
+    // The snapshot is saved once all responses of an update arrived
+    static constexpr uint8_t SNAPSHOT_VERSION = 1;
+    int8_t m_pendingResponses = 0;
+    bool m_snapshotDirty = false;
+    // Bumped when the stock list is parsed again, responses of requests from before are dropped
+    uint16_t m_generation = 0;
+
 #ifndef STOCK_API_URL
     #define STOCK_API_URL "https://api.twelvedata.com/quote"
 #endif
 
-#ifndef STOCK_CHANGE_FORMAT
-    #define STOCK_CHANGE_FORMAT 0
-#endif
-
-    int m_stockchangeformat = STOCK_CHANGE_FORMAT; // Show percent change (0) or price change (1) for stocks
-
-    int m_switchinterval = 10;
     unsigned long m_prevMillisSwitch = 0;
 
     WidgetTimer &m_drawTimer;
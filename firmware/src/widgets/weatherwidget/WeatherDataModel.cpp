@@ -4,46 +4,44 @@
 WeatherDataModel::WeatherDataModel() {
 }
 
-WeatherDataModel &WeatherDataModel::setCityName(String city) {
-    if (m_cityName != city) {
-        m_cityName = city;
-        m_changed = true;
+WeatherDataModel &WeatherDataModel::setCityName(const String &city) {
+    if (m_cityName.set(city)) {
+        m_changedFields |= CITY_NAME;
     }
     return *this;
 }
 
-String WeatherDataModel::getCityName() {
+const FixedString<48> &WeatherDataModel::getCityName() const {
     return m_cityName;
 }
 
-WeatherDataModel &WeatherDataModel::setCurrentText(String text) {
-    if (m_currentWeatherText != text) {
-        m_currentWeatherText = text;
-        m_changed = true;
+WeatherDataModel &WeatherDataModel::setCurrentText(const String &text) {
+    if (m_currentWeatherText.set(text)) {
+        m_changedFields |= CURRENT_TEXT;
     }
     return *this;
 }
 
-String WeatherDataModel::getCurrentText() {
+const FixedString<128> &WeatherDataModel::getCurrentText() const {
     return m_currentWeatherText;
 }
 
-WeatherDataModel &WeatherDataModel::setCurrentIcon(String icon) {
+WeatherDataModel &WeatherDataModel::setCurrentIcon(const String &icon) {
     if (m_currentWeatherIcon != icon) {
         m_currentWeatherIcon = icon;
-        m_changed = true;
+        m_changedFields |= CURRENT_ICON;
     }
     return *this;
 }
 
-String WeatherDataModel::getCurrentIcon() {
+const InternedString &WeatherDataModel::getCurrentIcon() const {
     return m_currentWeatherIcon;
 }
 
 WeatherDataModel &WeatherDataModel::setCurrentTemperature(float degrees) {
     if (m_currentWeatherDeg != degrees) {
         m_currentWeatherDeg = degrees;
-        m_changed = true;
+        m_changedFields |= CURRENT_TEMPERATURE;
     }
     return *this;
 }
@@ -52,14 +50,14 @@ float WeatherDataModel::getCurrentTemperature() {
     return m_currentWeatherDeg;
 }
 
-String WeatherDataModel::getCurrentTemperature(int8_t digits) {
+FrameString WeatherDataModel::getCurrentTemperature(int8_t digits) {
     return Utils::formatFloat(m_currentWeatherDeg, digits) + "°";
 }
 
 WeatherDataModel &WeatherDataModel::setTodayHigh(float high) {
     if (m_todayHigh != high) {
         m_todayHigh = high;
-        m_changed = true;
+        m_changedFields |= TODAY_HIGH;
     }
     return *this;
 }
@@ -68,14 +66,14 @@ float WeatherDataModel::getTodayHigh() {
     return m_todayHigh;
 }
 
-String WeatherDataModel::getTodayHigh(int8_t digits) {
+FrameString WeatherDataModel::getTodayHigh(int8_t digits) {
     return Utils::formatFloat(m_todayHigh, digits) + "°";
 }
 
 WeatherDataModel &WeatherDataModel::setTodayLow(float low) {
     if (m_todayLow != low) {
         m_todayLow = low;
-        m_changed = true;
+        m_changedFields |= TODAY_LOW;
     }
     return *this;
 }
@@ -84,7 +82,7 @@ float WeatherDataModel::getTodayLow() {
     return m_todayLow;
 }
 
-String WeatherDataModel::getTodayLow(int8_t digits) {
+FrameString WeatherDataModel::getTodayLow(int8_t digits) {
     return Utils::formatFloat(m_todayLow, digits) + "°";
 }
 
@@ -95,21 +93,22 @@ WeatherDataModel &WeatherDataModel::setDaysIcons(String *icons) {
     return *this;
 }
 
-String &WeatherDataModel::getDaysIcons() {
-    return *m_daysIcons;
+const InternedString *WeatherDataModel::getDaysIcons() const {
+    return m_daysIcons;
 }
 
-WeatherDataModel &WeatherDataModel::setDayIcon(int num, String icon) {
+WeatherDataModel &WeatherDataModel::setDayIcon(int num, const String &icon) {
     if (num < 3 && m_daysIcons[num] != icon) {
         m_daysIcons[num] = icon;
-        m_changed = true;
+        m_changedFields |= DAY_ICONS;
     }
     return *this;
 }
 
-String WeatherDataModel::getDayIcon(int num) {
+const InternedString &WeatherDataModel::getDayIcon(int num) const {
+    static const InternedString none;
     if (num >= 3) {
-        return "";
+        return none;
     }
     return m_daysIcons[num];
 }
@@ -124,7 +123,7 @@ WeatherDataModel &WeatherDataModel::setDaysLows(float *lows) {
 WeatherDataModel &WeatherDataModel::setDayLow(int num, float low) {
     if (num < 3 && m_daysLow[num] != low) {
         m_daysLow[num] = low;
-        m_changed = true;
+        m_changedFields |= DAY_LOWS;
     }
     return *this;
 }
@@ -140,7 +139,7 @@ float WeatherDataModel::getDayLow(int num) {
     return m_daysLow[num];
 }
 
-String WeatherDataModel::getDayLow(int8_t num, int8_t digits) {
+FrameString WeatherDataModel::getDayLow(int8_t num, int8_t digits) {
     if (m_daysLow[num] == NaN) {
         return "";
     }
@@ -165,7 +164,7 @@ float WeatherDataModel::getDayHigh(int num) {
     return m_daysHigh[num];
 }
 
-String WeatherDataModel::getDayHigh(int8_t num, int8_t digits) {
+FrameString WeatherDataModel::getDayHigh(int8_t num, int8_t digits) {
     if (m_daysHigh[num] == NaN) {
         return "";
     }
@@ -176,16 +175,55 @@ WeatherDataModel &WeatherDataModel::setDayHigh(int num, float high) {
     if (num < 3 && m_daysHigh[num] != high) {
         if (m_daysHigh[num] != high) {
             m_daysHigh[num] = high;
-            m_changed = true;
+            m_changedFields |= DAY_HIGHS;
         }
     }
     return *this;
 }
 
 bool WeatherDataModel::isChanged() {
-    return m_changed;
+    return m_changedFields != 0;
 }
 WeatherDataModel &WeatherDataModel::setChangedStatus(bool changed) {
-    m_changed = changed;
+    m_changedFields = changed ? ALL_FIELDS : 0;
+    return *this;
+}
+
+uint16_t WeatherDataModel::getChangedFields() const {
+    return m_changedFields;
+}
+
+WeatherDataModel &WeatherDataModel::clearChangedFields(uint16_t fields) {
+    m_changedFields &= ~fields;
     return *this;
 }
+
+void WeatherDataModel::saveSnapshot(SnapshotWriter &writer) {
+    writer.write(m_cityName);
+    writer.write(m_currentWeatherText);
+    writer.write(m_currentWeatherIcon);
+    writer.write(m_currentWeatherDeg);
+    writer.write(m_todayHigh);
+    writer.write(m_todayLow);
+    for (int i = 0; i < 3; i++) {
+        writer.write(m_daysIcons[i]);
+        writer.write(m_daysHigh[i]);
+        writer.write(m_daysLow[i]);
+    }
+}
+
+bool WeatherDataModel::restoreSnapshot(SnapshotReader &reader) {
+    reader.read(m_cityName);
+    reader.read(m_currentWeatherText);
+    reader.read(m_currentWeatherIcon);
+    reader.read(m_currentWeatherDeg);
+    reader.read(m_todayHigh);
+    reader.read(m_todayLow);
+    for (int i = 0; i < 3; i++) {
+        reader.read(m_daysIcons[i]);
+        reader.read(m_daysHigh[i]);
+        reader.read(m_daysLow[i]);
+    }
+    m_changedFields = ALL_FIELDS;
+    return reader.ok();
+}
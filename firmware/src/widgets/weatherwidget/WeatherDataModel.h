@@ -1,61 +1,84 @@
 #ifndef WEAHTERDATA_MODEL_H
 #define WEAHTERDATA_MODEL_H
 
+#include "DataSnapshot.h"
+#include "FrameString.h"
 #include <Arduino.h>
 #include <iomanip>
 
 #define NaN -1024.0
 class WeatherDataModel {
 public:
+    // Fields for getChangedFields(), widgets map them to the orbs that show them
+    enum Field : uint16_t {
+        CITY_NAME = 1 << 0,
+        CURRENT_TEXT = 1 << 1,
+        CURRENT_ICON = 1 << 2,
+        CURRENT_TEMPERATURE = 1 << 3,
+        TODAY_HIGH = 1 << 4,
+        TODAY_LOW = 1 << 5,
+        DAY_ICONS = 1 << 6,
+        DAY_HIGHS = 1 << 7,
+        DAY_LOWS = 1 << 8,
+        ALL_FIELDS = (1 << 9) - 1
+    };
+
     WeatherDataModel();
-    WeatherDataModel &setCityName(String city);
-    String getCityName();
-    WeatherDataModel &setCurrentText(String text);
-    String getCurrentText();
-    WeatherDataModel &setCurrentIcon(String icon);
-    String getCurrentIcon();
+    WeatherDataModel &setCityName(const String &city);
+    const FixedString<48> &getCityName() const;
+    WeatherDataModel &setCurrentText(const String &text);
+    const FixedString<128> &getCurrentText() const;
+    WeatherDataModel &setCurrentIcon(const String &icon);
+    const InternedString &getCurrentIcon() const;
     WeatherDataModel &setCurrentTemperature(float degrees);
     float getCurrentTemperature();
-    String getCurrentTemperature(int8_t digits);
+    FrameString getCurrentTemperature(int8_t digits);
     WeatherDataModel &setTodayHigh(float high);
     float getTodayHigh();
-    String getTodayHigh(int8_t digits);
+    FrameString getTodayHigh(int8_t digits);
     WeatherDataModel &setTodayLow(float low);
     float getTodayLow();
-    String getTodayLow(int8_t digits);
+    FrameString getTodayLow(int8_t digits);
 
     WeatherDataModel &setDaysIcons(String icons[3]);
-    String &getDaysIcons();
-    WeatherDataModel &setDayIcon(int num, String icon);
-    String getDayIcon(int num);
+    const InternedString *getDaysIcons() const;
+    WeatherDataModel &setDayIcon(int num, const String &icon);
+    const InternedString &getDayIcon(int num) const;
 
     WeatherDataModel &setDaysHighs(float highs[3]);
     float &getDaysHighs();
     WeatherDataModel &setDayHigh(int num, float high);
     float getDayHigh(int num);
-    String getDayHigh(int8_t num, int8_t digits);
+    FrameString getDayHigh(int8_t num, int8_t digits);
 
     WeatherDataModel &setDaysLows(float lows[3]);
     float &getDaysLows();
     WeatherDataModel &setDayLow(int num, float low);
     float getDayLow(int num);
-    String getDayLow(int8_t num, int8_t digits);
+    FrameString getDayLow(int8_t num, int8_t digits);
 
+    // Any field changed, setChangedStatus() marks all or no fields
     bool isChanged();
     WeatherDataModel &setChangedStatus(bool changed);
+    uint16_t getChangedFields() const;
+    // Call with the fields that have been drawn
+    WeatherDataModel &clearChangedFields(uint16_t fields);
+
+    void saveSnapshot(SnapshotWriter &writer);
+    bool restoreSnapshot(SnapshotReader &reader);
 
 private:
-    String m_cityName;
-    String m_currentWeatherText = ""; // Weather Description
-    String m_currentWeatherIcon = ""; // Text refrence for weather icon
+    FixedString<48> m_cityName;
+    FixedString<128> m_currentWeatherText; // Weather Description
+    InternedString m_currentWeatherIcon; // Text refrence for weather icon
     float m_currentWeatherDeg = 0.0;
     float m_todayHigh = 0.0;
     float m_todayLow = 0.0;
 
-    String m_daysIcons[3] = {"", "", ""};
+    InternedString m_daysIcons[3];
     float m_daysHigh[3] = {NaN, NaN, NaN};
     float m_daysLow[3] = {NaN, NaN, NaN};
 
-    bool m_changed = false;
+    uint16_t m_changedFields = 0;
 };
 #endif // WEAHTER_DATA_MODEL_H
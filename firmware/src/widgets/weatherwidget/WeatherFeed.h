@@ -3,12 +3,28 @@
 
 #include "ConfigManager.h" // Include ConfigManager
 #include "WeatherDataModel.h"
+#include <functional>
 
 class WeatherFeed {
 public:
     virtual bool getWeatherData(WeatherDataModel &model) = 0;
     virtual void setupConfig(ConfigManager &config) = 0;
+    // Configured location the data is for, part of the snapshot key
+    virtual String getLocation() const = 0;
     virtual ~WeatherFeed() = default;
+
+    // Called after the model was updated from a successful response
+    void setUpdatedCallback(std::function<void()> callback) { m_updatedCallback = callback; }
+
+protected:
+    void notifyUpdated() {
+        if (m_updatedCallback) {
+            m_updatedCallback();
+        }
+    }
+
+private:
+    std::function<void()> m_updatedCallback;
 };
 
 #endif
@@ -17,17 +17,32 @@
 #include <ArduinoJson.h>
 #include <ArduinoLog.h>
 
+void WeatherSettings::addConfig(ConfigManager &config) {
+    weatherFeed = createWeatherFeed(config);
+    weatherFeed->setupConfig(config); // allow feed to add its own config
+    config.addConfigComboBox("WeatherWidget", "weatherUnits", &m_weatherUnits, t_temperatureUnits, t_temperatureUnit, true);
+    config.addConfigComboBox("WeatherWidget", "weatherScrMode", &m_screenMode, t_screenModes, t_screenMode, true);
+    config.addConfigInt("WeatherWidget", "weatherCycleHL", &m_switchinterval, t_weatherCycleHL, true);
+}
+
 WeatherWidget::WeatherWidget(ScreenManager &manager, ConfigManager &config)
     : Widget(manager, config),
       m_drawTimer(addDrawRefreshFrequency(WEATHER_DRAW_DELAY)),
       m_updateTimer(addUpdateRefreshFrequency(WEATHER_UPDATE_DELAY)) {
     m_enabled = (INCLUDE_WEATHER == WIDGET_ON);
     m_config.addConfigBool("WeatherWidget", "weatherEnabled", &m_enabled, t_enableWidget);
-    weatherFeed = createWeatherFeed();
-    weatherFeed->setupConfig(config); // allow feed to add its own config
-    m_config.addConfigComboBox("WeatherWidget", "weatherUnits", &m_weatherUnits, t_temperatureUnits, t_temperatureUnit, true);
-    m_config.addConfigComboBox("WeatherWidget", "weatherScrMode", &m_screenMode, t_screenModes, t_screenMode, true);
-    m_config.addConfigInt("WeatherWidget", "weatherCycleHL", &m_switchinterval, t_weatherCycleHL, true);
+    addConfig(m_config);
+    weatherFeed->setUpdatedCallback([this]() { saveSnapshot(); });
+
+    // Settings that can be applied without a restart
+    // (weatherLocation is only added by feeds that support it)
+    m_config.addOnChangeCallback("WeatherWidget", "weatherLocation", [this](const char *section, const char *varName) {
+        update(true);
+    });
+    m_config.addOnChangeCallback("WeatherWidget", "weatherScrMode", [this](const char *section, const char *varName) {
+        configureColors();
+    });
+    m_config.addOnChangeCallback("WeatherWidget", "weatherCycleHL", [](const char *section, const char *varName) {}); // read on every draw
     Log.noticeln("WeatherWidget initialized, mode=%d", m_screenMode);
     m_mode = MODE_HIGHS;
 }
@@ -36,9 +51,9 @@ WeatherWidget::~WeatherWidget() {
     delete weatherFeed;
 }
 
-WeatherFeed *WeatherWidget::createWeatherFeed() {
+WeatherFeed *WeatherSettings::createWeatherFeed(ConfigManager &config) {
 
-    int weatherUnits = m_config.getConfigInt("weatherUnits", m_weatherUnits);
+    int weatherUnits = config.getConfigInt("weatherUnits", m_weatherUnits);
 
 #if WEATHER_OPENWEATHERMAP_FEED
     return new OpenWeatherMapFeed(WEATHER_OPENWEATHERMAP_API_KEY, weatherUnits);
@@ -65,33 +80,74 @@ void WeatherWidget::buttonPressed(uint8_t buttonId, ButtonState state) {
 void WeatherWidget::setup() {
     m_time = GlobalTime::getInstance();
     configureColors();
+    // Clock digits and current temperature
+    m_manager.addToGlyphAtlas(DEFAULT_FONT, 66);
+    m_manager.addToGlyphAtlas(DEFAULT_FONT, 88);
+    m_clockFace.setClock(centre, 120, 66, 10);
+    m_clockFace.setLine(0, 50, 18); // Date
+    m_clockFace.setLine(1, 190, 22); // Weekday
     m_prevMillisSwitch = millis();
 }
 
 void WeatherWidget::draw(bool force) {
-    m_manager.setFont(DEFAULT_FONT);
-    m_time->updateTime();
-    int clockStamp = getClockStamp();
-    if (clockStamp != m_clockStamp || force) {
-        displayClock(0);
-        m_clockStamp = clockStamp;
+    uint8_t step = 0;
+    while (!drawStep(force, step++)) {
     }
+}
 
-    if (force || model.isChanged()) {
-        weatherText(1);
-        drawWeatherIcon(2, model.getCurrentIcon(), 0, 0, 1);
-        singleWeatherDeg(3);
-        threeDayWeather(4);
-        model.setChangedStatus(false);
+bool WeatherWidget::drawStep(bool force, uint8_t step) {
+    m_manager.setFont(DEFAULT_FONT);
+    switch (step) {
+    case 0: {
+        // A new screen mode needs a full repaint, the clock and temperatures only repaint what changed
+        m_forceDraw = force || m_colorsChanged;
+        m_colorsChanged = false;
+        force = m_forceDraw;
+        m_time->updateTime();
+        int clockStamp = getClockStamp();
+        if (clockStamp != m_clockStamp || force) {
+            displayClock(0, force);
+            m_clockStamp = clockStamp;
+        }
+        // Latch the changes now, data arriving during the next steps is drawn in the next frame
+        m_drawFields = force ? WeatherDataModel::ALL_FIELDS : model.getChangedFields();
+        model.clearChangedFields(m_drawFields);
+        if (m_drawFields != 0) {
+            return false;
+        }
+        break;
+    }
+    // Each orb is only drawn if one of its fields changed
+    case 1:
+        if (m_drawFields & ORB_FIELDS[1]) {
+            weatherText(1);
+        }
+        return false;
+    case 2:
+        if (m_drawFields & ORB_FIELDS[2]) {
+            drawWeatherIcon(2, model.getCurrentIcon(), 0, 0, 1);
+        }
+        return false;
+    case 3:
+        if (m_drawFields & ORB_FIELDS[3]) {
+            singleWeatherDeg(3, m_forceDraw);
+        }
+        return false;
+    case 4:
+        if (m_drawFields & ORB_FIELDS[4]) {
+            threeDayWeather(4);
+        }
         if (force) {
             resetTimer(m_drawTimer); // Reset only on forced draw
         }
+        break;
     }
 
     if ((millis() - m_prevMillisSwitch >= (m_switchinterval * 1000)) && m_switchinterval > 0) {
         changeMode();
         m_prevMillisSwitch = millis(); // Reset timer
     }
+    return true;
 }
 
 void WeatherWidget::update(bool force) {
@@ -105,22 +161,42 @@ void WeatherWidget::update(bool force) {
     }
 }
 
-void WeatherWidget::displayClock(int displayIndex) {
-    const int clockY = 120;
-    const int dayOfWeekY = 190;
-    const int dateY = 50;
+bool WeatherWidget::restoreSnapshot() {
+    SnapshotReader reader("weather", SNAPSHOT_VERSION, getSnapshotKey());
+    WeatherDataModel restored;
+    if (!reader.ok() || !restored.restoreSnapshot(reader)) {
+        return false;
+    }
+    model = restored;
+    snapshotRestored(reader);
+    Log.noticeln("Restored weather data for %s (%d s old)", model.getCityName().c_str(), reader.getAge());
+    return true;
+}
 
-    m_manager.selectScreen(displayIndex);
-    m_manager.fillScreen(m_backgroundColor);
-    m_manager.setFontColor(m_foregroundColor);
+void WeatherWidget::saveSnapshot() {
+    dataRefreshed();
+    if (!model.isChanged()) {
+        return;
+    }
+    SnapshotWriter writer("weather", SNAPSHOT_VERSION, getSnapshotKey());
+    model.saveSnapshot(writer);
+    writer.commit();
+}
 
-    m_manager.drawCentreString(m_time->getDayAndMonth(), centre, dateY, 18);
-    const String weekDay = m_time->getWeekday();
-    m_manager.drawCentreString(weekDay, centre, dayOfWeekY, 22);
+String WeatherWidget::getSnapshotKey() {
+    // Data of another location, units or language is not restored
+    return String(m_weatherUnits) + I18n::getLanguageString() + "|" + weatherFeed->getLocation();
+}
 
-    m_manager.drawString(m_time->getHourPadded(), centre - 10, clockY, 66, Align::MiddleRight);
-    m_manager.drawString(":", centre, clockY, 66, Align::MiddleCenter);
-    m_manager.drawString(m_time->getMinutePadded(), centre + 10, clockY, 66, Align::MiddleLeft);
+void WeatherWidget::displayClock(int displayIndex, bool force) {
+    m_manager.selectScreen(displayIndex);
+    if (force) {
+        m_manager.fillScreen(m_backgroundColor);
+        m_clockFace.invalidate();
+    }
+    m_clockFace.drawLine(m_manager, 0, m_time->getDayAndMonth(), m_foregroundColor, m_backgroundColor);
+    m_clockFace.drawLine(m_manager, 1, m_time->getWeekday().c_str(), m_foregroundColor, m_backgroundColor);
+    m_clockFace.draw(m_manager, m_time->getHourPadded(), m_time->getMinutePadded(), m_foregroundColor, m_backgroundColor);
 }
 
 // Write an image to the screen from a hex array.
@@ -128,15 +204,11 @@ void WeatherWidget::displayClock(int displayIndex) {
 // getting the byte array size is very annoying as it's computed on compile, so you can't do it dynamically.
 void WeatherWidget::showJPG(int displayIndex, int x, int y, const byte jpgData[], int jpgDataSize, int scale) {
     m_manager.selectScreen(displayIndex);
-
-    TJpgDec.setJpgScale(scale);
-    uint16_t w = 0, h = 0;
-    TJpgDec.getJpgSize(&w, &h, jpgData, jpgDataSize);
-    TJpgDec.drawJpg(x, y, jpgData, jpgDataSize);
+    m_manager.drawJpg(x, y, jpgData, jpgDataSize, scale);
 }
 
 // Take the text output from the weather API and map it to a icon/byte array, then display it
-void WeatherWidget::drawWeatherIcon(int displayIndex, const String &condition, int x, int y, int scale) {
+void WeatherWidget::drawWeatherIcon(int displayIndex, const InternedString &condition, int x, int y, int scale) {
     const byte *iconStart = NULL;
     const byte *iconEnd = NULL;
 
@@ -173,73 +245,62 @@ void WeatherWidget::drawWeatherIcon(int displayIndex, const String &condition, i
 
 // Displays the current temperature on a single screen.
 // doesn't round deg, just removes all text after the decimal
-void WeatherWidget::singleWeatherDeg(int displayIndex) {
+void WeatherWidget::singleWeatherDeg(int displayIndex, bool force) {
+    int fontSize = 22;
     m_manager.selectScreen(displayIndex);
-    m_manager.fillScreen(m_backgroundColor);
-    m_manager.drawCentreString(model.getCurrentTemperature(0), centre, 90, 88);
+    if (force) {
+        m_manager.fillScreen(m_backgroundColor);
 
-    // No glaring white chunks in Dark mode
-    if (m_screenMode == Light) {
-        m_manager.fillRect(0, 150, 240, 90, m_foregroundColor);
-        m_manager.fillRect(centre - 1, 150, 2, 90, m_backgroundColor);
+        // No glaring white chunks in Dark mode
+        if (m_screenMode == Light) {
+            m_manager.fillRect(0, 150, 240, 90, m_foregroundColor);
+            m_manager.fillRect(centre - 1, 150, 2, 90, m_backgroundColor);
+        }
+
+        m_manager.setFontColor(m_invertedForegroundColor);
+        m_manager.setBackgroundColor(m_invertedBackgroundColor);
+        m_manager.drawCentreString("High", 80, 170, fontSize);
+        m_manager.drawCentreString("Low", 160, 170, fontSize);
+        m_manager.setFontColor(m_foregroundColor);
+        m_manager.setBackgroundColor(m_backgroundColor);
     }
 
-    int fontSize = 22;
-    m_manager.setFontColor(m_invertedForegroundColor);
-    m_manager.setBackgroundColor(m_invertedBackgroundColor);
-    m_manager.drawCentreString("High", 80, 170, fontSize);
-    m_manager.drawCentreString("Low", 160, 170, fontSize);
-    m_manager.drawCentreString(model.getTodayHigh(0), 80, 210, fontSize);
-    m_manager.drawCentreString(model.getTodayLow(0), 160, 210, fontSize);
-    m_manager.setFontColor(m_foregroundColor);
-    m_manager.setBackgroundColor(m_backgroundColor);
+    // Temperatures repaint only the digits that changed
+    m_manager.drawNumber(0, model.getCurrentTemperature(0), centre, 90, 88, Align::MiddleCenter, m_foregroundColor, m_backgroundColor);
+    m_manager.drawNumber(1, model.getTodayHigh(0), 80, 210, fontSize, Align::MiddleCenter, m_invertedForegroundColor, m_invertedBackgroundColor);
+    m_manager.drawNumber(2, model.getTodayLow(0), 160, 210, fontSize, Align::MiddleCenter, m_invertedForegroundColor, m_invertedBackgroundColor);
 }
 
 // Display the user's current city and the text description of the weather
 void WeatherWidget::weatherText(int displayIndex) {
-    m_manager.selectScreen(displayIndex);
-
-    //=== TEXT OVERFLOW ============================
-    // This takes a given string a and breaks it down in max x character long strings ensuring not to break it only at a space.
-    // Given the small width of the screens this will porbablly be needed to this project again so making sure to outline it
-    // clearly as this should liekly eventually be turned into a fucntion. Before use the array size should be made to be dynamic.
-    // In this case its used for the weather text description
-
-    String message = model.getCurrentText() + " ";
-    String messageArr[4];
-    int variableRangeS = 0;
-    int variableRangeE = 24;
-    for (int i = 0; i < 4; i++) {
-        while (message.substring(variableRangeE - 1, variableRangeE) != " ") {
-            variableRangeE--;
-        }
-        messageArr[i] = message.substring(variableRangeS, variableRangeE);
-        variableRangeS = variableRangeE;
-        variableRangeE = variableRangeS + 24;
-    }
-    //=== OVERFLOW END ==============================
+    const int textY = 118;
+    const int lineHeight = 25;
+    const int fontSize = 15;
 
+    m_manager.selectScreen(displayIndex);
     m_manager.fillScreen(m_backgroundColor);
-    String cityName = model.getCityName();
+    String cityName = model.getCityName().toString();
     cityName.remove(cityName.indexOf(",", 0));
 
     m_manager.setFontColor(m_foregroundColor);
     m_manager.drawFittedString(cityName, centre, 70, 195, 50, Align::MiddleCenter);
 
-    auto y = 118;
-    for (auto i = 0; i < 4; i++) {
-        m_manager.drawCentreString(messageArr[i], centre, y, 15);
-        y += 25;
-    }
+    // Weather description, as much as fits into 4 lines
+    const char *message = model.getCurrentText().c_str();
+    TextLine lines[4];
+    int lineCount = m_manager.wrapText(message, fontSize, textY, lineHeight, lines, 4);
+    m_manager.drawWrappedText(message, lines, lineCount, centre, textY, lineHeight, fontSize);
 }
 
 // Displays the next 3 days' weather forecast
+// Recorded as a display list, so a new temperature or icon repaints only its own area
 void WeatherWidget::threeDayWeather(int displayIndex) {
     const int days = 3;
     const int columnSize = 75;
     const int highLowY = 210;
 
     m_manager.selectScreen(displayIndex);
+    m_manager.beginRecording();
     m_manager.fillScreen(m_backgroundColor);
     int fontSize = 22;
 
@@ -256,7 +317,7 @@ void WeatherWidget::threeDayWeather(int displayIndex) {
     int temperatureFontSize = fontSize; // 0-9 only
     // Look up all the temperatures, and if any of them are more than 2 digits, we need
     // to scale down the font -- or it won't look right on the screen.
-    String temps[days];
+    FrameString temps[days];
     for (auto i = 0; i < days; i++) {
         temps[i] = m_mode == MODE_HIGHS ? model.getDayHigh(i, 0) : model.getDayLow(i, 0);
         if (temps[i].length() > 4) {
@@ -273,10 +334,11 @@ void WeatherWidget::threeDayWeather(int displayIndex) {
         drawWeatherIcon(displayIndex, model.getDayIcon(i), x - 30, 40, 4);
         m_manager.drawCentreString(temps[i], x, 122, temperatureFontSize);
 
-        String shortDayName = i18n(t_weekdays, weekday(m_time->getUnixEpoch() + (86400 * (i + 1))) - 1);
-        shortDayName.remove(3);
+        const char *dayName = i18n(t_weekdays, weekday(m_time->getUnixEpoch() + (86400 * (i + 1))) - 1);
+        FrameString shortDayName(dayName, strnlen(dayName, 3));
         m_manager.drawString(shortDayName, x, 154, fontSize, Align::MiddleCenter);
     }
+    m_manager.commitRecording();
 }
 
 int WeatherWidget::getClockStamp() {
@@ -294,6 +356,7 @@ void WeatherWidget::configureColors() {
     m_invertedBackgroundColor = m_screenMode == Light ? m_foregroundColor : m_backgroundColor;
 
     m_manager.setBackgroundColor(m_backgroundColor);
+    m_colorsChanged = true;
 }
 
 String WeatherWidget::getName() {
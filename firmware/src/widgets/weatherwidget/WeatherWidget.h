@@ -1,6 +1,7 @@
 #ifndef WEATHERWIDGET_H
 #define WEATHERWIDGET_H
 
+#include "ClockFace.h"
 #include "GlobalTime.h"
 #include "WeatherDataModel.h"
 #include "Widget.h"
@@ -12,43 +13,61 @@
 #else
     #include "feeds/VisualCrossingFeed.h"
 #endif
-class WeatherWidget : public Widget {
+
+#ifndef HIGH_LOW_INTERVAL
+    #define HIGH_LOW_INTERVAL 0
+#endif
+
+// Settings of the portal, registered by WidgetRegistry without the widget while it is disabled
+struct WeatherSettings {
+#ifdef WEATHER_UNITS_METRIC
+    int m_weatherUnits = 0;
+#else
+    int m_weatherUnits = 1;
+#endif
+
+#ifdef WEATHER_SCREEN_MODE
+    int m_screenMode = WEATHER_SCREEN_MODE;
+#else
+    int m_screenMode = Dark;
+#endif
+    int m_switchinterval = HIGH_LOW_INTERVAL;
+    // Created by addConfig(), the feed adds its own settings (e.g. the location)
+    WeatherFeed *weatherFeed = nullptr;
+
+    void addConfig(ConfigManager &config);
+    WeatherFeed *createWeatherFeed(ConfigManager &config);
+};
+
+class WeatherWidget : public Widget, protected WeatherSettings {
 public:
     WeatherWidget(ScreenManager &manager, ConfigManager &config);
     ~WeatherWidget() override;
     void setup() override;
     void update(bool force = false) override;
     void draw(bool force = false) override;
+    bool drawStep(bool force, uint8_t step) override;
     void buttonPressed(uint8_t buttonId, ButtonState state) override;
     String getName() override;
+    bool restoreSnapshot() override;
 
 private:
-    void displayClock(int displayIndex);
+    void saveSnapshot();
+    String getSnapshotKey();
+    void displayClock(int displayIndex, bool force);
     void changeMode();
     void displayClock(int displayIndex, uint32_t background, uint32_t textColor);
     void showJPG(int displayIndex, int x, int y, const byte jpgData[], int size, int scale);
-    void drawWeatherIcon(int displayIndex, const String &condition, int x, int y, int scale);
-    void singleWeatherDeg(int displayIndex);
+    void drawWeatherIcon(int displayIndex, const InternedString &condition, int x, int y, int scale);
+    void singleWeatherDeg(int displayIndex, bool force);
     void weatherText(int displayIndex);
     void threeDayWeather(int displayIndex);
     int getClockStamp();
     void configureColors();
-    WeatherFeed *createWeatherFeed();
 
     GlobalTime *m_time;
     int8_t m_mode;
 
-#ifdef WEATHER_UNITS_METRIC
-    int m_weatherUnits = 0;
-#else
-    int m_weatherUnits = 1;
-#endif
-
-#ifdef WEATHER_SCREEN_MODE
-    int m_screenMode = WEATHER_SCREEN_MODE;
-#else
-    int m_screenMode = Dark;
-#endif
     uint16_t m_foregroundColor;
     uint16_t m_backgroundColor;
     uint16_t m_invertedForegroundColor;
@@ -65,18 +84,24 @@ private:
     const int centre = 120; // Centre location of the screen(240x240)
 
     int m_clockStamp = 0;
+    ClockFace m_clockFace;
+    uint16_t m_drawFields = 0; // model fields redrawn in the current draw
+    // Model fields shown on each orb, orb 0 shows the clock
+    static constexpr uint16_t ORB_FIELDS[NUM_SCREENS] = {
+        0,
+        WeatherDataModel::CITY_NAME | WeatherDataModel::CURRENT_TEXT,
+        WeatherDataModel::CURRENT_ICON,
+        WeatherDataModel::CURRENT_TEMPERATURE | WeatherDataModel::TODAY_HIGH | WeatherDataModel::TODAY_LOW,
+        WeatherDataModel::DAY_ICONS | WeatherDataModel::DAY_HIGHS | WeatherDataModel::DAY_LOWS};
+    bool m_forceDraw = false; // the current draw repaints everything
+    bool m_colorsChanged = false;
 
     WeatherDataModel model;
-    WeatherFeed *weatherFeed;
+    static constexpr uint8_t SNAPSHOT_VERSION = 1;
 
     const int MODE_HIGHS = 0;
     const int MODE_LOWS = 1;
 
-#ifndef HIGH_LOW_INTERVAL
-    #define HIGH_LOW_INTERVAL 0
-#endif
-
-    int m_switchinterval = HIGH_LOW_INTERVAL;
     unsigned long m_prevMillisSwitch = 0;
 
     WidgetTimer &m_drawTimer;
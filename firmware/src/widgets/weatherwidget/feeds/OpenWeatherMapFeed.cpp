@@ -92,6 +92,7 @@ void OpenWeatherMapFeed::processResponse(int httpCode, const String &response, W
                 model.setDayHigh(i - 1, doc["daily"][i]["temp"]["max"].as<float>());
                 model.setDayLow(i - 1, doc["daily"][i]["temp"]["min"].as<float>());
             }
+            notifyUpdated();
 
         } else {
             // Handle JSON deserialization error
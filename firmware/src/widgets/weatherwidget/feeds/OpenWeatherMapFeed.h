@@ -23,6 +23,7 @@ public:
     OpenWeatherMapFeed(const String &apiKey, int units);
     bool getWeatherData(WeatherDataModel &model) override;
     void setupConfig(ConfigManager &config) override;
+    String getLocation() const override { return String(m_lat_id.c_str()) + "," + m_long_id.c_str(); }
     void processResponse(int httpCode, const String &response, WeatherDataModel &model);
     void preProcessResponse(int httpCode, String &response);
     String translateIcon(const std::string &icon);
@@ -80,6 +80,7 @@ void TempestFeed::processResponse(int httpCode, const String &response, WeatherD
                 model.setDayHigh(i, doc["forecast"]["daily"][i]["air_temp_high"].as<float>());
                 model.setDayLow(i, doc["forecast"]["daily"][i]["air_temp_low"].as<float>());
             }
+            notifyUpdated();
         } else {
             // Handle JSON deserialization error
             Log.errorln("Deserialization failed: %s", error.c_str());
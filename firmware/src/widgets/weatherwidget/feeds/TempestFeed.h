@@ -22,6 +22,7 @@ public:
     TempestFeed(const String &apiKey, int units);
     bool getWeatherData(WeatherDataModel &model) override;
     void setupConfig(ConfigManager &config) override;
+    String getLocation() const override { return m_stationId.c_str(); }
     void processResponse(int httpCode, const String &response, WeatherDataModel &model);
     void preProcessResponse(int httpCode, String &response);
     String translateIcon(const std::string &icon);
@@ -83,6 +83,7 @@ void VisualCrossingFeed::processResponse(int httpCode, const String &response, W
                 model.setDayHigh(i, doc["days"][i + 1]["tempmax"].as<float>());
                 model.setDayLow(i, doc["days"][i + 1]["tempmin"].as<float>());
             }
+            notifyUpdated();
         } else {
             // Handle JSON deserialization error
             Log.errorln("Deserialization failed: %s", error.c_str());
@@ -15,6 +15,7 @@ public:
     VisualCrossingFeed(const String &apiKey, int units);
     bool getWeatherData(WeatherDataModel &model) override;
     void setupConfig(ConfigManager &config) override;
+    String getLocation() const override { return m_weatherLocation.c_str(); }
     void processResponse(int httpCode, const String &response, WeatherDataModel &model);
     void preProcessResponse(int httpCode, String &response);
 
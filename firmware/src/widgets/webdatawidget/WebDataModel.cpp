@@ -11,7 +11,7 @@ void WebDataModel::setLabel(String label) {
     }
 }
 
-String WebDataModel::getData() {
+const String &WebDataModel::getData() {
     return m_data;
 }
 
@@ -174,13 +174,11 @@ void WebDataModel::draw(ScreenManager &manager) {
     } else {
         manager.setLegacyTextColor(getDataColor(), getBackgroundColor());
 
-        String wrappedLines[MAX_WRAPPED_LINES];
-        String dataValues = getData();
+        const char *dataValues = getData().c_str();
         int yOffset = 110;
-        int lineCount = Utils::getWrappedLines(wrappedLines, dataValues, 10);
         int height = manager.getLegacyFontHeight() + 10;
-        for (int i = 0; i < lineCount; i++) {
-            manager.drawLegacyString(wrappedLines[i], 120, yOffset + (height * i), 2);
-        }
+        TextLine lines[WEBDATA_MAX_LINES];
+        int lineCount = manager.wrapLegacyText(dataValues, 2, yOffset, height, lines, WEBDATA_MAX_LINES);
+        manager.drawWrappedLegacyText(dataValues, lines, lineCount, 120, yOffset, height, 2);
     }
 }
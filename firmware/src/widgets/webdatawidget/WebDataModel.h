@@ -6,12 +6,16 @@
 
 #include "WebDataElementModel.h"
 
+#ifndef WEBDATA_MAX_LINES
+    #define WEBDATA_MAX_LINES 6 // Lines of wrapped data text on the orb
+#endif
+
 class WebDataModel {
 public:
     virtual ~WebDataModel() = default;
     String getLabel();
     void setLabel(String label);
-    String getData();
+    const String &getData();
     void setData(String data, int32_t defaultColor, int32_t defaultBackground);
     void setData(JsonArray data, int32_t defaultColor, int32_t defaultBackground);
     const WebDataElementModel &getElement(int index);
@@ -1,8 +1,11 @@
 
 #include "WebDataWidget.h"
+#include "DataSnapshot.h"
+#include <ArduinoLog.h>
 
 WebDataWidget::WebDataWidget(ScreenManager &manager, ConfigManager &config, String url) : Widget(manager, config) {
     httpRequestAddress = url;
+    m_snapshotName = "webdata" + String(Utils::hash(url), HEX);
 
     m_lastUpdate = 0;
     for (int i = 0; i < 5; i++) {
@@ -41,23 +44,26 @@ void WebDataWidget::update(bool force) {
         int httpCode = http.GET();
 
         if (httpCode > 0) { // Check for the returning code
+            String response = http.getString();
             JsonDocument doc;
-            DeserializationError error = deserializeJson(doc, http.getString());
+            DeserializationError error = deserializeJson(doc, response);
             if (!error) {
-                if (doc["interval"].is<int>()) {
-                    m_updateDelay = doc["interval"];
-                }
-                JsonVariant array;
-                if (doc["displays"].is<JsonArray>()) {
-                    array = doc["displays"].as<JsonArray>();
-                } else {
-                    // Handle legacy response that doesn't have response level data
-                    array = doc.as<JsonArray>();
-                }
-                for (int i = 0; i < array.size(); i++) {
-                    m_obj[i].parseData(array[i].as<JsonObject>(), m_defaultColor, m_defaultBackground);
-                }
+                processDocument(doc);
                 m_lastUpdate = millis();
+                dataRefreshed();
+
+                // The models are built from the JSON, so the snapshot is the JSON itself.
+                // Data is polled every few seconds, only write it to flash when it changed
+                // and not more often than every WEB_DATA_SNAPSHOT_INTERVAL to spare the flash.
+                uint32_t hash = Utils::hash(response);
+                if (hash != m_snapshotHash && (m_lastSnapshot == 0 || millis() - m_lastSnapshot >= WEB_DATA_SNAPSHOT_INTERVAL)) {
+                    SnapshotWriter writer(m_snapshotName.c_str(), SNAPSHOT_VERSION, httpRequestAddress);
+                    writer.writeJson(doc);
+                    if (writer.commit()) {
+                        m_snapshotHash = hash;
+                        m_lastSnapshot = millis();
+                    }
+                }
             } else {
                 // Handle JSON deserialization error
                 Serial.println("deserializeJson() failed");
@@ -70,6 +76,34 @@ void WebDataWidget::update(bool force) {
     }
 }
 
+void WebDataWidget::processDocument(JsonDocument &doc) {
+    if (doc["interval"].is<int>()) {
+        m_updateDelay = doc["interval"];
+    }
+    JsonVariant array;
+    if (doc["displays"].is<JsonArray>()) {
+        array = doc["displays"].as<JsonArray>();
+    } else {
+        // Handle legacy response that doesn't have response level data
+        array = doc.as<JsonArray>();
+    }
+    for (int i = 0; i < array.size() && i < 5; i++) {
+        m_obj[i].parseData(array[i].as<JsonObject>(), m_defaultColor, m_defaultBackground);
+    }
+}
+
+bool WebDataWidget::restoreSnapshot() {
+    SnapshotReader reader(m_snapshotName.c_str(), SNAPSHOT_VERSION, httpRequestAddress);
+    JsonDocument doc;
+    if (!reader.ok() || !reader.readJson(doc)) {
+        return false;
+    }
+    processDocument(doc);
+    snapshotRestored(reader);
+    Log.noticeln("Restored web data (%d s old)", reader.getAge());
+    return true;
+}
+
 String WebDataWidget::getName() {
     return "WebData";
 }
\ No newline at end of file
@@ -8,6 +8,10 @@
 #include "Utils.h"
 #include "WebDataModel.h"
 
+#ifndef WEB_DATA_SNAPSHOT_INTERVAL
+    #define WEB_DATA_SNAPSHOT_INTERVAL 300000 // Min ms between snapshot writes, the endpoint is polled every few seconds
+#endif
+
 class WebDataWidget : public Widget {
 public:
     WebDataWidget(ScreenManager &manager, ConfigManager &config, String url);
@@ -17,8 +21,15 @@ public:
     void draw(bool force = false) override;
     void buttonPressed(uint8_t buttonId, ButtonState state) override;
     String getName() override;
+    bool restoreSnapshot() override;
 
 private:
+    void processDocument(JsonDocument &doc);
+
+    static constexpr uint8_t SNAPSHOT_VERSION = 1;
+    uint32_t m_snapshotHash = 0; // hash of the response in the last snapshot
+    unsigned long m_lastSnapshot = 0;
+    String m_snapshotName; // one file per URL, both web data widgets can be enabled
     unsigned long m_lastUpdate = 0;
     unsigned long m_updateDelay = 1000;
     String httpRequestAddress;
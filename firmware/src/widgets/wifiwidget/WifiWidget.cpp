@@ -1,9 +1,12 @@
 #include "WifiWidget.h"
+#include "BootProfiler.h"
 #include "OrbsWiFiManager.h"
 #include "Utils.h"
 #include <ArduinoLog.h>
 #include <ESPmDNS.h>
+#include <Preferences.h>
 #include <WiFi.h>
+#include <esp_wifi.h>
 
 const int lineHeight = 40;
 const int statusScreenIndex = 0;
@@ -14,6 +17,51 @@ WifiWidget::WifiWidget(ScreenManager &manager, ConfigManager &config, WiFiManage
 
 WifiWidget::~WifiWidget() {}
 
+WifiState WifiWidget::s_state = WifiState::Portal;
+unsigned long WifiWidget::s_stateStart = 0;
+String WifiWidget::s_ssid;
+String WifiWidget::s_password;
+
+bool WifiWidget::beginConnect() {
+    BootProfiler::begin("wifi");
+    // The hostname must be set before the interface is started
+    WiFi.setHostname(getHostname().c_str());
+    WiFi.mode(WIFI_STA);
+#if (defined WIFI_SSID && defined WIFI_PASS)
+    s_ssid = WIFI_SSID;
+    s_password = WIFI_PASS;
+#else
+    wifi_config_t config;
+    if (esp_wifi_get_config(WIFI_IF_STA, &config) != ESP_OK || config.sta.ssid[0] == 0) {
+        // Nothing saved yet, setup() starts the config portal
+        return false;
+    }
+    s_ssid = String((const char *) config.sta.ssid);
+    s_password = String((const char *) config.sta.password);
+#endif
+
+    ConnectionCache cache{};
+    if (loadCache(cache)) {
+        // Directed connect: no scan, and optionally no DHCP
+        Log.noticeln("WiFi: fast connect to %s on channel %d", s_ssid.c_str(), cache.channel);
+        applyIpConfig(WIFI_REUSE_DHCP_LEASE ? &cache : nullptr);
+        WiFi.begin(s_ssid.c_str(), s_password.c_str(), cache.channel, cache.bssid);
+        setState(WifiState::FastConnect);
+    } else {
+        applyIpConfig(nullptr);
+        WiFi.begin(s_ssid.c_str(), s_password.c_str());
+        setState(WifiState::Connect);
+    }
+    return true;
+}
+
+String WifiWidget::getHostname() {
+    // OrbProjector<last 6 digits of MAC address> so it can be found on the network
+    String mac = WiFi.macAddress();
+    mac.replace(":", "");
+    return "OrbProjector" + mac.substring(mac.length() - 6);
+}
+
 void WifiWidget::setup() {
     m_manager.setFont(DEFAULT_FONT);
     m_manager.selectScreen(statusScreenIndex);
@@ -24,13 +72,16 @@ void WifiWidget::setup() {
     // Hold right button when connecting to power to reset wifi settings
     // these are stored by the ESP WiFi library
     if (digitalRead(BUTTON_RIGHT_PIN) == Button::PRESSED_LEVEL) {
+        setState(WifiState::Portal);
+        Preferences cache;
+        cache.begin("wifi", false);
+        cache.clear();
+        cache.end();
         m_wifiManager.resetSettings();
         m_manager.drawCentreString("Wifi Settings reset", ScreenCenterX, ScreenCenterY + lineHeight, fontSize);
         delay(messageDelay);
     }
 
-    WiFi.mode(WIFI_STA); // For WiFiManager explicitly set mode to station, ESP defaults to STA+AP
-
 #if (defined WIFI_SSID && defined WIFI_PASS)
     // Preload credentials from config.h
     m_wifiManager.preloadWiFi(WIFI_SSID, WIFI_PASS);
@@ -61,34 +112,29 @@ void WifiWidget::setup() {
     m_wifiManager.setCleanConnect(true);
     m_wifiManager.setConnectRetries(5);
 
-    // Set hostname to OrbProjector<last 6 digits of MAC address> so it can be found on the network
-    String mac = WiFi.macAddress();
-    mac.replace(":", "");
-    String hostname = "OrbProjector" + mac.substring(mac.length() - 6);
+    String hostname = getHostname();
     m_wifiManager.setHostname(hostname);
 
     Log.noticeln("Hostname: %s", hostname.c_str());
 
-    // WiFiManager automatically connects using saved credentials...
-    if (m_wifiManager.autoConnect(m_apssid.c_str())) {
-        Log.infoln("WifiManager connected.");
-    } else { // ...if connection fails (no saved credentials), it starts an access point with a WiFi setup portal at 192.168.4.1
-        m_configPortalRunning = true;
-        Log.infoln("Configuration portal running.");
-        m_manager.selectScreen(statusScreenIndex);
-        m_manager.clearScreen();
-        // m_manager.drawCentreString("Configure", ScreenCenterX, ScreenCenterY - lineHeight, fontSize);
-        // m_manager.selectScreen(statusScreenIndex + 1);
-        m_manager.drawCentreString("Connect", ScreenCenterX, ScreenCenterY - lineHeight * 2, fontSize);
-        m_manager.drawCentreString("phone or PC", ScreenCenterX, ScreenCenterY - lineHeight, fontSize);
-        m_manager.drawCentreString("to WiFi network:", ScreenCenterX, ScreenCenterY, fontSize);
-        m_manager.setFontColor(TFT_SKYBLUE);
-        m_manager.drawCentreString(m_apssid, ScreenCenterX, ScreenCenterY + lineHeight, fontSize);
-        m_manager.setFontColor(TFT_GREENYELLOW);
-        m_manager.drawCentreString("192.168.4.1", ScreenCenterX, ScreenCenterY + lineHeight * 2, fontSize);
+    if (s_state == WifiState::Portal) {
+        // No saved network, update() drives the connection otherwise
+        startPortal();
     }
 }
 
+void WifiWidget::startPortal() {
+    // Runs non-blocking, WiFiManager connects when the user has entered the credentials
+    Log.infoln("Configuration portal running.");
+    setState(WifiState::Portal);
+    m_wifiManager.startConfigPortal(m_apssid.c_str());
+}
+
+void WifiWidget::setState(WifiState state) {
+    s_state = state;
+    s_stateStart = millis();
+}
+
 void WifiWidget::update(bool force) {
     // Force is currently unhandled due to not knowing what behavior it would change
 
@@ -96,34 +142,108 @@ void WifiWidget::update(bool force) {
     m_wifiManager.process();
 
     if (WiFi.status() == WL_CONNECTED) {
-        m_isConnected = true;
-        m_connectionString = "Connected";
-        m_ipaddress = WiFi.localIP().toString();
-        Log.infoln("IP address: %s", m_ipaddress.c_str());
-        // Start the WebPortal
-        m_wifiManager.startWebPortal();
-#ifdef INCLUDE_MDNS
-        // Initialize mDNS
-        String mDNSname = m_wifiManager.getWiFiHostname();
-        if (!MDNS.begin(mDNSname)) {
-            Log.warningln("Error setting up MDNS responder!");
-        } else {
-            Log.infoln("mDNS responder started. You should find this device at http://%s\n", mDNSname.c_str());
+        if (!m_isConnected) {
+            onConnected();
         }
-        MDNS.addService("http", "tcp", 80);
+        return;
+    }
+
+    // Connection state machine, called from the main loop so the orbs keep updating while associating
+    unsigned long elapsed = millis() - s_stateStart;
+    if (s_state == WifiState::FastConnect && elapsed > WIFI_FAST_CONNECT_TIMEOUT) {
+        // The cached AP or lease didn't work (AP moved, changed channel...), connect with a scan
+        Log.noticeln("WiFi: fast connect failed, scanning");
+        WiFi.disconnect();
+        applyIpConfig(nullptr);
+        WiFi.begin(s_ssid.c_str(), s_password.c_str());
+        setState(WifiState::Connect);
+    } else if (s_state == WifiState::Connect && elapsed > WIFI_CONNECT_TIMEOUT) {
+        connectionTimedOut();
+        Log.warningln("WiFi: connecting failed (%s)", m_connectionString.c_str());
+        startPortal();
+    }
+
+    m_dotsString += " . ";
+    if (m_dotsString.length() > 9) {
+        m_dotsString = "";
+    }
+}
+
+void WifiWidget::onConnected() {
+    BootProfiler::end("wifi");
+    Log.noticeln("WiFi: connected after %d ms", millis() - s_stateStart);
+    setState(WifiState::Connected);
+    saveCache();
+    m_isConnected = true;
+    m_connectionString = "Connected";
+    m_ipaddress = WiFi.localIP().toString();
+    Log.infoln("IP address: %s", m_ipaddress.c_str());
+    // Start the WebPortal
+    m_wifiManager.startWebPortal();
+#ifdef INCLUDE_MDNS
+    // Initialize mDNS
+    String mDNSname = m_wifiManager.getWiFiHostname();
+    if (!MDNS.begin(mDNSname)) {
+        Log.warningln("Error setting up MDNS responder!");
+    } else {
+        Log.infoln("mDNS responder started. You should find this device at http://%s\n", mDNSname.c_str());
+    }
+    MDNS.addService("http", "tcp", 80);
 #endif
+}
+
+bool WifiWidget::loadCache(ConnectionCache &cache) {
+    Preferences preferences;
+    if (!preferences.begin("wifi", true)) {
+        return false;
+    }
+    // Only valid for the network it was saved for
+    bool valid = preferences.getString("ssid") == s_ssid &&
+                 preferences.getBytes("cache", &cache, sizeof(cache)) == sizeof(cache);
+    preferences.end();
+    return valid && cache.channel > 0;
+}
+
+void WifiWidget::saveCache() {
+    ConnectionCache cache{};
+    memcpy(cache.bssid, WiFi.BSSID(), sizeof(cache.bssid));
+    cache.channel = WiFi.channel();
+    cache.ip = WiFi.localIP();
+    cache.gateway = WiFi.gatewayIP();
+    cache.subnet = WiFi.subnetMask();
+    cache.dns = WiFi.dnsIP();
+    String ssid = WiFi.SSID();
+
+    ConnectionCache saved{};
+    s_ssid = ssid;
+    if (loadCache(saved) && memcmp(&saved, &cache, sizeof(cache)) == 0) {
+        // Unchanged, save the flash
+        return;
+    }
+    Preferences preferences;
+    preferences.begin("wifi", false);
+    preferences.putString("ssid", ssid);
+    preferences.putBytes("cache", &cache, sizeof(cache));
+    preferences.end();
+    Log.noticeln("WiFi: cached channel %d for the next boot", cache.channel);
+}
+
+void WifiWidget::applyIpConfig(const ConnectionCache *lease) {
+#ifdef WIFI_STATIC_IP
+    IPAddress ip, gateway, subnet, dns;
+    ip.fromString(WIFI_STATIC_IP);
+    gateway.fromString(WIFI_STATIC_GATEWAY);
+    subnet.fromString(WIFI_STATIC_SUBNET);
+    dns.fromString(WIFI_STATIC_DNS);
+    WiFi.config(ip, gateway, subnet, dns);
+#else
+    if (lease && lease->ip != 0) {
+        WiFi.config(IPAddress(lease->ip), IPAddress(lease->gateway), IPAddress(lease->subnet), IPAddress(lease->dns));
     } else {
-        m_connectionTimer += 500;
-        m_dotsString += " . ";
-        Serial.print(".");
-        if (m_dotsString.length() > 9) {
-            m_dotsString = "";
-        }
-        if (m_connectionTimer > m_connectionTimeout && !m_configPortalRunning) {
-            m_connectionFailed = true;
-            connectionTimedOut();
-        }
+        // DHCP
+        WiFi.config(IPAddress((uint32_t) 0), IPAddress((uint32_t) 0), IPAddress((uint32_t) 0));
     }
+#endif
 }
 
 void WifiWidget::draw(bool force) {
@@ -131,24 +251,33 @@ void WifiWidget::draw(bool force) {
     m_manager.selectScreen(statusScreenIndex);
     const int blankRectTop = ScreenCenterY + lineHeight / 2;
 
-    if (!m_isConnected && !m_connectionFailed) {
+    if (m_isConnected) {
+        if (!m_hasDisplayedSuccess) {
+            m_hasDisplayedSuccess = true;
+            m_manager.clearScreen();
+            m_manager.drawCentreString("IP Address", ScreenCenterX, ScreenCenterY - lineHeight, fontSize);
+            m_manager.drawCentreString(m_ipaddress, ScreenCenterX, ScreenCenterY + lineHeight, fontSize);
+            Log.infoln("Connected to WiFi");
+            // Not blocking, the first widget frame is drawn after WIFI_IP_DISPLAY_TIME (see main.cpp)
+        }
+    } else if (s_state == WifiState::Portal) {
+        if (!m_hasDisplayedPortal) {
+            // ...if connection fails (no saved credentials), WiFiManager runs an access point with a WiFi setup portal at 192.168.4.1
+            m_hasDisplayedPortal = true;
+            m_manager.clearScreen();
+            m_manager.setFontColor(TFT_WHITE);
+            m_manager.drawCentreString("Connect", ScreenCenterX, ScreenCenterY - lineHeight * 2, fontSize);
+            m_manager.drawCentreString("phone or PC", ScreenCenterX, ScreenCenterY - lineHeight, fontSize);
+            m_manager.drawCentreString("to WiFi network:", ScreenCenterX, ScreenCenterY, fontSize);
+            m_manager.setFontColor(TFT_SKYBLUE);
+            m_manager.drawCentreString(m_apssid, ScreenCenterX, ScreenCenterY + lineHeight, fontSize);
+            m_manager.setFontColor(TFT_GREENYELLOW);
+            m_manager.drawCentreString("192.168.4.1", ScreenCenterX, ScreenCenterY + lineHeight * 2, fontSize);
+            m_manager.setFontColor(TFT_WHITE);
+        }
+    } else {
         m_manager.fillRect(0, blankRectTop, ScreenWidth, ScreenHeight - blankRectTop, TFT_BLACK);
         m_manager.drawCentreString(m_dotsString, ScreenCenterX, ScreenCenterY + lineHeight, fontSize);
-    } else if (m_isConnected && !m_hasDisplayedSuccess) {
-        m_hasDisplayedSuccess = true;
-        m_manager.clearScreen();
-        // m_manager.drawCentreString("Success", ScreenCenterX, ScreenCenterY, fontSize);
-        // m_manager.selectScreen(statusScreenIndex + 1);
-        m_manager.clearScreen();
-        m_manager.drawCentreString("IP Address", ScreenCenterX, ScreenCenterY - lineHeight, fontSize);
-        m_manager.drawCentreString(m_ipaddress, ScreenCenterX, ScreenCenterY + lineHeight, fontSize);
-        Log.infoln("Connected to WiFi");
-        delay(messageDelay);
-    } else if (m_connectionFailed && !m_hasDisplayedError) {
-        m_hasDisplayedError = true;
-        m_manager.fillRect(0, blankRectTop, ScreenWidth, ScreenHeight - blankRectTop, TFT_BLACK);
-        m_manager.drawCentreString(m_connectionString, ScreenCenterX, ScreenCenterY + lineHeight, fontSize);
-        delay(messageDelay);
     }
 }
 
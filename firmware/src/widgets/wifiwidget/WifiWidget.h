@@ -4,6 +4,39 @@
 
     #include "Widget.h"
 
+    #ifndef WIFI_FAST_CONNECT_TIMEOUT
+        #define WIFI_FAST_CONNECT_TIMEOUT 3000 // Max ms for the directed connect to the cached AP before falling back to a full scan
+    #endif
+
+    #ifndef WIFI_CONNECT_TIMEOUT
+        #define WIFI_CONNECT_TIMEOUT 10000 // Max ms for the regular connect before the config portal is started
+    #endif
+
+    #ifndef WIFI_REUSE_DHCP_LEASE
+        #define WIFI_REUSE_DHCP_LEASE false // Skip DHCP on the fast connect by reusing the cached lease (only if the router keeps leases)
+    #endif
+
+    #ifndef WIFI_IP_DISPLAY_TIME
+        #define WIFI_IP_DISPLAY_TIME 3000 // ms the IP address is shown after connecting, the boot continues meanwhile
+    #endif
+
+    // Optional static IP, e.g. -D WIFI_STATIC_IP=\"192.168.1.50\" -D WIFI_STATIC_GATEWAY=\"192.168.1.1\"
+    #ifdef WIFI_STATIC_IP
+        #ifndef WIFI_STATIC_SUBNET
+            #define WIFI_STATIC_SUBNET "255.255.255.0"
+        #endif
+        #ifndef WIFI_STATIC_DNS
+            #define WIFI_STATIC_DNS WIFI_STATIC_GATEWAY
+        #endif
+    #endif
+
+enum class WifiState {
+    FastConnect, // Directed connect with the cached channel/BSSID
+    Connect, // Regular connect with scan
+    Portal, // Config portal is running
+    Connected
+};
+
 class WifiWidget : public Widget {
 public:
     WifiWidget(ScreenManager &manager, ConfigManager &config, WiFiManager &wifiManager);
@@ -16,24 +49,48 @@ public:
 
     bool isConnected() { return m_isConnected; }
 
+    // Start associating with the saved network right at boot, so it runs while the
+    // rest of the system is set up. Returns false if there is no saved network.
+    static bool beginConnect();
+
 private:
+    // Last successful connection, kept in NVS for the next boot. Compared with memcmp(),
+    // so there is no padding and instances are zero-initialized (ConnectionCache cache{})
+    struct ConnectionCache {
+        uint8_t bssid[6];
+        uint8_t channel;
+        uint8_t reserved;
+        uint32_t ip;
+        uint32_t gateway;
+        uint32_t subnet;
+        uint32_t dns;
+    };
+
+    static String getHostname();
+    static bool loadCache(ConnectionCache &cache);
+    static void saveCache();
+    static void applyIpConfig(const ConnectionCache *lease);
+    static void setState(WifiState state);
+
+    void startPortal();
+    void onConnected();
     void connectionTimedOut();
 
     WiFiManager &m_wifiManager;
 
     bool m_isConnected{false};
-    bool m_connectionFailed{false};
-    bool m_hardCodedWiFi{false};
-    bool m_hasDisplayedError{false};
     bool m_hasDisplayedSuccess{false};
-    bool m_configPortalRunning{false};
+    bool m_hasDisplayedPortal{false};
+
+    static WifiState s_state;
+    static unsigned long s_stateStart;
+    static String s_ssid;
+    static String s_password;
 
     String m_connectionString{""};
     String m_dotsString{""};
     String m_ipaddress{""};
     String m_apssid{""};
-    int m_connectionTimer{0};
-    const int m_connectionTimeout{10000};
 };
 
-#endif // WIFIWIDGET_H
\ No newline at end of file
+#endif // WIFIWIDGET_H